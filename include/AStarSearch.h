@@ -23,12 +23,86 @@
 
 #include <list>
 #include <vector>
+#include <algorithm>
 
 class UnitBase;
 class Map;
 
 class AStarSearch {
 public:
+    struct TileData {
+        Coord    parentCoord;
+        size_t   openListIndex;
+        FixPoint g;
+        FixPoint h;
+        FixPoint f;
+        bool     bInOpenList;
+        bool     bClosed;
+        Uint32   searchGeneration;  ///< the search this record belongs to; records of older searches are treated as unvisited
+    };
+
+    /**
+        The memory used by the A* search. Every map owns one workspace that is reused by all searches on that map.
+        Instead of clearing all node records before each search, a new search generation is started and a node record
+        is only considered valid if it was written during the current generation. Starting a search is therefore O(1)
+        (apart from the rare generation counter wrap-around) and the open list keeps its capacity between searches.
+    */
+    class Workspace {
+    public:
+        Workspace() = default;
+        ~Workspace() = default;
+
+        Workspace(const Workspace &) = delete;
+        Workspace(Workspace &&) = delete;
+        Workspace& operator=(const Workspace &) = delete;
+        Workspace& operator=(Workspace &&) = delete;
+
+        /**
+            Starts a new search on a map of the given size. All node records of previous searches become invalid.
+            \param  newSizeX    the width of the map
+            \param  newSizeY    the height of the map
+        */
+        void beginSearch(int newSizeX, int newSizeY) {
+            if((newSizeX != sizeX) || (newSizeY != sizeY)) {
+                sizeX = newSizeX;
+                sizeY = newSizeY;
+                tileData.assign(sizeX*sizeY, TileData());
+                searchGeneration = 0;
+            }
+
+            if(++searchGeneration == 0) {
+                // the counter wrapped around => stale records might look valid again
+                for(auto& data : tileData) {
+                    data.searchGeneration = 0;
+                }
+                searchGeneration = 1;
+            }
+
+            openList.clear();
+            depthCheckCount.assign(std::min(sizeX, sizeY), 0);
+        }
+
+        inline TileData& getTileData(const Coord& coord) {
+            TileData& data = tileData[coord.y * sizeX + coord.x];
+            if(data.searchGeneration != searchGeneration) {
+                data = TileData();
+                data.searchGeneration = searchGeneration;
+            }
+            return data;
+        }
+
+        inline Uint32 getSearchGeneration() const { return searchGeneration; }
+
+        std::vector<Coord>  openList;           ///< the open list (binary heap ordered by f)
+        std::vector<short>  depthCheckCount;    ///< number of closed nodes per distance to the destination
+
+    private:
+        int                     sizeX = 0;
+        int                     sizeY = 0;
+        Uint32                  searchGeneration = 0;
+        std::vector<TileData>   tileData;
+    };
+
     AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destination);
     ~AStarSearch();
 
@@ -37,10 +111,15 @@ public:
     AStarSearch& operator=(const AStarSearch &) = delete;
     AStarSearch& operator=(AStarSearch &&) = delete;
 
+    /**
+        Returns the found path. As the node records live in the workspace of the map this method must be called
+        before the next search on the same map is started.
+        \return the path from the start (exclusive) to the best reachable tile (inclusive)
+    */
     std::list<Coord> getFoundPath() {
         std::list<Coord> path;
 
-        if(bestCoord.isInvalid()) {
+        if(bestCoord.isInvalid() || (workspace.getSearchGeneration() != searchGeneration)) {
             return path;
         }
 
@@ -60,20 +139,11 @@ public:
     };
 
 private:
-    struct TileData {
-        Coord    parentCoord;
-        size_t   openListIndex;
-        FixPoint g;
-        FixPoint h;
-        FixPoint f;
-        bool     bInOpenList;
-        bool     bClosed;
-    };
-
-
-    inline TileData& getMapData(const Coord& coord) const { return mapData[coord.y * sizeX + coord.x]; };
+    inline TileData& getMapData(const Coord& coord) { return workspace.getTileData(coord); };
 
     void trickleUp(size_t openListIndex) {
+        std::vector<Coord>& openList = workspace.openList;
+
         Coord bottom = openList[openListIndex];
         FixPoint newf = getMapData(bottom).f;
 
@@ -95,36 +165,42 @@ private:
     };
 
     void putOnOpenListIfBetter(const Coord& coord, const Coord& parentCoord, FixPoint g, FixPoint h) {
+        std::vector<Coord>& openList = workspace.openList;
+
         FixPoint f = g + h;
 
-        if(getMapData(coord).bInOpenList == false) {
+        TileData& data = getMapData(coord);
+
+        if(data.bInOpenList == false) {
             // not yet in openlist => add at the end of the open list
-            getMapData(coord).g = g;
-            getMapData(coord).h = h;
-            getMapData(coord).f = f;
-            getMapData(coord).parentCoord = parentCoord;
-            getMapData(coord).bInOpenList = true;
+            data.g = g;
+            data.h = h;
+            data.f = f;
+            data.parentCoord = parentCoord;
+            data.bInOpenList = true;
             openList.push_back(coord);
-            getMapData(coord).openListIndex = openList.size() - 1;
+            data.openListIndex = openList.size() - 1;
 
             trickleUp(openList.size() - 1);
         } else {
             // already on openlist
-            if(f >= getMapData(coord).f) {
+            if(f >= data.f) {
                 // new item is worse => don't change anything
                 return;
             } else {
                 // new item is better => replace
-                getMapData(coord).g = g;
-                getMapData(coord).h = h;
-                getMapData(coord).f = f;
-                getMapData(coord).parentCoord = parentCoord;
-                trickleUp(getMapData(coord).openListIndex);
+                data.g = g;
+                data.h = h;
+                data.f = f;
+                data.parentCoord = parentCoord;
+                trickleUp(data.openListIndex);
             }
         }
     };
 
     Coord extractMin() {
+        std::vector<Coord>& openList = workspace.openList;
+
         Coord ret = openList[0];
         getMapData(ret).bInOpenList = false;
 
@@ -184,8 +260,8 @@ private:
     int sizeX;
     int sizeY;
     Coord bestCoord;
-    TileData* mapData;
-    std::vector<Coord> openList;
+    Workspace& workspace;
+    Uint32 searchGeneration;
 };
 
 #endif //ASTARSEARCH_H
@@ -25,6 +25,8 @@
 
 #include <Network/CommandList.h>
 
+#include <ReplayKeyframes.h>
+
 #include <vector>
 
 /**
@@ -74,9 +76,10 @@ public:
 
     /**
         Load commands from stream
-        \param  stream  the stream to read from
+        \param  stream      the stream to read from
+        \param  pKeyframes  the keyframes embedded between the commands of a replay file are added to this (may be nullptr to skip them)
     */
-    void load(InputStream& stream);
+    void load(InputStream& stream, ReplayKeyframes* pKeyframes = nullptr);
 
 
     Uint32 getNetworkCycleBuffer() const { return networkCycleBuffer; }
@@ -115,6 +118,12 @@ public:
     */
     void executeCommands(Uint32 CycleNumber) const;
 
+    /**
+        Get the number of game cycles commands are scheduled for. All commands take effect before this game cycle.
+        \return the game cycle after the last scheduled command
+    */
+    Uint32 getNumScheduledCycles() const { return timeslot.size(); }
+
 private:
     std::vector< std::vector<Command> > timeslot;   ///< a vector of vectors containing the scheduled commands. At index x is a list of all commands scheduled for game cycle x.
     std::unique_ptr<OutputStream> pStream;          ///< a stream all added commands will be written to. May be nullptr
@@ -0,0 +1,246 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CYCLEPROFILER_H
+#define CYCLEPROFILER_H
+
+#include <data.h>
+#include <misc/SDL2pp.h>
+
+#include <array>
+#include <cstdio>
+#include <string>
+
+/**
+    Measures where the time of a game cycle goes. The main loop wraps its steps into SectionTimers, the update of every
+    structure and unit is wrapped into an ItemTimer and the A* search reports the number of nodes it has expanded.
+    At the end of every game cycle endCycle() is called which updates the averages shown by draw() and writes one line
+    to the CSV file if one is open.
+
+    When the profiler is disabled the timers only check a flag and nothing is measured.
+*/
+class CycleProfiler {
+public:
+    /// The steps of the main loop that are timed separately
+    enum Section {
+        Section_Commands,   ///< executing the commands of the current cycle
+        Section_Houses,     ///< updating the houses including the AI players
+        Section_Triggers,   ///< checking the triggers
+        Section_Objects,    ///< updating all tiles, structures, units, bullets and explosions
+        Section_Draw,       ///< drawing the screen (all frames drawn since the last game cycle)
+        NUM_SECTIONS
+    };
+
+    /**
+        Adds the time between its construction and destruction to a counter of the profiler.
+    */
+    class ScopedTimer {
+    public:
+        ~ScopedTimer() {
+            if(pTime != nullptr) {
+                *pTime += SDL_GetPerformanceCounter() - startTime;
+            }
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer(ScopedTimer &&) = delete;
+        ScopedTimer& operator=(const ScopedTimer &) = delete;
+        ScopedTimer& operator=(ScopedTimer &&) = delete;
+
+    protected:
+        explicit ScopedTimer(Uint64* pTime) : pTime(pTime), startTime((pTime != nullptr) ? SDL_GetPerformanceCounter() : 0) {
+        }
+
+    private:
+        Uint64* pTime;      ///< the counter to add to or nullptr if the profiler is disabled
+        Uint64  startTime;  ///< the performance counter at construction
+    };
+
+    /// Times one section of the main loop
+    class SectionTimer : public ScopedTimer {
+    public:
+        SectionTimer(CycleProfiler& profiler, Section section)
+         : ScopedTimer(profiler.isEnabled() ? &profiler.currentCycle.sectionTime[section] : nullptr) {
+        }
+    };
+
+    /// Times the update of one structure or unit
+    class ItemTimer : public ScopedTimer {
+    public:
+        ItemTimer(CycleProfiler& profiler, int itemID)
+         : ScopedTimer(profiler.isEnabled() ? profiler.countItemUpdate(itemID) : nullptr) {
+        }
+    };
+
+    CycleProfiler();
+    ~CycleProfiler();
+
+    CycleProfiler(const CycleProfiler &) = delete;
+    CycleProfiler(CycleProfiler &&) = delete;
+    CycleProfiler& operator=(const CycleProfiler &) = delete;
+    CycleProfiler& operator=(CycleProfiler &&) = delete;
+
+    /**
+        Enables or disables the profiler. Enabling resets all averages and totals.
+        \param  bEnabled    true = measure, false = do nothing
+    */
+    void setEnabled(bool bEnabled);
+
+    /**
+        Is the profiler measuring?
+        \return true if enabled, false otherwise
+    */
+    bool isEnabled() const noexcept { return bEnabled; }
+
+    /**
+        Starts writing one line per game cycle to a CSV file. Writing only happens while the profiler is enabled.
+        \param  filename    the file to write to
+        \return true on success, false if the file cannot be opened
+    */
+    bool startCSV(const std::string& filename);
+
+    /**
+        Stops writing the CSV file and closes it.
+    */
+    void stopCSV();
+
+    /**
+        Is a CSV file written?
+        \return true if a CSV file is open, false otherwise
+    */
+    bool isWritingCSV() const noexcept { return pCSVFile != nullptr; }
+
+    /**
+        Adds the nodes expanded by an A* search to the current game cycle.
+        \param  numNodes    the number of expanded nodes
+    */
+    void addPathSearch(int numNodes) {
+        if(bEnabled) {
+            currentCycle.numPathSearches++;
+            currentCycle.numPathNodes += numNodes;
+        }
+    }
+
+    /**
+        Adds the sprites drawn by the sprite batch of one frame to the current game cycle.
+        \param  numSprites      the number of sprites
+        \param  numDrawCalls    the number of draw calls they were drawn with
+    */
+    void addSpriteBatch(int numSprites, int numDrawCalls) {
+        if(bEnabled) {
+            currentCycle.numSprites += numSprites;
+            currentCycle.numDrawCalls += numDrawCalls;
+        }
+    }
+
+    /**
+        Finishes the measurement of a game cycle.
+        \param  gameCycle   the game cycle that just ended
+    */
+    void endCycle(Uint32 gameCycle);
+
+    /**
+        Draws the averages of the last game cycles as an overlay.
+        \param  x   the x position of the right edge of the overlay
+        \param  y   the y position of the top edge of the overlay
+    */
+    void draw(int x, int y) const;
+
+    /**
+        Get the number of game cycles measured since the profiler was enabled.
+        \return the number of measured game cycles
+    */
+    Uint32 getNumCycles() const noexcept { return numCycles; }
+
+    /**
+        Get the time spent in a section since the profiler was enabled.
+        \param  section the section
+        \return the time in seconds
+    */
+    double getTotalSeconds(Section section) const;
+
+    /**
+        Get the time spent updating structures or units of one type since the profiler was enabled.
+        \param  itemID  the type of structure or unit
+        \return the time in seconds
+    */
+    double getTotalItemSeconds(int itemID) const;
+
+    /**
+        Get the number of updates of structures or units of one type since the profiler was enabled.
+        \param  itemID  the type of structure or unit
+        \return the number of updates
+    */
+    Uint64 getTotalItemUpdates(int itemID) const { return totalCycle.itemUpdates[itemID]; }
+
+    /**
+        Get the number of A* searches since the profiler was enabled.
+        \return the number of searches
+    */
+    Uint64 getTotalPathSearches() const noexcept { return totalCycle.numPathSearches; }
+
+    /**
+        Get the number of nodes expanded by all A* searches since the profiler was enabled.
+        \return the number of nodes
+    */
+    Uint64 getTotalPathNodes() const noexcept { return totalCycle.numPathNodes; }
+
+    /**
+        Get a name for a section for printing.
+        \param  section the section
+        \return the name of the section
+    */
+    static const char* getSectionName(Section section);
+
+private:
+    /// The counters of one game cycle (or the sum of several game cycles)
+    struct CycleData {
+        std::array<Uint64, NUM_SECTIONS>    sectionTime{};      ///< performance counter ticks per section
+        std::array<Uint64, Num_ItemID>      itemTime{};         ///< performance counter ticks per item type
+        std::array<Uint64, Num_ItemID>      itemUpdates{};      ///< number of updates per item type
+        Uint64                              numPathSearches = 0;    ///< number of A* searches
+        Uint64                              numPathNodes = 0;       ///< number of nodes expanded by all A* searches
+        Uint64                              numSprites = 0;         ///< number of sprites drawn by the sprite batch
+        Uint64                              numDrawCalls = 0;       ///< number of draw calls of the sprite batch
+    };
+
+    Uint64* countItemUpdate(int itemID) {
+        currentCycle.itemUpdates[itemID]++;
+        return &currentCycle.itemTime[itemID];
+    }
+
+    void writeCSVHeader();
+    void writeCSVLine(Uint32 gameCycle);
+
+    double ticksToMilliseconds(Uint64 ticks) const { return 1000.0 * ticks / performanceFrequency; }
+
+    bool    bEnabled = false;                       ///< is the profiler measuring?
+    double  performanceFrequency;                   ///< performance counter ticks per second
+    FILE*   pCSVFile = nullptr;                     ///< the CSV file or nullptr if none is written
+
+    CycleData   currentCycle;                       ///< the counters of the current game cycle
+    CycleData   totalCycle;                         ///< the sum of all game cycles since enabling
+    Uint32      numCycles = 0;                      ///< the number of game cycles since enabling
+
+    std::array<double, NUM_SECTIONS>    averageSectionMs{};     ///< the smoothed time per section in milliseconds
+    std::array<double, Num_ItemID>      averageItemMs{};        ///< the smoothed time per item type in milliseconds
+    double                              averagePathNodes = 0.0; ///< the smoothed number of expanded A* nodes
+    double                              averageSprites = 0.0;   ///< the smoothed number of sprites
+    double                              averageDrawCalls = 0.0; ///< the smoothed number of draw calls
+};
+
+#endif // CYCLEPROFILER_H
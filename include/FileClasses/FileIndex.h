@@ -0,0 +1,91 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef FILEINDEX_H
+#define FILEINDEX_H
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+#include <unordered_map>
+
+// forward declarations
+class Pakfile;
+
+/// An index of all files in the search paths and PAK-Files.
+/**
+    The index is built once (see addDirectory() and addPakfile()) and afterwards every lookup is a single hash map access
+    instead of probing every search path on disk and scanning every PAK-File. External files are looked up case
+    insensitive and files inside PAK-Files case sensitive, just as before. If the same file is added twice the first one
+    wins, so search paths must be added before PAK-Files and in the order of their priority.
+*/
+class FileIndex final {
+public:
+    /// An indexed file
+    struct Entry {
+        std::string     externalPath;       ///< the full path of an external file (empty for files inside a PAK-File)
+        Pakfile*        pPakfile = nullptr; ///< the PAK-File that contains this file (nullptr for external files)
+        unsigned int    fileIndex = 0;      ///< the index of this file inside pPakfile
+    };
+
+    FileIndex();
+    ~FileIndex();
+
+    FileIndex(const FileIndex &) = delete;
+    FileIndex(FileIndex &&) = delete;
+    FileIndex& operator=(const FileIndex &) = delete;
+    FileIndex& operator=(FileIndex &&) = delete;
+
+    /**
+        Adds all files in directory (but not in its sub-directories) to the index.
+        \param  directory   the directory to add
+    */
+    void addDirectory(const std::string& directory);
+
+    /**
+        Adds all files inside a PAK-File to the index. The PAK-File must stay alive as long as this index is used.
+        \param  pPakfile    the PAK-File to add (opened for reading)
+    */
+    void addPakfile(Pakfile* pPakfile);
+
+    /**
+        Looks up a file.
+        \param  filename    the name of the file (without any path)
+        \return the entry of the file or nullptr if there is no such file
+    */
+    const Entry* find(const std::string& filename) const;
+
+    /**
+        Opens an indexed file.
+        \param  entry   the entry to open (see find())
+        \return a rwop to read the content of the file (nullptr if an external file cannot be opened)
+    */
+    static sdl2::RWops_ptr open(const Entry& entry);
+
+    /**
+        Returns the number of indexed files.
+        \return the number of files
+    */
+    size_t size() const { return externalFiles.size() + pakFileEntries.size(); }
+
+private:
+    std::unordered_map<std::string, Entry>  externalFiles;      ///< the external files indexed by their lower case name
+    std::unordered_map<std::string, Entry>  pakFileEntries;     ///< the files inside PAK-Files indexed by their name
+};
+
+#endif // FILEINDEX_H
@@ -19,6 +19,8 @@
 #define FILEMANAGER_H
 
 #include "Pakfile.h"
+#include "FileIndex.h"
+#include "PakManifest.h"
 #include <misc/SDL2pp.h>
 
 #include <string>
@@ -28,6 +30,8 @@
 /// A class for loading all the PAK-Files.
 /**
     This class manages all the PAK-Files and provides access to the contained files through SDL_RWops.
+    All files in the search paths and PAK-Files are indexed once on construction; files added to the search paths
+    later on are not found.
 */
 class FileManager final {
 public:
@@ -52,17 +56,25 @@ public:
         Opens the file specified via filename. This method first tries to open the file in one of the
         search paths (see getSearchPath()). If no file exists with the given name the content of all
         pak files is considered. In case the file cannot be found an io_error is thrown.
-        \param  filename    the filename to look for
+        \param  filename    the filename to look for (without any path)
         \return a rwop to read the content of the specified file. Use SDL_RWclose() to close the file after usage.
 
     */
     sdl2::RWops_ptr openFile(const std::string& filename);
 
     bool exists(const std::string& filename) const;
-private:
-    std::string md5FromFilename(const std::string& filename) const;
 
+    /**
+        Describes the content of the loaded pak files (their paths, sizes and modification times). Used to detect if
+        data derived from the pak files and cached on disk is outdated.
+        \return a string that changes whenever a pak file changes
+    */
+    std::string getContentKey() const;
+private:
     std::vector<std::unique_ptr<Pakfile>> pakFiles;
+    std::vector<std::string> pakFilepaths;              ///< the paths of the files in pakFiles
+    FileIndex fileIndex;                                ///< all files in the search paths and pak files
+    std::unique_ptr<PakManifest> pakManifest;           ///< the cached checksums of the pak files (verified in the background)
 };
 
 #endif // FILEMANAGER_H
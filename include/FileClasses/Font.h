@@ -43,6 +43,24 @@ public:
         \return Number of pixels needed
     */
     virtual int getTextHeight() const = 0;
+
+    /// Returns the horizontal metrics of a single glyph
+    /**
+        This methods returns where a glyph is drawn relative to the pen position and how far the pen advances after it.
+        \param  character   The unicode character of the glyph
+        \param  minX        The leftmost pixel of the glyph relative to the pen position
+        \param  advance     The number of pixels the pen advances after this glyph
+    */
+    virtual void getGlyphMetrics(Uint16 character, int& minX, int& advance) const = 0;
+
+    /// Returns the kerning between two glyphs
+    /**
+        This methods returns the number of pixels the pen is moved additionally if character follows previous.
+        \param  previous    The unicode character of the first glyph
+        \param  character   The unicode character of the second glyph
+        \return Number of pixels (may be negative)
+    */
+    virtual int getKerning(Uint16 previous, Uint16 character) const = 0;
 };
 
 #endif // FONT_H
@@ -19,11 +19,18 @@
 #define FONTMANAGER_H
 
 #include <misc/SDL2pp.h>
+#include <misc/DrawingRectHelper.h>
+#include <misc/SpriteBatch.h>
 #include "Font.h"
+#include "GlyphAtlas.h"
 
+#include <list>
 #include <memory>
 #include <string>
 #include <map>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 
 /// A class for managing fonts.
 /**
@@ -42,7 +49,42 @@ public:
     sdl2::texture_ptr createTextureWithText(const std::string& text, Uint32 color, unsigned int fontSize);
     sdl2::surface_ptr createSurfaceWithMultilineText(const std::string& text, Uint32 color, unsigned int fontSize, bool bCentered = false);
     sdl2::texture_ptr createTextureWithMultilineText(const std::string& text, Uint32 color, unsigned int fontSize, bool bCentered = false);
+
+    /**
+        Draws a text that changes often (e.g. every frame). Texts made of printable ASCII characters are drawn from the
+        glyph atlas of this font size and color; all other texts are rendered once and kept in a cache of the most
+        recently drawn texts. Nothing is allocated or uploaded for a text that was drawn before.
+        \param  text        the text to draw
+        \param  color       the color of the text
+        \param  fontSize    the size of the font
+        \param  x           the x-coordinate
+        \param  y           the y-coordinate
+        \param  halign      the horizontal alignment of the text relative to (x,y) (default is HAlign::Left)
+        \param  valign      the vertical alignment of the text relative to (x,y) (default is VAlign::Top)
+        \return the rectangle the text was drawn to
+    */
+    SDL_Rect drawText(const std::string& text, Uint32 color, unsigned int fontSize, int x, int y, HAlign halign = HAlign::Left, VAlign valign = VAlign::Top);
+
 private:
+    /// The text, color and font size of a text in the cache of drawn texts
+    typedef std::tuple<std::string, Uint32, unsigned int> CachedTextKey;
+
+    struct CachedTextKeyHash {
+        size_t operator()(const CachedTextKey& key) const {
+            return std::hash<std::string>()(std::get<0>(key)) ^ (std::get<1>(key) * 31) ^ (std::get<2>(key) << 24);
+        }
+    };
+
+    /// A text in the cache of drawn texts
+    struct CachedText {
+        CachedTextKey       key;
+        sdl2::texture_ptr   pTexture;
+    };
+
+    GlyphAtlas& getGlyphAtlas(unsigned int fontSize, Uint32 color);
+
+    SDL_Texture* getCachedTextureWithText(const std::string& text, Uint32 color, unsigned int fontSize);
+
     inline Font* getFont(unsigned int fontSize) {
         auto iter = fonts.find(fontSize);
         if(iter != fonts.end()) {
@@ -57,6 +99,12 @@ private:
 
     std::map<unsigned int, std::unique_ptr<Font>> fonts;
 
+    std::map<std::pair<unsigned int, Uint32>, std::unique_ptr<GlyphAtlas>> glyphAtlases;    ///< the glyph atlas for every font size and color
+    SpriteBatch textBatch;                                                                  ///< the batch the glyphs of a text are collected in
+
+    std::list<CachedText> cachedTexts;                                                      ///< the recently drawn texts (most recently drawn first)
+    std::unordered_map<CachedTextKey, std::list<CachedText>::iterator, CachedTextKeyHash> cachedTextIndex;  ///< the position of every text in cachedTexts
+
 };
 
 #endif // FONTMANAGER_H
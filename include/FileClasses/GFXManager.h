@@ -21,13 +21,17 @@
 #include "Animation.h"
 #include "Shpfile.h"
 #include "Wsafile.h"
+#include "ObjPicCache.h"
 #include <DataTypes.h>
 
 #include <misc/SDL2pp.h>
+#include <misc/TextureAtlas.h>
 
 #include <string>
 #include <array>
 #include <memory>
+#include <queue>
+#include <vector>
 
 #define NUM_TERRAIN_TILES_X 11
 #define NUM_TERRAIN_TILES_Y 8
@@ -510,15 +514,24 @@ typedef enum {
 } Animation_enum;
 
 
+/**
+    Loads and provides all graphics.
+
+    The object pictures are decoded in the original resolution on construction. Their scaled versions (zoom level 1
+    and 2), the shadows and the versions for the other houses are generated on demand: A pool of worker threads works
+    through a priority queue in the background and getZoomedObjPic() generates a picture itself if the workers have not
+    done so yet. All generated pictures are kept in an ObjPicCache so that the next start does not need to scale or
+    remap anything.
+*/
 class GFXManager {
 public:
     GFXManager();
     ~GFXManager();
 
     GFXManager(const GFXManager &) = delete;
-    GFXManager(GFXManager &&) = default;
-    GFXManager& operator=(const GFXManager &) = default;
-    GFXManager& operator=(GFXManager &&) = default;
+    GFXManager(GFXManager &&) = delete;
+    GFXManager& operator=(const GFXManager &) = delete;
+    GFXManager& operator=(GFXManager &&) = delete;
 
     SDL_Texture*     getZoomedObjPic(unsigned int id, int house, unsigned int z);
     SDL_Texture*     getZoomedObjPic(unsigned int id, unsigned int z) { return getZoomedObjPic(id, HOUSE_HARKONNEN, z); };
@@ -536,7 +549,48 @@ public:
 
     Animation*       getAnimation(unsigned int id);
 
+    /**
+        Schedules the object pictures of a house to be generated in the background before all pictures that were not
+        requested for a specific house. Called when a game starts for all houses on the map.
+        \param  house   the house whose units and structures will be needed
+    */
+    void             prefetchObjPics(int house);
+
+    /**
+        Get the atlas with the object pictures of a zoom level. Every picture is added to the atlas of its zoom level
+        when its texture is created by getZoomedObjPic() or getObjPic().
+        \param  z   the zoom level
+        \return the atlas or nullptr if no picture of this zoom level was requested yet
+    */
+    const TextureAtlas* getObjPicAtlas(unsigned int z) const { return objPicAtlas[z].get(); }
+
 private:
+    /// A picture to be generated by the worker threads
+    struct ObjPicJob {
+        int             priority;   ///< jobs with higher priority are done first
+        Uint32          sequence;   ///< jobs with the same priority are done in the order they were added
+        unsigned int    id;         ///< the ObjPic id
+        int             house;      ///< the house
+
+        bool operator<(const ObjPicJob& other) const {
+            return (priority < other.priority) || ((priority == other.priority) && (sequence > other.sequence));
+        }
+    };
+
+    static const int PRIORITY_DEFAULT = 0;  ///< all pictures of house harkonnen (the source for all other houses)
+    static const int PRIORITY_HOUSE = 1;    ///< pictures of houses taking part in the current game
+    static const int PRIORITY_MAP = 2;      ///< pictures needed to draw the map
+
+    void                enqueueObjPic(unsigned int id, int house, int priority);
+    static int          objPicWorkerMain(void* data);
+
+    void                ensureObjPic(unsigned int id, int house);
+    void                generateObjPic(unsigned int id, int house);
+    template<typename Generator>
+    sdl2::surface_ptr   loadOrGenerateObjPic(unsigned int id, int house, unsigned int z, Generator&& generator);
+    static unsigned int getObjPicGroup(unsigned int id);
+    void                convertObjPic(unsigned int id, int house, unsigned int z);
+
     std::unique_ptr<Animation>  loadAnimationFromWsa(const std::string& filename) const;
     sdl2::surface_ptr           generateWindtrapAnimationFrames(SDL_Surface* windtrapPic) const;
     sdl2::surface_ptr           generateMapChoiceArrowFrames(SDL_Surface* arrowPic, int house=HOUSE_HARKONNEN) const;
@@ -552,6 +606,17 @@ private:
 
     // 8-bit surfaces kept in main memory for processing as needed, e.g. color remapping
     std::array<std::array<std::array<sdl2::surface_ptr, NUM_ZOOMLEVEL>, NUM_HOUSES>, NUM_OBJPICS> objPic;
+    std::array<std::array<bool, NUM_HOUSES>, NUM_OBJPICS> objPicReady{};    ///< are all zoom levels generated? (guarded by objPicGroupMutex)
+
+    // generation of the object pictures in the background
+    std::unique_ptr<ObjPicCache>                objPicCache;                ///< the cache of generated pictures
+    std::array<SDL_mutex*, NUM_OBJPICS>         objPicGroupMutex{};         ///< locked while pictures of this group are read for or written by the generation (see getObjPicGroup())
+    std::priority_queue<ObjPicJob>              objPicQueue;                ///< the pictures to generate in the background
+    Uint32                                      objPicQueueSequence = 0;    ///< the sequence number of the next job
+    bool                                        bStopObjPicWorkers = false; ///< set to stop the worker threads
+    SDL_mutex*                                  objPicQueueMutex = nullptr; ///< guards objPicQueue, objPicQueueSequence and bStopObjPicWorkers
+    SDL_cond*                                   objPicQueueCond = nullptr;  ///< signaled when a job is added or the workers shall stop
+    std::vector<SDL_Thread*>                    objPicWorkers;              ///< the worker threads
     std::array<std::array<sdl2::surface_ptr, NUM_HOUSES>, NUM_UIGRAPHICS> uiGraphic;
     std::array<std::array<sdl2::surface_ptr, NUM_HOUSES>, NUM_MAPCHOICEPIECES> mapChoicePieces;
     std::array<std::unique_ptr<Animation>, NUM_ANIMATION> animation{};
@@ -561,6 +626,7 @@ private:
 
     // Textures
     std::array<std::array<std::array<sdl2::texture_ptr, NUM_ZOOMLEVEL>, NUM_HOUSES>, NUM_OBJPICS> objPicTex;
+    std::array<std::unique_ptr<TextureAtlas>, NUM_ZOOMLEVEL> objPicAtlas;   ///< copies of objPicTex packed per zoom level (see SpriteBatch)
     std::array<sdl2::texture_ptr, NUM_SMALLDETAILPICS> smallDetailPicTex;
     std::array<sdl2::texture_ptr, NUM_TINYPICTURE> tinyPictureTex;
     std::array<std::array<sdl2::texture_ptr, NUM_HOUSES>, NUM_UIGRAPHICS> uiGraphicTex;
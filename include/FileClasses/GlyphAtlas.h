@@ -0,0 +1,132 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <misc/SDL2pp.h>
+#include <misc/TextureAtlas.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+// forward declarations
+class Font;
+class SpriteBatch;
+
+/// A texture with all printable ASCII glyphs of a font in one color.
+/**
+    Texts made of these glyphs are drawn as one quad per glyph from the atlas texture (see SpriteBatch::copyRegion())
+    instead of rendering and uploading a new texture for every text. Every glyph is rendered exactly like a text
+    consisting of only this character and the glyphs are placed by their advance and the kerning of the font, so a
+    text looks the same as if it was rendered by Font::drawTextOnSurface().
+*/
+class GlyphAtlas {
+public:
+    static constexpr char FIRST_GLYPH = ' ';    ///< the first character in the atlas
+    static constexpr char LAST_GLYPH = '~';     ///< the last character in the atlas
+
+    /**
+        Renders all glyphs of font in color into one texture.
+        \param  font    the font
+        \param  color   the color of the glyphs
+    */
+    GlyphAtlas(Font& font, Uint32 color);
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas &) = delete;
+    GlyphAtlas(GlyphAtlas &&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas &) = delete;
+    GlyphAtlas& operator=(GlyphAtlas &&) = delete;
+
+    /**
+        Can text be drawn with this atlas?
+        \param  text    the text (UTF-8)
+        \return true if all characters of text are in the atlas
+    */
+    static bool hasAllGlyphs(const std::string& text) noexcept;
+
+    /**
+        Returns the number of pixels text needs in x-direction. All characters of text must be in the atlas.
+        \param  text    the text
+        \return the width in pixels
+    */
+    int getTextWidth(const std::string& text) const;
+
+    /**
+        Returns the number of pixels a text needs in y-direction.
+        \return the height in pixels
+    */
+    int getTextHeight() const noexcept { return textHeight; }
+
+    /**
+        Draws text with its top left corner at (x,y). All characters of text must be in the atlas.
+        \param  spriteBatch the batch the glyphs are added to
+        \param  text        the text
+        \param  x           the x-coordinate
+        \param  y           the y-coordinate
+    */
+    void draw(SpriteBatch& spriteBatch, const std::string& text, int x, int y) const;
+
+private:
+    static constexpr int NUM_GLYPHS = LAST_GLYPH - FIRST_GLYPH + 1;
+
+    /// A glyph in the atlas
+    struct Glyph {
+        TextureAtlas::Region    region;     ///< the rendered glyph inside the atlas texture
+        int                     offsetX;    ///< the position of the rendered glyph relative to the pen position
+        int                     advance;    ///< the number of pixels the pen advances after this glyph
+    };
+
+    static inline int getGlyphIndex(char character) noexcept { return character - FIRST_GLYPH; }
+
+    inline int getKerning(int previousIndex, int index) const noexcept { return kerning[previousIndex * NUM_GLYPHS + index]; }
+
+    /**
+        Calls drawGlyph(glyph, x) for every glyph of text, where x is the position of the rendered glyph.
+    */
+    template<typename F>
+    void layout(const std::string& text, F&& drawGlyph) const {
+        int penX = 0;
+        int previousIndex = -1;
+        for(char character : text) {
+            const int index = getGlyphIndex(character);
+            const Glyph& glyph = glyphs[index];
+
+            if(previousIndex == -1) {
+                // the text is moved to the right if the first glyph reaches to the left of the pen
+                penX = -glyph.offsetX;
+            } else {
+                penX += getKerning(previousIndex, index);
+            }
+
+            drawGlyph(glyph, penX + glyph.offsetX);
+
+            penX += glyph.advance;
+            previousIndex = index;
+        }
+    }
+
+    sdl2::texture_ptr               pTexture;       ///< the texture with all glyphs
+    std::array<Glyph, NUM_GLYPHS>   glyphs;         ///< the glyphs from FIRST_GLYPH to LAST_GLYPH
+    std::vector<Sint16>             kerning;        ///< the kerning for every pair of glyphs
+    int                             textHeight;     ///< the height of a text in pixels
+};
+
+#endif // GLYPHATLAS_H
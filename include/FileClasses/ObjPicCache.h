@@ -0,0 +1,107 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OBJPICCACHE_H
+#define OBJPICCACHE_H
+
+#include <misc/MappedFile.h>
+#include <misc/SDL2pp.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// A persistent cache of generated object pictures.
+/**
+    GFXManager stores the scaled, shadowed and house remapped versions of the object pictures (8-bit surfaces) in this
+    cache. The cache file is read via a memory mapping and a picture is only copied out of it when it is requested.
+    The whole file is discarded if its version or its source key (the scaler and the content of the PAK-Files) differ.
+    New pictures are kept in memory until save() is called.
+
+    All methods are thread-safe.
+*/
+class ObjPicCache final {
+public:
+    /**
+        Constructor. Opens the cache file if it exists and matches sourceKey.
+        \param  filepath    the path of the cache file
+        \param  sourceKey   describes everything the cached pictures depend on
+    */
+    ObjPicCache(const std::string& filepath, const std::string& sourceKey);
+    ~ObjPicCache();
+
+    ObjPicCache(const ObjPicCache &) = delete;
+    ObjPicCache(ObjPicCache &&) = delete;
+    ObjPicCache& operator=(const ObjPicCache &) = delete;
+    ObjPicCache& operator=(ObjPicCache &&) = delete;
+
+    /**
+        Loads a picture from the cache.
+        \param  id      the ObjPic id
+        \param  house   the house
+        \param  zoom    the zoom level
+        \return a new 8-bit surface or nullptr if this picture is not cached
+    */
+    sdl2::surface_ptr load(unsigned int id, int house, unsigned int zoom) const;
+
+    /**
+        Adds a picture to the cache. Only 8-bit surfaces with palette can be cached; other surfaces are ignored.
+        \param  id          the ObjPic id
+        \param  house       the house
+        \param  zoom        the zoom level
+        \param  pSurface    the picture
+    */
+    void store(unsigned int id, int house, unsigned int zoom, SDL_Surface* pSurface);
+
+    /**
+        Writes the cache file if any picture was added. The cache is empty afterwards.
+    */
+    void save();
+
+private:
+    static const Uint32 CACHE_VERSION = 1;
+    static const Uint32 NO_COLORKEY = 0xFFFFFFFF;
+
+    /// A cached picture. The palette and pixel data either point into the cache file or into newData
+    struct Entry {
+        Uint32          w;
+        Uint32          h;
+        Uint32          colorKey;
+        Uint32          blendMode;
+        Uint32          numColors;
+        const Uint8*    pPalette;   ///< numColors * 4 bytes (r,g,b,a)
+        const Uint8*    pPixels;    ///< w * h bytes
+    };
+
+    static inline Uint32 getKey(unsigned int id, int house, unsigned int zoom) { return (id << 16) | (house << 8) | zoom; }
+
+    bool readIndex();
+
+    std::string                         filepath;       ///< the path of the cache file
+    std::string                         sourceKey;      ///< describes everything the cached pictures depend on
+    std::unique_ptr<MappedFile>         pMappedFile;    ///< the mapped cache file (nullptr if not available)
+    std::map<Uint32, Entry>             entries;        ///< all cached pictures
+    std::list<std::vector<Uint8>>       newData;        ///< the palette and pixel data of pictures added by store()
+    bool                                bChanged;       ///< was any picture added since loading?
+
+    SDL_mutex*                          mutex;          ///< guards all of the above
+};
+
+#endif // OBJPICCACHE_H
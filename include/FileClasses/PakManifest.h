@@ -0,0 +1,89 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PAKMANIFEST_H
+#define PAKMANIFEST_H
+
+#include <SDL2/SDL.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/// A cache of the MD5 checksums of the PAK-Files.
+/**
+    The checksums are stored in a manifest file together with the size and the time of the last modification of each
+    PAK-File. A PAK-File is only hashed again if its size or modification time differ from the manifest (or if it is not
+    listed yet). The verification runs in a separate thread so that loading the PAK-Files is never blocked by it.
+*/
+class PakManifest final {
+public:
+    /**
+        Constructor.
+        \param  manifestFilepath    the path of the manifest file (it is created if it does not exist)
+    */
+    explicit PakManifest(const std::string& manifestFilepath);
+
+    PakManifest(const PakManifest &) = delete;
+    PakManifest(PakManifest &&) = delete;
+    PakManifest& operator=(const PakManifest &) = delete;
+    PakManifest& operator=(PakManifest &&) = delete;
+
+    /**
+        Destructor. Waits for a running verification (which is stopped after the current file).
+    */
+    ~PakManifest();
+
+    /**
+        Starts logging the checksums of all specified files in a separate thread. Files that changed are hashed again
+        and the manifest file is updated afterwards. This method must be called at most once.
+        \param  filepaths   the paths of the PAK-Files
+    */
+    void verifyInBackground(const std::vector<std::string>& filepaths);
+
+    /**
+        Waits until the verification started by verifyInBackground() is finished.
+    */
+    void waitForVerification();
+
+private:
+    /// A file listed in the manifest
+    struct Entry {
+        uint64_t    size = 0;           ///< the size of the file in bytes
+        uint64_t    modifydate = 0;     ///< the time of the last modification
+        std::string md5;                ///< the MD5 checksum as hex string
+    };
+
+    static int verificationThreadMain(void* data);
+
+    void verify();
+
+    void load();
+    void save() const;
+
+    static std::string md5FromFilename(const std::string& filepath);
+
+    std::string                     manifestFilepath;       ///< the path of the manifest file
+    std::vector<std::string>        filepaths;              ///< the files to verify
+    std::map<std::string, Entry>    entries;                ///< the files listed in the manifest (only used by the verification thread)
+
+    SDL_Thread*                     verificationThread;     ///< the thread running verify() (nullptr if not started or finished)
+    SDL_atomic_t                    bQuit;                  ///< set to 1 if the verification shall be stopped
+};
+
+#endif // PAKMANIFEST_H
@@ -19,18 +19,19 @@
 #define PAKFILE_H
 
 #include <misc/SDL2pp.h>
+#include <misc/MappedFile.h>
 
 #include <stdio.h>
 #include <string>
 #include <vector>
+#include <memory>
 #include <inttypes.h>
 
-#define PAKFILE_RWOP_TYPE   0x9A5F17EC
-
 /// A class for reading PAK-Files.
 /**
     This class can be used to read PAK-Files. PAK-Files are archive files used by Dune2.
-    The files inside the PAK-File can an be read through SDL_RWops.
+    A PAK-File opened for reading is mapped into memory and the files inside can be read through SDL_RWops
+    that directly read from the mapped memory.
 */
 class Pakfile
 {
@@ -43,13 +44,6 @@ private:
         std::string filename;
     };
 
-    /// Internal structure used by opened SDL_RWop
-    struct RWopData {
-        Pakfile* curPakfile;
-        unsigned int fileIndex;
-        size_t fileOffset;
-    };
-
 public:
     Pakfile(const std::string& pakfilename, bool write = false);
     ~Pakfile();
@@ -65,21 +59,18 @@ public:
 
     sdl2::RWops_ptr openFile(const std::string& filename);
 
+    sdl2::RWops_ptr openFile(unsigned int index);
+
     bool exists(const std::string& filename) const;
 
     void addFile(SDL_RWops* rwop, const std::string& filename);
 
 private:
-    static size_t ReadFile(SDL_RWops* pRWop, void *ptr, size_t size, size_t n);
-    static size_t WriteFile(SDL_RWops *pRWop, const void *ptr, size_t size, size_t n);
-    static Sint64 SizeFile(SDL_RWops *pRWop);
-    static Sint64 SeekFile(SDL_RWops *pRWop, Sint64 offset, int whence);
-    static int CloseFile(SDL_RWops *pRWop);
-
     void readIndex();
 
     bool write;
-    SDL_RWops * fPakFile;
+    SDL_RWops * fPakFile;                       ///< the file written to (only used for writing)
+    std::unique_ptr<MappedFile> pMappedFile;    ///< the mapped content of the file (only used for reading)
     std::string filename;
 
     char* writeOutData;
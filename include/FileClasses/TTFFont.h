@@ -48,6 +48,10 @@ public:
     */
     inline int getTextHeight() const override { return characterHeight; };
 
+    void getGlyphMetrics(Uint16 character, int& minX, int& advance) const override;
+
+    int getKerning(Uint16 previous, Uint16 character) const override;
+
 private:
     font_ptr pTTFFont;
     int characterHeight;
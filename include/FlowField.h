@@ -0,0 +1,94 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <DataTypes.h>
+#include <TileAttributes.h>
+#include <fixmath/FixPoint.h>
+
+#include <vector>
+
+// forward declarations
+class Map;
+
+/**
+    A flow field guides all units of a group move order to the same destination.
+
+    The integration field holds the cost of the cheapest path from every tile to the destination (computed once by a
+    Dijkstra search from the destination) and the direction field holds for every tile the direction of the first step of
+    this path. A unit just follows the direction field instead of running its own A* search. Only static obstacles
+    (mountains and structures) are considered; other units are avoided by the normal path search when the next tile is blocked.
+
+    The costs of the tiles are the same as for AStarSearch, but unlike AStarSearch the field has no cost for turning: that
+    cost depends on the turn speed of the unit type and the direction the unit arrives from, which a field per tile cannot
+    hold. Thus a unit of a group may take a different (more winding) path than its own A* search would find, but all
+    units of the same movement class can share one flow field. The field only depends on the terrain, so it is computed
+    again whenever the terrain version of the map changes (see TileAttributes::getTerrainVersion()). Thus a field
+    recomputed after loading a savegame is identical to the one used before saving.
+*/
+class FlowField {
+public:
+    static const int MIN_GROUP_SIZE = 3;    ///< smaller groups search their paths with AStarSearch
+
+    /**
+        Computes the flow field for all units of the given movement class moving to destination.
+        \param  pMap            the map
+        \param  destination     the destination of the move
+        \param  movementClass   the movement class of the units (one of the ground movement classes)
+    */
+    FlowField(Map* pMap, const Coord& destination, TileAttributes::MovementClass movementClass);
+    ~FlowField();
+
+    FlowField(const FlowField &) = delete;
+    FlowField(FlowField &&) = delete;
+    FlowField& operator=(const FlowField &) = delete;
+    FlowField& operator=(FlowField &&) = delete;
+
+    inline const Coord& getDestination() const noexcept { return destination; }
+    inline TileAttributes::MovementClass getMovementClass() const noexcept { return movementClass; }
+    inline Uint32 getTerrainVersion() const noexcept { return terrainVersion; }
+
+    /**
+        Returns the tile to move to next when standing on location.
+        \param  location    the current location
+        \return the next tile or Coord::Invalid() if location is the destination or the destination cannot be reached from it
+    */
+    Coord getNextSpot(const Coord& location) const;
+
+    /**
+        Returns the cost of the cheapest path from location to the destination.
+        \param  location    the current location
+        \return the cost or FixPt_MAX if the destination cannot be reached from location
+    */
+    FixPoint getCost(const Coord& location) const;
+
+private:
+    inline int getIndex(int x, int y) const { return y * sizeX + x; }
+
+    Coord           destination;                ///< the destination of the group move
+    TileAttributes::MovementClass movementClass;    ///< the movement class this field was computed for
+    Uint32          terrainVersion;             ///< the terrain version of the map this field was computed for
+    int             sizeX;                      ///< the width of the map
+    int             sizeY;                      ///< the height of the map
+
+    std::vector<FixPoint>   integrationField;   ///< cost to reach the destination from each tile
+    std::vector<Sint8>      directionField;     ///< angle of the first step from each tile (INVALID if none)
+};
+
+#endif // FLOWFIELD_H
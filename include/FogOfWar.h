@@ -0,0 +1,130 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FOGOFWAR_H
+#define FOGOFWAR_H
+
+#include <DataTypes.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+// forward declarations
+class Map;
+
+/**
+    Keeps track of the tiles currently seen by the ground units and structures of every house.
+
+    Every observer (a ground unit or structure on the map) is registered with its location and view range and every tile
+    counts for each house how many observers currently see it. When an observer moves to a neighbour tile only the
+    tiles entering and leaving its view are touched (the differences are precomputed per view range and direction).
+
+    A tile that is seen by an observer is never fogged. Only when the last observer of a house stops seeing a tile
+    the time is recorded in the tile (see Tile::setExplored()); the tile gets fogged FOGTIME cycles later.
+    Nothing of this is saved, the observers are registered again after loading (see rebuild()).
+*/
+class FogOfWar {
+public:
+    explicit FogOfWar(Map* pMap);
+    ~FogOfWar();
+
+    FogOfWar(const FogOfWar &) = delete;
+    FogOfWar(FogOfWar &&) = delete;
+    FogOfWar& operator=(const FogOfWar &) = delete;
+    FogOfWar& operator=(FogOfWar &&) = delete;
+
+    /**
+        Removes all observers and adjusts to the current size of the map.
+    */
+    void reset();
+
+    /**
+        Registers all ground units and structures that are on the map as observers. Used after loading a savegame.
+    */
+    void rebuild();
+
+    /**
+        Registers an observer or moves it to a new location. The tiles in view are explored for the house.
+        \param  objectID    the id of the ground unit or structure
+        \param  houseID     the house the observer belongs to
+        \param  location    the tile the observer is on
+        \param  viewRange   the view range of the observer
+    */
+    void updateObserver(Uint32 objectID, int houseID, const Coord& location, int viewRange);
+
+    /**
+        Changes the house of an observer (e.g. when a unit gets deviated). Nothing happens if the object is not registered.
+        \param  objectID    the id of the ground unit or structure
+        \param  houseID     the new house of the observer
+        \param  viewRange   the view range of the observer for this house
+    */
+    void changeObserverHouse(Uint32 objectID, int houseID, int viewRange);
+
+    /**
+        Unregisters an observer (e.g. when it is destroyed or leaves the map). Nothing happens if the object is not registered.
+        \param  objectID    the id of the ground unit or structure
+    */
+    void removeObserver(Uint32 objectID);
+
+    /**
+        Is the tile at location currently seen by any observer of this house?
+        \param  houseID     the house to check
+        \param  location    the tile to check
+        \return true if seen, false otherwise
+    */
+    inline bool isObservedByHouse(int houseID, const Coord& location) const {
+        return viewCount[houseID][location.y * sizeX + location.x] > 0;
+    }
+
+private:
+    struct Observer {
+        Coord   location = Coord::Invalid();    ///< the location this observer is registered at (invalid if not registered)
+        int     houseID = 0;                    ///< the house this observer belongs to
+        int     viewRange = 0;                  ///< the view range the observer is registered with
+    };
+
+    /**
+        The tiles seen from a location with a certain view range and the tiles that change when moving one tile.
+        All coordinates are relative to the (new) location of the observer.
+    */
+    struct Stamp {
+        std::vector<Coord>                  tiles;              ///< all tiles in view
+        std::array<std::vector<Coord>, 9>   enteringTiles;      ///< tiles entering the view for each step (see getStepIndex())
+        std::array<std::vector<Coord>, 9>   leavingTiles;       ///< tiles leaving the view for each step (see getStepIndex())
+    };
+
+    static inline int getStepIndex(int dx, int dy) { return (dy + 1) * 3 + (dx + 1); }
+
+    const Stamp& getStamp(int viewRange);
+
+    void addObserver(const Observer& observer);
+    void removeObserver(const Observer& observer);
+
+    void addView(int houseID, const Coord& location);
+    void removeView(int houseID, const Coord& location);
+
+    Map*    pMap;       ///< the map
+    int     sizeX;      ///< the width of the map
+    int     sizeY;      ///< the height of the map
+
+    std::vector<Observer>                       observers;  ///< all observers indexed by object id
+    std::array<std::vector<Uint16>, NUM_HOUSES> viewCount;  ///< the number of observers of each house that see a tile
+    std::vector<std::unique_ptr<Stamp>>         stamps;     ///< the stamps indexed by view range (created on demand)
+};
+
+#endif // FOGOFWAR_H
@@ -22,9 +22,15 @@
 #include <misc/RobustList.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
+#include <misc/SpriteBatch.h>
 #include <ObjectData.h>
 #include <ObjectManager.h>
 #include <CommandManager.h>
+#include <ReplayKeyframes.h>
+#include <SaveGameWriter.h>
+#include <StateHash.h>
+#include <CycleProfiler.h>
+#include <TerrainChunkCache.h>
 #include <GameInterface.h>
 #include <INIMap/INIMapLoader.h>
 #include <GameInitSettings.h>
@@ -37,7 +43,9 @@
 
 #include <stdarg.h>
 #include <string>
+#include <list>
 #include <map>
+#include <tuple>
 #include <utility>
 
 // forward declarations
@@ -52,6 +60,8 @@ class Explosion;
 
 #define END_WAIT_TIME               (6*1000)
 
+#define STATEHASH_INTERVAL          MILLI2CYCLES(5*1000)    ///< multiplayer peers compare their state hashes this often
+
 #define GAME_NOTHING            -1
 #define GAME_RETURN_TO_MENU     0
 #define GAME_NEXTMISSION        1
@@ -87,12 +97,34 @@ public:
     /**
         Initializes a replay from the specified filename
         \param  filename    the file containing the replay
+        \param  seekCycle   the game cycle to start the replay at; the game is loaded from the latest keyframe before
+                            this cycle and the remaining cycles are skipped (default is 0)
     */
-    void initReplay(const std::string& filename);
+    void initReplay(const std::string& filename, Uint32 seekCycle = 0);
+
+    /**
+        Seeks in a replay. If there is a keyframe closer to seekCycle than the current cycle the replay must be
+        restarted from this keyframe; then the main loop is quit and isReplaySeekRequested() returns true.
+        \param  seekCycle   the game cycle to seek to
+    */
+    void seekReplay(Uint32 seekCycle);
+
+    /**
+        Has the replay to be restarted with initReplay() because seekReplay() was called?
+        \return true if the replay has to be restarted at getReplaySeekCycle()
+    */
+    bool isReplaySeekRequested() const noexcept { return bReplaySeekRequested; }
+
+    /**
+        Returns the game cycle the replay shall be restarted at (see isReplaySeekRequested()).
+        \return the game cycle to seek to
+    */
+    Uint32 getReplaySeekCycle() const noexcept { return replaySeekCycle; }
 
 
 
     friend class INIMapLoader; // loading INI Maps is done with a INIMapLoader helper object
+    friend class HeadlessRunner; // simulating a game without rendering is done with a HeadlessRunner helper object
 
 
     /**
@@ -128,12 +160,44 @@ public:
     */
     CommandManager& getCommandManager() { return cmdManager; };
 
+    /**
+        Get the state hash of this game. The simulation updates it whenever a hashed value changes.
+        \return the state hash
+    */
+    StateHash& getStateHash() { return stateHash; };
+
+    /**
+        Calculates the hash of the current game state. This is the incrementally updated state hash plus the health and
+        positions of all objects and the random seed. Objects are hashed here under their object id, which is not yet
+        known when they are created or loaded.
+        \return the hash of the current game state
+    */
+    Uint64 calculateStateHash() const;
+
+    /**
+        Get the keyframes recorded for or loaded from the replay file
+        \return the replay keyframes
+    */
+    const ReplayKeyframes& getReplayKeyframes() const { return replayKeyframes; };
+
     /**
         Get the trigger manager of this game
         \return the trigger manager
     */
     TriggerManager& getTriggerManager() { return triggerManager; };
 
+    /**
+        Get the profiler measuring where the time of a game cycle goes
+        \return the cycle profiler
+    */
+    CycleProfiler& getCycleProfiler() { return cycleProfiler; };
+
+    /**
+        Get the sprite batch the map and everything on it is drawn with. Only valid while drawing the screen.
+        \return the sprite batch
+    */
+    SpriteBatch& getSpriteBatch() { return spriteBatch; };
+
     /**
         Get the explosion list.
         \return the explosion list
@@ -184,11 +248,25 @@ public:
     bool loadSaveGame(InputStream& stream);
 
     /**
-        This method saves the current running game.
+        This method saves the current running game. The game is only serialized into memory here, the file is written
+        in a separate thread (see SaveGameWriter). A failure is reported in the news ticker.
         \param filename the name of the file to save to
-        \return true on success, false on failure
     */
-    bool saveGame(const std::string& filename);
+    void saveGame(const std::string& filename);
+
+    /**
+        Waits until the savegame started by saveGame(const std::string&) is written to disk. This must be called before
+        a savegame is read while this game still exists; deleting the game waits as well.
+    */
+    void waitForSaveGame() { saveGameWriter.waitForCompletion(); }
+
+    /**
+        This method saves the current running game.
+        \param stream          the stream to save to
+        \param bWithCommands   false to leave out the commands; only for replay keyframes, which are loaded with the
+                                commands of the replay file (see loadSaveGame())
+    */
+    void saveGame(OutputStream& stream, bool bWithCommands = true);
 
     /**
         This method starts the game. Will return when the game is finished or aborted.
@@ -309,6 +387,14 @@ public:
     */
     void onPeerDisconnected(const std::string& name, bool bHost, int cause);
 
+    /**
+        Called when the state hash of a peer is received. It is compared to our own hash of the same game cycle.
+        \param  name        the name of the peer
+        \param  gameCycle   the game cycle the hash was calculated after
+        \param  hash        the state hash of the peer
+    */
+    void onReceiveStateHash(const std::string& name, Uint32 gameCycle, Uint64 hash);
+
     /**
         Adds a new message to the news ticker.
         \param  text    the text to add
@@ -421,6 +507,48 @@ public:
 
 private:
 
+    /**
+        Lets the GFXManager generate the pictures of all houses on the map in the background (e.g. during the briefing).
+    */
+    void prefetchHouseGraphics() const;
+
+    /**
+        Skips numCycles game cycles. In a replay this skips backwards if shift is pressed.
+        \param numCycles the number of cycles to skip
+    */
+    void skipGameTime(Uint32 numCycles);
+
+    /**
+        Sends the state hash of the current game cycle to all peers and compares it to the hashes already received.
+    */
+    void exchangeStateHash();
+
+    /**
+        Compares a state hash of a peer to our own one of the same game cycle.
+        \param  name        the name of the peer
+        \param  gameCycle   the game cycle the hash was calculated after
+        \param  hash        the state hash of the peer
+    */
+    void compareStateHash(const std::string& name, Uint32 gameCycle, Uint64 hash);
+
+    /**
+        Writes the state of all houses, objects and tiles as text to a file. The files of two peers can be compared line
+        by line to find the first diverging value.
+        \param  filename    the file to write to
+    */
+    void dumpState(const std::string& filename) const;
+
+    /**
+        Saves the game as a keyframe of the replay (see ReplayKeyframes). The keyframe is compressed in the background
+        and appended to the replay file by writeFinishedReplayKeyframe().
+    */
+    void recordReplayKeyframe();
+
+    /**
+        Writes the keyframe that was compressed in the background since the last call to the replay file.
+    */
+    void writeFinishedReplayKeyframe();
+
     /**
         Checks whether the cursor is on the radar view
         \param  mouseX  x-coordinate of cursor
@@ -553,6 +681,14 @@ private:
 
     Uint32      skipToGameCycle = 0;            ///< skip to this game cycle
 
+    std::map<Uint32, Uint64>    localStateHashes;                           ///< our last state hashes by game cycle
+    std::list<std::tuple<std::string, Uint32, Uint64>> pendingStateHashes;  ///< state hashes received from peers that are ahead of us
+    Uint32      desyncDumpCycle = 0;            ///< the game cycle to dump the game state at after a desync was detected (0 = none)
+    bool        bDesyncDetected = false;        ///< have the state hashes of a peer and us differed
+
+    bool        bReplaySeekRequested = false;   ///< has the replay to be restarted at replaySeekCycle (see seekReplay())
+    Uint32      replaySeekCycle = 0;            ///< the game cycle to restart the replay at
+
     bool        takePeriodicalScreenshots = false;      ///< take a screenshot every 10 seconds
 
     SDL_Rect    powerIndicatorPos = {14, 146, 4, 0};    ///< position of the power indicator in the right game bar
@@ -567,12 +703,23 @@ private:
     GameInitSettings::HouseInfoList     houseInfoListSetup;     ///< this saves with which houses and players the game was actually set up. It is a copy of gameInitSettings::houseInfoList but without random houses
 
 
+    StateHash           stateHash;              ///< This is the hash of the game state compared between multiplayer peers
+
     ObjectManager       objectManager;          ///< This manages all the object and maps object ids to the actual objects
 
     CommandManager      cmdManager;             ///< This is the manager for all the game commands (e.g. moving a unit)
 
+    ReplayKeyframes     replayKeyframes;        ///< This holds the keyframes recorded for or loaded from the replay file
+
+    SaveGameWriter      saveGameWriter;         ///< This writes the savegames to disk in a separate thread
+
     TriggerManager      triggerManager;         ///< This is the manager for all the triggers the scenario has (e.g. reinforcements)
 
+    CycleProfiler       cycleProfiler;          ///< This measures the time spent in the different parts of a game cycle
+
+    SpriteBatch         spriteBatch;            ///< This batches the sprites drawn by drawScreen()
+    TerrainChunkCache   terrainChunkCache;      ///< This holds the prerendered ground layer drawn by drawScreen()
+
     bool    bQuitGame = false;                  ///< Should the game be quited after this game tick
     bool    bPause = false;                     ///< Is the game currently halted
     bool    bMenu = false;                      ///< Is there currently a menu shown (options or mentat menu)
@@ -580,6 +727,8 @@ private:
 
     bool    bShowFPS = false;                   ///< Show the FPS
 
+    bool    bShowCycleProfiler = false;         ///< Show the time spent in the different parts of a game cycle
+
     bool    bShowTime = false;                  ///< Show how long this game is running
 
     bool    bCheatsEnabled = false;             ///< Cheat codes are enabled?
@@ -0,0 +1,85 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+
+// forward declarations
+class Game;
+
+/**
+    Runs the simulation of a game as fast as possible without drawing, sound output or input handling. This is used by
+    the dunelegacy-headless program (see HeadlessMain.cpp) to replay a game on a build machine and measure the
+    simulation speed.
+
+    Every game cycle does the same steps in the same order as Game::runMainLoop(); only the steps that affect what is
+    shown on the screen are left out. The steps are measured by the cycle profiler of the game (see CycleProfiler)
+    which is enabled while running.
+*/
+class HeadlessRunner {
+public:
+    /**
+        Constructor
+        \param  game    the game to run (initialized with Game::initGame() or Game::initReplay())
+    */
+    explicit HeadlessRunner(Game& game);
+    ~HeadlessRunner();
+
+    HeadlessRunner(const HeadlessRunner &) = delete;
+    HeadlessRunner(HeadlessRunner &&) = delete;
+    HeadlessRunner& operator=(const HeadlessRunner &) = delete;
+    HeadlessRunner& operator=(HeadlessRunner &&) = delete;
+
+    /**
+        Runs the game until it is won, lost or quit or until maxCycles game cycles have been simulated.
+        \param  maxCycles   the maximum number of game cycles to simulate
+    */
+    void run(Uint32 maxCycles);
+
+    /**
+        Get the number of game cycles simulated by run().
+        \return the number of simulated game cycles
+    */
+    Uint32 getNumCycles() const { return numCycles; }
+
+    /**
+        Get the time spent simulating in run().
+        \return the time in seconds
+    */
+    double getTotalSeconds() const { return totalSeconds; }
+
+    /**
+        Calculates a hash of the current game state. It is the md5 sum of a savegame of the game (see Game::saveGame()).
+        Two runs of the same replay have to end with the same hash; otherwise the simulation is not deterministic.
+        \return the hash as a hex string
+    */
+    std::string getStateHash() const;
+
+private:
+    void start();
+
+    Game&   game;                                   ///< the game to run
+    bool    bStarted = false;                       ///< has the game been prepared for running (see start())?
+    Uint32  numCycles = 0;                          ///< the number of game cycles simulated so far
+    double  totalSeconds = 0.0;                     ///< the time spent in run() in seconds
+};
+
+#endif // HEADLESSRUNNER_H
@@ -0,0 +1,129 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HIERARCHICALPATHFINDER_H
+#define HIERARCHICALPATHFINDER_H
+
+#include <DataTypes.h>
+
+#include <vector>
+
+class Map;
+
+/**
+    A hierarchical path planner (HPA*) for long distance moves of ground vehicles.
+
+    The map is divided into clusters of CLUSTER_SIZE x CLUSTER_SIZE tiles. Along the border of two neighboring clusters
+    every run of tiles that is passable on both sides forms an entrance with one or two transition points. The transition
+    points of a cluster are connected by precomputed intra-cluster edges. A path query is answered by searching this
+    small abstract graph; the resulting waypoints are refined with a short AStarSearch by the unit.
+
+    Only static obstacles (mountains and structures) are considered. Other units are handled by the local search.
+    When the static passability of a tile changes only the affected cluster and its neighbors are rebuilt, lazily
+    on the next query. The abstract graph is always a pure function of the current map, so results are identical
+    on all peers and after loading a savegame.
+*/
+class HierarchicalPathfinder {
+public:
+    static const int CLUSTER_SIZE = 16;
+
+    explicit HierarchicalPathfinder(Map* pMap);
+    ~HierarchicalPathfinder();
+
+    HierarchicalPathfinder(const HierarchicalPathfinder &) = delete;
+    HierarchicalPathfinder(HierarchicalPathfinder &&) = delete;
+    HierarchicalPathfinder& operator=(const HierarchicalPathfinder &) = delete;
+    HierarchicalPathfinder& operator=(HierarchicalPathfinder &&) = delete;
+
+    /**
+        Discards the whole abstract graph. It is rebuilt on the next query.
+    */
+    void reset();
+
+    /**
+        This method must be called whenever the terrain of a tile changed or a structure was placed on or removed from it.
+        \param  location    the tile that changed
+    */
+    void onTileChanged(const Coord& location);
+
+    /**
+        Plans a coarse path from start to destination.
+        \param  start       the start tile
+        \param  destination the destination tile (may be blocked, e.g. a structure to attack)
+        \param  waypoints   the waypoints from start (exclusive) to destination (inclusive)
+        \return true if a path was found, false if start and destination are in the same cluster or no path exists
+    */
+    bool findWaypoints(const Coord& start, const Coord& destination, std::vector<Coord>& waypoints);
+
+private:
+    struct Edge {
+        int targetTile;     ///< tile index of the target node
+        int cost;           ///< cost (10 per straight move, 14 per diagonal move)
+    };
+
+    /// A transition between two neighboring clusters
+    struct Transition {
+        int first;      ///< the tile index in the left/upper cluster
+        int second;     ///< the tile index in the right/lower cluster
+        int cost;       ///< the cost to move from first to second
+    };
+
+    struct Cluster {
+        std::vector<int>                nodes;                  ///< tile indices of all transition points in this cluster (sorted)
+        std::vector<std::vector<Edge>>  edges;                  ///< intra and inter cluster edges for each node
+        bool                            bBordersDirty = true;   ///< the entrances on the borders of this cluster must be recomputed
+        bool                            bEdgesDirty = true;     ///< the nodes and edges of this cluster must be recomputed
+    };
+
+    void resizeIfNeeded();
+    void rebuildDirtyClusters();
+    void rebuildBorder(int clusterX, int clusterY, bool bVertical);
+    void rebuildCluster(int clusterX, int clusterY);
+    void calculateDistancesInCluster(int sourceTile, std::vector<int>& distances);
+    void markEdgesDirty(int clusterX, int clusterY);
+
+    bool isStaticallyPassable(int x, int y) const;
+
+    inline int getTileIndex(int x, int y) const { return y * sizeX + x; }
+    inline int getClusterIndex(int clusterX, int clusterY) const { return clusterY * numClustersX + clusterX; }
+    inline int getClusterIndexOfTile(int tile) const { return getClusterIndex((tile % sizeX) / CLUSTER_SIZE, (tile / sizeX) / CLUSTER_SIZE); }
+
+    /// the border between a cluster and its right (bVertical == true) or lower (bVertical == false) neighbor
+    inline int getBorderIndex(int clusterX, int clusterY, bool bVertical) const { return 2*getClusterIndex(clusterX, clusterY) + (bVertical ? 0 : 1); }
+
+    int     heuristic(int tile1, int tile2) const;
+
+    Map*    pMap;
+    int     sizeX = 0;
+    int     sizeY = 0;
+    int     numClustersX = 0;
+    int     numClustersY = 0;
+    bool    bDirty = true;                      ///< at least one cluster needs to be rebuilt
+
+    std::vector<bool>                       blocked;        ///< static passability of each tile as used for the current graph
+    std::vector<Cluster>                    clusters;
+    std::vector<std::vector<Transition>>    borders;        ///< the transitions of every border (see getBorderIndex())
+    std::vector<int>                        nodeOfTile;     ///< for each tile the index into Cluster::nodes (or -1)
+
+    // search state (reused between queries, valid if the stamp equals the current search generation)
+    std::vector<int>        searchCost;
+    std::vector<int>        searchParent;
+    std::vector<Uint32>     searchStamp;
+    Uint32                  searchGeneration = 0;
+};
+
+#endif // HIERARCHICALPATHFINDER_H
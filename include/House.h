@@ -196,6 +196,18 @@ public:
 protected:
     void decrementHarvesters();
 
+    /**
+        Sets storedCredits and updates the state hash of the game.
+        \param newStoredCredits    the new amount of stored credits
+    */
+    void setStoredCredits(FixPoint newStoredCredits);
+
+    /**
+        Sets startingCredits and updates the state hash of the game.
+        \param newStartingCredits  the new amount of starting credits
+    */
+    void setStartingCredits(FixPoint newStartingCredits);
+
     std::list<std::unique_ptr<Player> > players;        ///< List of associated players that control this house
 
     bool    ai;             ///< Is this an ai player?
@@ -19,12 +19,22 @@
 #define MAP_H
 
 #include <Tile.h>
+#include <AStarSearch.h>
+#include <FlowField.h>
+#include <FogOfWar.h>
+#include <HierarchicalPathfinder.h>
+#include <RadarChangeFeed.h>
+#include <SpatialIndex.h>
+#include <TileAttributes.h>
+#include <VisibilityBitmaps.h>
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <misc/exceptions.h>
 #include <misc/Random.h>
 
 #include <cstdio>
+#include <map>
+#include <memory>
 
 class Map
 {
@@ -107,6 +117,135 @@ public:
         return getTile(location.x, location.y);
     }
 
+    /**
+        Returns the workspace that is shared by all path searches on this map.
+        \return the path search workspace
+    */
+    AStarSearch::Workspace& getPathSearchWorkspace() noexcept {
+        return pathSearchWorkspace;
+    }
+
+    /**
+        Returns the spatial index of all units and structures on this map.
+        \return the spatial index
+    */
+    SpatialIndex& getSpatialIndex() noexcept {
+        return spatialIndex;
+    }
+
+    /**
+        Returns the bookkeeping of which tiles are currently seen by the ground units and structures of each house.
+        \return the fog of war
+    */
+    FogOfWar& getFogOfWar() noexcept {
+        return fogOfWar;
+    }
+
+    /**
+        Returns the packed explored and occupied bitmaps of this map.
+        \return the visibility bitmaps
+    */
+    VisibilityBitmaps& getVisibilityBitmaps() noexcept {
+        return visibilityBitmaps;
+    }
+
+    /**
+        Returns the packed attributes of all tiles (terrain type, passability, owner and occupancy) for hot loops.
+        \return the tile attributes
+    */
+    TileAttributes& getTileAttributes() noexcept {
+        return tileAttributes;
+    }
+
+    const TileAttributes& getTileAttributes() const noexcept {
+        return tileAttributes;
+    }
+
+    /**
+        Returns the tiles that changed their color on the radar since the radar was drawn the last time.
+        \return the radar change feed
+    */
+    RadarChangeFeed& getRadarChangeFeed() noexcept {
+        return radarChangeFeed;
+    }
+
+    /**
+        Returns the hierarchical path planner used for long distance moves on this map.
+        \return the hierarchical path planner
+    */
+    HierarchicalPathfinder& getHierarchicalPathfinder() noexcept {
+        return hierarchicalPathfinder;
+    }
+
+    /**
+        This method must be called whenever the terrain of a tile changed or a structure was placed on or removed from it.
+        \param location    the tile that changed
+    */
+    void onTileChanged(const Coord& location) {
+        hierarchicalPathfinder.onTileChanged(location);
+        onTileAppearanceChanged(location);
+    }
+
+    /**
+        This method must be called whenever a tile looks different on the ground layer (terrain type, spice amount or
+        destroyed structure tile). The terrain tile of the 4 neighbours depends on this tile, so they are invalidated too.
+        \param location    the tile that changed
+    */
+    void onTileAppearanceChanged(const Coord& location);
+
+    /**
+        Returns the version of a chunk of TERRAIN_CHUNK_SIZE x TERRAIN_CHUNK_SIZE tiles. The version is incremented
+        every time a tile in this chunk changes its look (see onTileAppearanceChanged()). It is used to decide whether a
+        prerendered chunk of the ground layer is still up to date.
+        \param chunkX  the x coordinate of the chunk (tile x coordinate / TERRAIN_CHUNK_SIZE)
+        \param chunkY  the y coordinate of the chunk (tile y coordinate / TERRAIN_CHUNK_SIZE)
+        \return the version of this chunk
+    */
+    Uint32 getTerrainChunkVersion(int chunkX, int chunkY) const noexcept {
+        return terrainChunkVersions[chunkY * getNumTerrainChunksX() + chunkX];
+    }
+
+    int getNumTerrainChunksX() const noexcept { return (sizeX + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE; }
+    int getNumTerrainChunksY() const noexcept { return (sizeY + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE; }
+
+    static const int TERRAIN_CHUNK_SIZE = 16;   ///< number of tiles per row and column of a terrain chunk
+
+    /**
+        Adds a unit to the group move of all ground units of the same movement class heading to destination.
+        \param destination     the destination of the unit
+        \param movementClass   the movement class of the unit
+    */
+    void joinGroupMove(const Coord& destination, TileAttributes::MovementClass movementClass);
+
+    /**
+        Removes a unit from the group move it joined with joinGroupMove().
+        \param destination     the destination of the unit
+        \param movementClass   the movement class of the unit
+    */
+    void leaveGroupMove(const Coord& destination, TileAttributes::MovementClass movementClass);
+
+    /**
+        Returns the flow field shared by all units of a group move. The field is computed on first use and again after
+        every change of the terrain, so it only depends on the current terrain and not on when it was requested.
+        \param destination     the destination of the group move
+        \param movementClass   the movement class of the units
+        \return the flow field or nullptr if less than FlowField::MIN_GROUP_SIZE units are in this group move
+    */
+    const FlowField* getFlowField(const Coord& destination, TileAttributes::MovementClass movementClass);
+
+    /**
+        Registers a tile that has state changing over time (see Tile::needsUpdate()). The tile is updated every game
+        cycle by updateActiveTiles() until it has nothing left to update. Registering a tile twice has no effect.
+        \param location    the tile to register
+    */
+    void activateTile(const Coord& location);
+
+    /**
+        Updates all registered tiles (see activateTile()) and drops the ones that need no more updates. This method
+        must be called once per game cycle.
+    */
+    void updateActiveTiles();
+
     template<typename F>
     void for_all(F&& f)
     {
@@ -180,8 +319,33 @@ private:
     Sint32  sizeY;                          ///< number of tiles this map is high (read only)
     std::vector<Tile> tiles;                ///< the 2d-array containing all the tiles of the map
     ObjectBase* lastSinglySelectedObject;   ///< The last selected object. If selected again all units of the same type are selected
+    AStarSearch::Workspace pathSearchWorkspace; ///< the node records and open list reused by all path searches on this map
+    HierarchicalPathfinder hierarchicalPathfinder;  ///< the abstract graph for long distance moves (rebuilt lazily, not saved)
+    SpatialIndex spatialIndex;              ///< the bucket grid of all units and structures (used for target acquisition)
+    VisibilityBitmaps visibilityBitmaps;    ///< the explored and occupied tiles as bitmaps (derived from the tiles, not saved)
+    RadarChangeFeed radarChangeFeed;        ///< the tiles to repaint on the radar (not saved)
+    TileAttributes tileAttributes;          ///< the attributes of all tiles read by hot loops (derived from the tiles, not saved)
+    FogOfWar fogOfWar;                      ///< the tiles currently seen by each house (not saved)
+
+    /// The units heading to the same destination with the same movement class
+    struct GroupMove {
+        int                         numUnits = 0;   ///< the number of units in this group move
+        std::unique_ptr<FlowField>  pFlowField;     ///< the flow field of this group (computed on demand)
+    };
+    std::map<std::pair<int, TileAttributes::MovementClass>, GroupMove> groupMoves;  ///< all group moves by destination tile index and movement class (derived from the units, not saved)
+
+    static const int ACTIVE_TILE_STRIPE_HEIGHT = 16;    ///< number of map rows per stripe of active tiles
+    std::vector<std::vector<int>> activeTileStripes;    ///< the indices of all tiles that need updates, one list per stripe of rows (not saved)
+    std::vector<Uint8> activeTileFlags;                 ///< is a tile in activeTileStripes? (not saved)
+
+    std::vector<Uint32> terrainChunkVersions;           ///< the version of each terrain chunk (see getTerrainChunkVersion(), not saved)
 
     void init_tile_location();
+    void init_visibility_bitmaps();
+    void init_active_tiles();
+    void init_terrain_chunks();
+    void init_radar_changes();
+    void updateActiveTileStripe(std::vector<int>& stripe);
 
     int tile_index(int xPos, int yPos) const noexcept
     {
@@ -29,12 +29,14 @@ class ENetPacketIStream : public InputStream
 {
 public:
     explicit ENetPacketIStream(ENetPacket* pPacket)
-     : currentPos(0), packet(pPacket) {
-        ;
+     : packet(pPacket) {
+        // the whole packet is the buffer; reading past its end is an End-of-File (see InputStream::underflow())
+        pReadPos = (const char*) packet->data;
+        pReadEnd = (const char*) (packet->data + packet->dataLength);
     }
 
     explicit ENetPacketIStream(const ENetPacketIStream& p)
-     : currentPos(0), packet(nullptr) {
+     : packet(nullptr) {
         *this = p;
     }
 
@@ -55,85 +57,17 @@ public:
                 enet_packet_destroy(packet);
             }
 
+            const size_t currentPos = p.pReadPos - (const char*) p.packet->data;
+
             packet = packetCopy;
-            currentPos = p.currentPos;
+            pReadPos = (const char*) (packet->data + currentPos);
+            pReadEnd = (const char*) (packet->data + packet->dataLength);
         }
 
         return *this;
     }
 
-    std::string readString() override
-    {
-        Uint32 length = readUint32();
-
-        if(currentPos + length > packet->dataLength) {
-            THROW(InputStream::eof, "ENetPacketIStream::readString(): End-of-File reached!");
-        }
-
-        std::string resultString((char*) (packet->data + currentPos), length);
-        currentPos += length;
-        return resultString;
-    }
-
-    Uint8 readUint8() override
-    {
-        if(currentPos + sizeof(Uint8) > packet->dataLength) {
-            THROW(InputStream::eof, "ENetPacketIStream::readUint8(): End-of-File reached!");
-        }
-
-        Uint8 tmp = *((Uint8*) (packet->data + currentPos));
-        currentPos += sizeof(Uint8);
-        return tmp;
-    }
-
-    Uint16 readUint16() override
-    {
-        if(currentPos + sizeof(Uint16) > packet->dataLength) {
-            THROW(InputStream::eof, "ENetPacketIStream::readUint16(): End-of-File reached!");
-        }
-
-        Uint16 tmp = *((Uint16*) (packet->data + currentPos));
-        currentPos += sizeof(Uint16);
-        return SDL_SwapLE16(tmp);
-    }
-
-    Uint32 readUint32() override
-    {
-        if(currentPos + sizeof(Uint32) > packet->dataLength) {
-            THROW(InputStream::eof, "ENetPacketIStream::readUint32(): End-of-File reached!");
-        }
-
-        Uint32 tmp = *((Uint32*) (packet->data + currentPos));
-        currentPos += sizeof(Uint32);
-        return SDL_SwapLE32(tmp);
-    }
-
-    Uint64 readUint64() override
-    {
-        if(currentPos + sizeof(Uint64) > packet->dataLength) {
-            THROW(InputStream::eof, "ENetPacketIStream::readUint64(): End-of-File reached!");
-        }
-
-        Uint64 tmp = *((Uint64*) (packet->data + currentPos));
-        currentPos += sizeof(Uint64);
-        return SDL_SwapLE64(tmp);
-    }
-
-    bool readBool() override
-    {
-        return (readUint8() == 1 ? true : false);
-    }
-
-    float readFloat() override
-    {
-        Uint32 tmp = readUint32();
-        float tmp2;
-        memcpy(&tmp2,&tmp,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
-        return tmp2;
-    }
-
 private:
-    size_t  currentPos;
     ENetPacket* packet;
 };
 
@@ -27,16 +27,16 @@
 class ENetPacketOStream : public OutputStream
 {
 public:
-    explicit ENetPacketOStream(enet_uint32 flags)
-     : currentPos(0) {
+    explicit ENetPacketOStream(enet_uint32 flags) {
         packet = enet_packet_create(nullptr,16,flags);
         if(packet == nullptr) {
             THROW(OutputStream::error, "ENetPacketOStream: enet_packet_create() failed!");
         }
+        setBuffer(0);
     }
 
     ENetPacketOStream(const ENetPacketOStream& p)
-     : currentPos(0), packet(nullptr) {
+     : packet(nullptr) {
         *this = p;
     }
 
@@ -58,20 +58,22 @@ public:
             }
 
             packet = packetCopy;
-            currentPos = p.currentPos;
+            setBuffer(p.getCurrentPos());
         }
 
         return *this;
     }
 
     ENetPacket* getPacket() {
-        if(enet_packet_resize(packet,currentPos) < 0) {
+        if(enet_packet_resize(packet,getCurrentPos()) < 0) {
             THROW(OutputStream::error, "ENetPacketOStream::getPacket(): enet_packet_resize() failed!");
         }
 
         ENetPacket* pPacket = packet;
 
         packet = nullptr;
+        pWritePos = nullptr;
+        pWriteEnd = nullptr;
 
         return pPacket;
     }
@@ -81,62 +83,6 @@ public:
         ;
     }
 
-
-    // write operations
-
-    void writeString(const std::string& str) override
-    {
-        ensureBufferSize(currentPos + str.length() + sizeof(Uint32));
-
-        writeUint32(str.length());
-
-        if(!str.empty()) {
-            memcpy(packet->data + currentPos, str.c_str(), str.length());
-            currentPos += str.length();
-        }
-    }
-
-
-    void writeUint8(Uint8 x) override
-    {
-        ensureBufferSize(currentPos + sizeof(Uint8));
-        *((Uint8*) (packet->data + currentPos)) = x;
-        currentPos += sizeof(Uint8);
-    }
-
-    void writeUint16(Uint16 x) override
-    {
-        ensureBufferSize(currentPos + sizeof(Uint16));
-        *((Uint16*) (packet->data + currentPos)) = SDL_SwapLE16(x);
-        currentPos += sizeof(Uint16);
-    }
-
-    void writeUint32(Uint32 x) override
-    {
-        ensureBufferSize(currentPos + sizeof(Uint32));
-        *((Uint32*) (packet->data + currentPos)) = SDL_SwapLE32(x);
-        currentPos += sizeof(Uint32);
-    }
-
-    void writeUint64(Uint64 x) override
-    {
-        ensureBufferSize(currentPos + sizeof(Uint64));
-        *((Uint64*) (packet->data + currentPos)) = SDL_SwapLE64(x);
-        currentPos += sizeof(Uint64);
-    }
-
-    void writeBool(bool x) override
-    {
-        writeUint8(x == true ? 1 : 0);
-    }
-
-    void writeFloat(float x) override
-    {
-        Uint32 tmp;
-        memcpy(&tmp,&x,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
-        writeUint32(tmp);
-    }
-
     void ensureBufferSize(size_t minBufferSize) {
         if(minBufferSize < packet->dataLength) {
             return;
@@ -147,14 +93,38 @@ public:
             newBufferSize = minBufferSize;
         }
 
+        const size_t currentPos = getCurrentPos();
+
         if(enet_packet_resize(packet,newBufferSize) < 0) {
             THROW(OutputStream::error, "ENetPacketOStream::ensureBufferSize(): enet_packet_resize() failed!");
         }
+
+        // the packet data might have been moved
+        setBuffer(currentPos);
     }
 
+protected:
+    void overflow(const char* pData, size_t length) override
+    {
+        if(packet == nullptr) {
+            THROW(OutputStream::error, "ENetPacketOStream::overflow(): The packet was already taken by getPacket()!");
+        }
+
+        ensureBufferSize(getCurrentPos() + length);
+        memcpy(pWritePos, pData, length);
+        pWritePos += length;
+    }
 
 private:
-    size_t  currentPos;
+    size_t getCurrentPos() const {
+        return (packet == nullptr) ? 0 : (pWritePos - (char*) packet->data);
+    }
+
+    void setBuffer(size_t currentPos) {
+        pWritePos = (char*) (packet->data + currentPos);
+        pWriteEnd = (char*) (packet->data + packet->dataLength);
+    }
+
     ENetPacket* packet;
 };
 
@@ -51,6 +51,7 @@
 #define NETWORKPACKET_STARTGAME             8
 #define NETWORKPACKET_COMMANDLIST           9
 #define NETWORKPACKET_SELECTIONLIST         10
+#define NETWORKPACKET_STATEHASH             11
 
 #define AWAITING_CONNECTION_TIMEOUT     5000
 
@@ -85,6 +86,8 @@ public:
 
     void sendSelectedList(const std::set<Uint32>& selectedList, int groupListIndex = -1);
 
+    void sendStateHash(Uint32 gameCycle, Uint64 stateHash);
+
     std::list<std::string> getConnectedPeers() const {
         std::list<std::string> peerNameList;
 
@@ -174,6 +177,14 @@ public:
         this->pOnReceiveSelectionList = pOnReceiveSelectionList;
     }
 
+    /**
+        Sets the function that should be called when the state hash of a peer is received.
+        \param  pOnReceiveStateHash function to call on receive (with the name of the peer, the game cycle and the hash)
+    */
+    inline void setOnReceiveStateHash(std::function<void (const std::string&, Uint32, Uint64)> pOnReceiveStateHash) {
+        this->pOnReceiveStateHash = pOnReceiveStateHash;
+    }
+
 private:
     static void debugNetwork(PRINTF_FORMAT_STRING const char* fmt, ...) PRINTF_VARARG_FUNC(1);
 
@@ -233,6 +244,7 @@ private:
     std::function<void (unsigned int)>                                      pOnStartGame;
     std::function<void (const std::string&, const CommandList&)>            pOnReceiveCommandList;
     std::function<void (const std::string&, const std::set<Uint32>&, int)>  pOnReceiveSelectionList;
+    std::function<void (const std::string&, Uint32, Uint64)>                pOnReceiveStateHash;
 
     std::unique_ptr<LANGameFinderAndAnnouncer>  pLANGameFinderAndAnnouncer = nullptr;
     std::unique_ptr<MetaServerClient>           pMetaServerClient = nullptr;
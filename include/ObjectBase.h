@@ -188,6 +188,12 @@ public:
 protected:
     bool targetInWeaponRange() const;
 
+    /**
+        Changes the location of this object and keeps the spatial index of the map up to date.
+        \param  newLocation the new location (may be invalid)
+    */
+    void changeLocation(const Coord& newLocation);
+
     // constant for all objects of the same type
     Uint32   itemID;                 ///< The ItemID of this object.
     int      radius;                 ///< The radius of this object
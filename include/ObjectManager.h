@@ -21,21 +21,28 @@
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <misc/SDL2pp.h>
+#include <Definitions.h>
 
-#include <map>
+#include <vector>
 
 // forward declarations
 class ObjectBase;
 
-typedef std::map<Uint32,ObjectBase*> ObjectMap;
+/**
+    This class holds all objects (structures and units) in the game.
 
-/// This class holds all objects (structures and units) in the game.
+    Object IDs are handed out in increasing order and are never reused. The ID of an object is therefore used directly as
+    the index into a table of object pointers: a lookup is a single bounds check and array access and an ID of a removed
+    object simply finds an empty slot. Iterating over the table visits the objects in the order of their IDs.
+*/
 class ObjectManager{
 public:
+    static const Uint32 MAX_OBJECT_ID = 1 << 22;   ///< a savegame with larger object IDs is rejected; no game comes close to it
+
     /**
         Default constructor
     */
-    ObjectManager() : nextFreeObjectID(1)
+    ObjectManager() : nextFreeObjectID(1), numObjects(0)
     {
     }
 
@@ -62,7 +69,14 @@ public:
         \param  pObject A pointer to the object.
         \return ObjectID of the added object.
     */
-    Uint32 addObject(ObjectBase* pObject);
+    Uint32 addObject(ObjectBase* pObject) {
+        if(!insertObject(nextFreeObjectID, pObject)) {
+            // there is already such an object in the list
+            return NONE_ID;
+        } else {
+            return nextFreeObjectID++;  // Caution: Old value is returned but value is incremented afterwards
+        }
+    }
 
     /**
         This method searches for the object with ObjectID.
@@ -70,13 +84,7 @@ public:
         \return Pointer to this object (nullptr if not found)
     */
     inline ObjectBase* getObject(Uint32 objectID) const {
-        ObjectMap::const_iterator iter = objectMap.find(objectID);
-
-        if(iter == objectMap.end()) {
-            return nullptr;
-        } else {
-            return iter->second;
-        }
+        return (objectID < objectTable.size()) ? objectTable[objectID] : nullptr;
     }
 
     /**
@@ -85,12 +93,43 @@ public:
         \return false if there was no object with this ObjectID, true if it could be removed
     */
     bool removeObject(Uint32 objectID) {
-        return (objectMap.erase(objectID) != 0);
+        if((objectID >= objectTable.size()) || (objectTable[objectID] == nullptr)) {
+            return false;
+        }
+
+        objectTable[objectID] = nullptr;
+        numObjects--;
+        return true;
     }
 
+    /**
+        Returns the number of objects currently managed.
+        \return the number of objects
+    */
+    inline Uint32 getNumObjects() const { return numObjects; }
+
 private:
+    bool insertObject(Uint32 objectID, ObjectBase* pObject) {
+        if(objectID == NONE_ID) {
+            return false;
+        }
+
+        if(objectID >= objectTable.size()) {
+            objectTable.resize(objectID + 1, nullptr);
+        }
+
+        if(objectTable[objectID] != nullptr) {
+            return false;
+        }
+
+        objectTable[objectID] = pObject;
+        numObjects++;
+        return true;
+    }
+
     Uint32 nextFreeObjectID;
-    ObjectMap objectMap;
+    Uint32 numObjects;                      ///< number of non-empty entries in objectTable
+    std::vector<ObjectBase*> objectTable;   ///< the object with ID i is stored at index i (nullptr if there is none)
 };
 
 #endif //OBJECTMANAGER_H
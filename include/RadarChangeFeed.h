@@ -0,0 +1,122 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef RADARCHANGEFEED_H
+#define RADARCHANGEFEED_H
+
+#include <DataTypes.h>
+
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/**
+    Collects the tiles whose color on the radar might have changed since the radar was drawn the last time: the terrain
+    type, the object on the tile (or its owner) or whether the tile is explored or fogged.
+
+    The map marks tiles as changed through the methods of Tile that modify this state. Fogging is the only change without
+    a method call, it happens a certain time after a tile was seen the last time (see Tile::setExplored()); therefore
+    such tiles are scheduled for a fog check and marked as changed when the check is due (see update()).
+    There is only one consumer (the radar of the local player, see RadarView).
+*/
+class RadarChangeFeed {
+public:
+    RadarChangeFeed(int sizeX, int sizeY);
+    ~RadarChangeFeed();
+
+    RadarChangeFeed(const RadarChangeFeed &) = delete;
+    RadarChangeFeed(RadarChangeFeed &&) = delete;
+    RadarChangeFeed& operator=(const RadarChangeFeed &) = delete;
+    RadarChangeFeed& operator=(RadarChangeFeed &&) = delete;
+
+    /**
+        Drops all changes and fog checks, changes the size of the map and marks all tiles as changed.
+        \param  sizeX   the width of the map
+        \param  sizeY   the height of the map
+    */
+    void reset(int sizeX, int sizeY);
+
+    /**
+        Marks a tile as changed. Marking a tile twice has no effect.
+        \param  x   the x coordinate of the tile
+        \param  y   the y coordinate of the tile
+    */
+    inline void markChanged(int x, int y) {
+        const int index = y * sizeX + x;
+        if(changedFlags[index] == 0) {
+            changedFlags[index] = 1;
+            changedTiles.push_back(index);
+        }
+    }
+
+    /**
+        Marks all tiles as changed (e.g. when the radar is switched on or off).
+    */
+    inline void markAllChanged() noexcept {
+        bAllChanged = true;
+    }
+
+    /**
+        Schedules a tile to be marked as changed in game cycle cycle.
+        \param  x       the x coordinate of the tile
+        \param  y       the y coordinate of the tile
+        \param  cycle   the game cycle the tile might get fogged
+    */
+    inline void scheduleFogCheck(int x, int y, Uint32 cycle) {
+        fogChecks.emplace(cycle, y * sizeX + x);
+    }
+
+    /**
+        Marks all tiles with a fog check due until currentCycle as changed. This method must be called once per game
+        cycle, also when the radar is not drawn, so that the scheduled fog checks do not pile up.
+        \param  currentCycle    the current game cycle
+    */
+    void update(Uint32 currentCycle);
+
+    /**
+        Reports all changed tiles and clears them.
+        \param  f   is called with the x and y coordinate of every changed tile
+        \return false if all tiles changed; f is not called in this case and the whole radar has to be repainted
+    */
+    template<typename F>
+    bool consume(F&& f) {
+        const bool bResult = !bAllChanged;
+        for(const int index : changedTiles) {
+            changedFlags[index] = 0;
+            if(bResult) {
+                f(index % sizeX, index / sizeX);
+            }
+        }
+        changedTiles.clear();
+        bAllChanged = false;
+
+        return bResult;
+    }
+
+private:
+    typedef std::pair<Uint32, int> FogCheck;    ///< the game cycle and the index of the tile
+
+    int sizeX;                                  ///< the width of the map
+    bool bAllChanged = true;                    ///< have all tiles changed?
+    std::vector<int> changedTiles;              ///< the indices of all changed tiles
+    std::vector<Uint8> changedFlags;            ///< is a tile in changedTiles?
+    std::priority_queue<FogCheck, std::vector<FogCheck>, std::greater<FogCheck>> fogChecks;    ///< the scheduled fog checks, earliest first
+};
+
+#endif // RADARCHANGEFEED_H
@@ -96,7 +96,11 @@ private:
         AnimationRadarOn
     };
 
-    void updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int offsetX, int offsetY);
+    /**
+        Repaints the tiles reported by the radar change feed of the map (or all tiles if everything changed).
+        \return the part of the surface that was repainted (empty if nothing changed)
+    */
+    SDL_Rect updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int offsetX, int offsetY);
 
     RadarMode currentRadarMode;             ///< the current mode of the radar
 
@@ -104,6 +108,10 @@ private:
 
     int animCounter;                        ///< this counter is for counting the ticks one animation frame is shown
 
+    bool bLastRadar = false;                ///< was the radar on when the surface was updated the last time?
+    bool bLastDebug = false;                ///< was debug mode on when the surface was updated the last time?
+    bool bSurfaceValid = false;             ///< has the surface been painted completely?
+
     sdl2::surface_ptr radarSurface;         ///< contains the image to be drawn when the radar is active
     sdl2::texture_ptr radarTexture;         ///< streaming texture to be used when the radar is active
     SDL_Texture* radarStaticAnimation;      ///< holds the animation graphic for radar static
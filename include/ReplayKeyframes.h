@@ -0,0 +1,157 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef REPLAYKEYFRAMES_H
+#define REPLAYKEYFRAMES_H
+
+#include <Definitions.h>
+
+#include <misc/InputStream.h>
+#include <misc/OutputStream.h>
+#include <misc/OMemoryStream.h>
+
+#include <SDL2/SDL.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+    The keyframes of a replay. A keyframe is a compressed savegame without the commands (see Game::saveGame()) taken
+    between two game cycles.
+    While a game is recorded a keyframe is taken every KEYFRAME_INTERVAL game cycles and written into the replay file
+    between the commands, marked by the cycle number KEYFRAME_MARKER (see CommandManager::load()). To seek in a replay
+    the game is restarted from the latest keyframe before the target cycle and only the remaining cycles are simulated.
+
+    While recording, the game only serializes the keyframe into getBuffer(); it is compressed in a separate thread (see
+    addInBackground()) so that the game is not stopped for it.
+*/
+class ReplayKeyframes {
+public:
+    static constexpr Uint32 KEYFRAME_MARKER = 0xFFFFFFFF;                   ///< written instead of a cycle number before every keyframe
+    static constexpr Uint32 KEYFRAME_INTERVAL = MILLI2CYCLES(2*60*1000);    ///< the number of game cycles between two keyframes
+
+    static constexpr Uint32 MAX_COMPRESSION_RATIO = 1032;                   ///< deflate cannot compress better than this
+
+    ReplayKeyframes();
+
+    /**
+        Destructor. Waits for a keyframe that is still being compressed.
+    */
+    ~ReplayKeyframes();
+
+    ReplayKeyframes(const ReplayKeyframes &) = delete;
+    ReplayKeyframes(ReplayKeyframes &&) = delete;
+    ReplayKeyframes& operator=(const ReplayKeyframes &) = delete;
+    ReplayKeyframes& operator=(ReplayKeyframes &&) = delete;
+
+    /**
+        Returns the buffer to serialize the next keyframe into. A keyframe that is still being compressed is waited for
+        first.
+        \return the opened buffer
+    */
+    OMemoryStream& getBuffer();
+
+    /**
+        Starts compressing the content of the buffer as the keyframe of a cycle in a separate thread. The keyframe is
+        added when pollFinished() returns its cycle.
+        \param  cycle   the game cycle the savegame in the buffer was taken at
+    */
+    void addInBackground(Uint32 cycle);
+
+    /**
+        Waits until the keyframe started by addInBackground() is compressed. It still has to be added by pollFinished().
+    */
+    void waitForCompletion();
+
+    /**
+        Adds the keyframe started by addInBackground() if it has been compressed since the last call.
+        \return the cycle of the added keyframe or 0 if none was added
+    */
+    Uint32 pollFinished();
+
+    /**
+        Writes the keyframe of a cycle (including the KEYFRAME_MARKER) to a replay file.
+        \param  stream  the stream to write to
+        \param  cycle   the game cycle of the keyframe
+    */
+    void save(OutputStream& stream, Uint32 cycle) const;
+
+    /**
+        Writes all keyframes (each including the KEYFRAME_MARKER) to a replay file.
+        \param  stream  the stream to write to
+    */
+    void saveAll(OutputStream& stream) const;
+
+    /**
+        Reads one keyframe from a replay file. The KEYFRAME_MARKER must already be read. A keyframe claiming a savegame
+        larger than its data can be decompressed to is ignored.
+        \param  stream  the stream to read from
+    */
+    void load(InputStream& stream);
+
+    /**
+        Returns the cycle of the latest keyframe at or before a game cycle.
+        \param  cycle   the game cycle to look for
+        \return the cycle of the keyframe or 0 if there is none
+    */
+    Uint32 findKeyframe(Uint32 cycle) const;
+
+    /**
+        Returns the savegame of a keyframe.
+        \param  cycle   the game cycle of the keyframe (see findKeyframe())
+        \return the uncompressed savegame
+    */
+    std::string getSavegame(Uint32 cycle) const;
+
+    /**
+        Returns the number of keyframes.
+        \return the number of keyframes
+    */
+    size_t getNumKeyframes() const noexcept { return keyframes.size(); }
+
+    /**
+        Returns the cycles of all keyframes.
+        \return the cycles in ascending order
+    */
+    std::vector<Uint32> getKeyframeCycles() const;
+
+private:
+    /// A compressed savegame
+    struct Keyframe {
+        Uint32      uncompressedLength;     ///< the length of the savegame
+        std::string data;                   ///< the zlib compressed savegame
+    };
+
+    static unsigned compress(const char* pSavegame, size_t length, Keyframe& keyframe);
+
+    static int compressorThreadMain(void* data);
+
+    std::map<Uint32, Keyframe> keyframes;   ///< all keyframes ordered by cycle
+
+    OMemoryStream   buffer;                 ///< the serialized keyframe (only accessed by the compressor thread while it runs)
+    size_t          lastKeyframeSize = 4;   ///< the size of the last keyframe; used to pre-size the buffer
+    Uint32          pendingCycle = 0;       ///< the cycle of the keyframe being compressed
+    Keyframe        pendingKeyframe;        ///< the keyframe compressed by the compressor thread
+    unsigned        pendingError = 0;       ///< the lodepng error code of compressing pendingKeyframe
+
+    SDL_Thread*     compressorThread;       ///< the thread compressing the buffer (nullptr if none is running)
+    SDL_atomic_t    bFinished;              ///< set to 1 by the compressor thread when it has finished
+};
+
+#endif // REPLAYKEYFRAMES_H
@@ -0,0 +1,104 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SAVEGAMEWRITER_H
+#define SAVEGAMEWRITER_H
+
+#include <misc/OMemoryStream.h>
+
+#include <SDL2/SDL.h>
+
+#include <string>
+
+/// Writes savegames to disk in a separate thread.
+/**
+    The game is serialized into an in-memory buffer (see getBuffer()) which is then written by a background thread. The
+    game only has to be stopped while filling the buffer. The file is first written to "<filename>.tmp" and then
+    renamed, so an existing savegame is never left half-written. Only one savegame is written at a time.
+*/
+class SaveGameWriter final {
+public:
+    SaveGameWriter();
+
+    SaveGameWriter(const SaveGameWriter &) = delete;
+    SaveGameWriter(SaveGameWriter &&) = delete;
+    SaveGameWriter& operator=(const SaveGameWriter &) = delete;
+    SaveGameWriter& operator=(SaveGameWriter &&) = delete;
+
+    /**
+        Destructor. Waits for a savegame that is still being written.
+    */
+    ~SaveGameWriter();
+
+    /**
+        Returns the buffer to serialize the next savegame into. A savegame that is still being written is waited for first.
+        The buffer is opened with the size of the last savegame so that it does not need to grow while serializing.
+        \return the opened buffer
+    */
+    OMemoryStream& getBuffer();
+
+    /**
+        Starts writing the content of the buffer to filename in a separate thread.
+        \param  filename    the file to write the savegame to
+    */
+    void writeInBackground(const std::string& filename);
+
+    /**
+        Waits until the savegame started by writeInBackground() is written.
+    */
+    void waitForCompletion();
+
+    /**
+        Checks whether the savegame started by writeInBackground() has been written since the last call. Then
+        isFailed() and getErrorMessage() tell the result.
+        \return true once for every finished savegame, false otherwise
+    */
+    bool pollFinished();
+
+    /**
+        Did writing the last savegame fail?
+        \return true if it failed
+    */
+    bool isFailed() const noexcept { return !errorMessage.empty(); }
+
+    /**
+        Returns the error that occurred while writing the last savegame.
+        \return the error message (empty if the savegame was written successfully)
+    */
+    const std::string& getErrorMessage() const noexcept { return errorMessage; }
+
+    /**
+        Returns the name of the file the last savegame was written to.
+        \return the filename
+    */
+    const std::string& getFilename() const noexcept { return filename; }
+
+private:
+    static int writerThreadMain(void* data);
+
+    void write();
+
+    OMemoryStream   buffer;                     ///< the serialized savegame (only accessed by the writer thread while it runs)
+    size_t          lastSaveGameSize = 4;       ///< the size of the last savegame; used to pre-size the buffer
+    std::string     filename;                   ///< the file to write the savegame to
+    std::string     errorMessage;               ///< the error of the last savegame (set by the writer thread)
+
+    SDL_Thread*     writerThread;               ///< the thread running write() (nullptr if no savegame is being written)
+    SDL_atomic_t    bFinished;                  ///< set to 1 by the writer thread when it has finished
+};
+
+#endif // SAVEGAMEWRITER_H
@@ -0,0 +1,157 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <DataTypes.h>
+#include <fixmath/FixPoint.h>
+
+#include <algorithm>
+#include <vector>
+
+// forward declarations
+class ObjectBase;
+
+/**
+    A uniform bucket grid of all units and structures. Every object is filed under the bucket of its location;
+    objects without a valid location (e.g. units inside a carryall) are kept in a separate list.
+
+    The index is used to answer "closest object" queries with an expanding ring search instead of walking
+    unitList and structureList. The caller keeps track of the best candidate itself; the index only guarantees that
+    every object that can be at least as close as the best candidate so far is visited.
+*/
+class SpatialIndex {
+public:
+    static const int BUCKET_SIZE = 8;           ///< width and height of a bucket in tiles
+    static const int MAX_STRUCTURE_SIZE = 3;    ///< size of the largest structures (e.g. palace or starport)
+
+    SpatialIndex(int sizeX, int sizeY);
+    ~SpatialIndex();
+
+    SpatialIndex(const SpatialIndex &) = delete;
+    SpatialIndex(SpatialIndex &&) = delete;
+    SpatialIndex& operator=(const SpatialIndex &) = delete;
+    SpatialIndex& operator=(SpatialIndex &&) = delete;
+
+    /**
+        Removes all objects and changes the size of the indexed map.
+        \param  sizeX   the width of the map
+        \param  sizeY   the height of the map
+    */
+    void reset(int sizeX, int sizeY);
+
+    /**
+        Adds an object at its current location.
+        \param  pObject the unit or structure to add
+    */
+    void addObject(ObjectBase* pObject);
+
+    /**
+        Removes an object. The object must still be at the location it is filed under.
+        \param  pObject the unit or structure to remove
+    */
+    void removeObject(ObjectBase* pObject);
+
+    /**
+        Files an object under its new location.
+        \param  pObject     the unit or structure that has moved
+        \param  oldLocation the location the object was filed under
+    */
+    void moveObject(ObjectBase* pObject, const Coord& oldLocation);
+
+    /**
+        Visits all structures (bStructures == true) or units ring by ring around origin. The search stops as soon as all
+        remaining objects are farther away from origin than bestDistance. The visitor usually updates bestDistance.
+        \param  origin          the location to search around
+        \param  bStructures     search structures or units?
+        \param  bestDistance    the block distance of the best candidate found so far
+        \param  visitor         called with every visited object
+    */
+    template<typename Visitor>
+    void visitObjectsAround(const Coord& origin, bool bStructures, const FixPoint& bestDistance, Visitor&& visitor) const {
+        const Grid& grid = bStructures ? structureGrid : unitGrid;
+
+        for(ObjectBase* pObject : grid.unplacedObjects) {
+            visitor(pObject);
+        }
+
+        if(!isInside(origin)) {
+            for(const auto& bucket : grid.buckets) {
+                for(ObjectBase* pObject : bucket) {
+                    visitor(pObject);
+                }
+            }
+            return;
+        }
+
+        // a structure is filed under its upper left corner but may extend to the left or top of the search origin
+        const int slack = bStructures ? MAX_STRUCTURE_SIZE - 1 : 0;
+
+        const int originBucketX = origin.x / BUCKET_SIZE;
+        const int originBucketY = origin.y / BUCKET_SIZE;
+        const int maxRing = std::max(std::max(originBucketX, numBucketsX - 1 - originBucketX), std::max(originBucketY, numBucketsY - 1 - originBucketY));
+
+        for(int ring = 0; ring <= maxRing; ring++) {
+            // all objects in this ring are at least this far away (the block distance is never shorter than the maximum distance)
+            const int minDistance = (ring - 1) * BUCKET_SIZE + 1 - slack;
+            if((ring > 0) && (bestDistance < minDistance)) {
+                return;
+            }
+
+            for(int bucketY = originBucketY - ring; bucketY <= originBucketY + ring; bucketY++) {
+                if((bucketY < 0) || (bucketY >= numBucketsY)) {
+                    continue;
+                }
+
+                const bool bFullRow = (bucketY == originBucketY - ring) || (bucketY == originBucketY + ring);
+                const int step = (bFullRow || (ring == 0)) ? 1 : 2*ring;
+                for(int bucketX = originBucketX - ring; bucketX <= originBucketX + ring; bucketX += step) {
+                    if((bucketX < 0) || (bucketX >= numBucketsX)) {
+                        continue;
+                    }
+
+                    for(ObjectBase* pObject : grid.buckets[bucketY * numBucketsX + bucketX]) {
+                        visitor(pObject);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    struct Grid {
+        std::vector<std::vector<ObjectBase*>>   buckets;            ///< the objects of each bucket (row-major)
+        std::vector<ObjectBase*>                unplacedObjects;    ///< objects without a location on the map
+    };
+
+    inline bool isInside(const Coord& location) const {
+        return (location.x >= 0) && (location.x < sizeX) && (location.y >= 0) && (location.y < sizeY);
+    }
+
+    std::vector<ObjectBase*>& getBucket(Grid& grid, const Coord& location);
+
+    int     sizeX;
+    int     sizeY;
+    int     numBucketsX;
+    int     numBucketsY;
+
+    Grid    unitGrid;
+    Grid    structureGrid;
+};
+
+#endif // SPATIALINDEX_H
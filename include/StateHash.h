@@ -0,0 +1,131 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <misc/SDL2pp.h>
+
+#include <array>
+
+/**
+    A hash of the game state that is updated incrementally whenever a hashed value changes. Every value contributes
+    contribution(category, key, value) to the hash of its category and the contributions are simply added up. Thus the
+    hash does not depend on the order of the changes and a change is folded in by subtracting the contribution of the
+    old value and adding the one of the new value. A value of 0 does not contribute, so values need not be added when
+    they are created with 0 or removed when they are destroyed with 0.
+
+    The hash must only be updated by the deterministic simulation, so that it is equal on all peers of a multiplayer
+    game as long as they are in sync.
+*/
+class StateHash final {
+public:
+    /// The parts of the game state that are hashed separately
+    enum Category {
+        Category_TileSpice,         ///< the spice on the tiles (key is (x << 16) | y)
+        Category_HouseCredits,      ///< the stored and starting credits of the houses (key is 2*houseID and 2*houseID+1)
+        Category_ObjectHealth,      ///< the health of all structures and units (key is objectID)
+        Category_ObjectPosition,    ///< the positions of all structures and units (key is 2*objectID for x and 2*objectID+1 for y)
+        Category_Random,            ///< the seed of the random number generator (key is 0)
+        NUM_CATEGORIES
+    };
+
+    StateHash() {
+        reset();
+    }
+
+    /**
+        Removes all values from the hash.
+    */
+    void reset() noexcept {
+        hashes.fill(0);
+    }
+
+    /**
+        Changes a hashed value.
+        \param  category    the category of the value
+        \param  key         the key of the value inside the category
+        \param  oldValue    the value before the change
+        \param  newValue    the value after the change
+    */
+    void update(Category category, Uint32 key, Sint64 oldValue, Sint64 newValue) noexcept {
+        hashes[category] += contribution(category, key, newValue) - contribution(category, key, oldValue);
+    }
+
+    /**
+        Adds a value to the hash.
+        \param  category    the category of the value
+        \param  key         the key of the value inside the category
+        \param  value       the value to add
+    */
+    void add(Category category, Uint32 key, Sint64 value) noexcept {
+        hashes[category] += contribution(category, key, value);
+    }
+
+    /**
+        Returns the hash of one category.
+        \param  category    the category
+        \return the hash of all values of this category
+    */
+    Uint64 getHash(Category category) const noexcept {
+        return hashes[category];
+    }
+
+    /**
+        Returns the hash of all categories.
+        \return the hash
+    */
+    Uint64 getHash() const noexcept {
+        Uint64 hash = 0;
+        for(const Uint64 categoryHash : hashes) {
+            hash = mix(hash ^ categoryHash);
+        }
+        return hash;
+    }
+
+    /**
+        Returns the name of a category (e.g. for logging).
+        \param  category    the category
+        \return the name
+    */
+    static const char* getCategoryName(Category category);
+
+private:
+    static Uint64 contribution(Category category, Uint32 key, Sint64 value) noexcept {
+        if(value == 0) {
+            return 0;
+        }
+
+        return mix(mix((static_cast<Uint64>(category) << 32) | key) ^ static_cast<Uint64>(value));
+    }
+
+    /**
+        The finalizer of SplitMix64. Every input bit affects every output bit.
+    */
+    static Uint64 mix(Uint64 x) noexcept {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    std::array<Uint64, NUM_CATEGORIES> hashes;      ///< the sum of all contributions per category
+};
+
+#endif // STATEHASH_H
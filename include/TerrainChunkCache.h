@@ -0,0 +1,98 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TERRAINCHUNKCACHE_H
+#define TERRAINCHUNKCACHE_H
+
+#include <misc/SDL2pp.h>
+
+#include <vector>
+
+// forward declarations
+class Map;
+class SpriteBatch;
+
+/**
+    The ground layer of the map (terrain and destroyed structure tiles) prerendered into textures of
+    Map::TERRAIN_CHUNK_SIZE x Map::TERRAIN_CHUNK_SIZE tiles for the current zoom level.
+
+    A chunk is rendered when it becomes visible the first time and rerendered only if its version in the map
+    changed (see Map::getTerrainChunkVersion()). Chunks that have not been drawn for a while are released when more
+    than MAX_CACHED_PIXELS are cached. Changing the zoom level releases all chunks.
+*/
+class TerrainChunkCache {
+public:
+    TerrainChunkCache() = default;
+    ~TerrainChunkCache() = default;
+
+    TerrainChunkCache(const TerrainChunkCache &) = delete;
+    TerrainChunkCache(TerrainChunkCache &&) = delete;
+    TerrainChunkCache& operator=(const TerrainChunkCache &) = delete;
+    TerrainChunkCache& operator=(TerrainChunkCache &&) = delete;
+
+    /**
+        Draws the ground layer of all tiles in the rectangle [x1, x2) x [y1, y2) of the map to the screen. Chunks that
+        are outdated are rerendered before. The sprite batch is used to render the tiles into the chunks and to draw
+        the chunks; it is flushed before the render target is changed.
+        \param  map         the map to draw
+        \param  spriteBatch the sprite batch to draw with
+        \param  x1          the left most tile to draw
+        \param  y1          the top most tile to draw
+        \param  x2          one past the right most tile to draw
+        \param  y2          one past the bottom most tile to draw
+    */
+    void draw(const Map& map, SpriteBatch& spriteBatch, int x1, int y1, int x2, int y2);
+
+    /**
+        Releases all chunks.
+    */
+    void clear();
+
+    /**
+        Get the number of chunks rerendered since the last call to resetStatistics().
+        \return the number of rerendered chunks
+    */
+    int getNumRenderedChunks() const noexcept { return numRenderedChunks; }
+
+    /**
+        Resets the number of rerendered chunks.
+    */
+    void resetStatistics() noexcept { numRenderedChunks = 0; }
+
+private:
+    struct Chunk {
+        sdl2::texture_ptr   pTexture;           ///< the prerendered ground or nullptr if not rendered yet
+        Uint32              version = 0;        ///< the map version of this chunk when it was rendered
+        Uint32              lastDrawn = 0;      ///< the frame this chunk was drawn the last time
+    };
+
+    void renderChunk(const Map& map, SpriteBatch& spriteBatch, Chunk& chunk, int chunkX, int chunkY);
+    void releaseUnusedChunks();
+
+    static const int MAX_CACHED_PIXELS = 16*1024*1024;  ///< the number of pixels to keep cached (64 MiB of ARGB8888)
+
+    std::vector<Chunk>  chunks;                 ///< all chunks of the map row by row
+    int     numChunksX = 0;                     ///< the number of chunks per row
+    int     numChunksY = 0;                     ///< the number of chunks per column
+    int     zoomlevel = -1;                     ///< the zoom level the chunks are rendered for
+    int     numCachedPixels = 0;                ///< the number of pixels of all rendered chunks
+    Uint32  frame = 0;                          ///< the number of calls to draw()
+    int     numRenderedChunks = 0;              ///< the number of rerendered chunks since resetStatistics()
+};
+
+#endif // TERRAINCHUNKCACHE_H
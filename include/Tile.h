@@ -25,6 +25,7 @@
 #include <misc/InputStream.h>
 #include <misc/OutputStream.h>
 #include <fixmath/FixPoint.h>
+#include <misc/SmallVector.h>
 
 #include <list>
 #include <vector>
@@ -98,6 +99,9 @@ class Tile
 {
 public:
 
+    typedef SmallVector<Uint32, NUM_INFANTRY_PER_TILE> InfantryList;   ///< the ids of the infantry units on a tile (never more than NUM_INFANTRY_PER_TILE)
+    typedef SmallVector<Uint32, 2> ObjectList;                          ///< the ids of the other objects on a tile (rarely more than one)
+
     typedef enum {
         Terrain_RockDamage,
         Terrain_SandDamage
@@ -227,23 +231,22 @@ public:
     void save(OutputStream& stream) const;
 
     void assignAirUnit(Uint32 newObjectID);
-    void assignDeadUnit(Uint8 type, Uint8 house, const Coord& position) {
-        DEADUNITTYPE newDeadUnit;
-        newDeadUnit.type = type;
-        newDeadUnit.house = house;
-        newDeadUnit.onSand = isSand() || isDunes();
-        newDeadUnit.realPos = position;
-        newDeadUnit.timer = 2000;
-
-        deadUnits.push_back(newDeadUnit);
-    }
+    void assignDeadUnit(Uint8 type, Uint8 house, const Coord& position);
 
     void assignNonInfantryGroundObject(Uint32 newObjectID);
     int assignInfantry(Uint32 newObjectID, Sint8 currentPosition = INVALID_POS);
     void assignUndergroundUnit(Uint32 newObjectID);
 
     /**
-        This method draws the terrain of this tile
+        This method draws the terrain and the destroyed structure tile of this tile. These only change with
+        Map::onTileAppearanceChanged() and are prerendered into the terrain chunks (see TerrainChunkCache).
+        \param xPos the x position of the left top corner of this tile on the render target
+        \param yPos the y position of the left top corner of this tile on the render target
+    */
+    void blitTerrain(int xPos, int yPos) const;
+
+    /**
+        This method draws the tracks and damage on the ground of this tile. The terrain itself is drawn by blitTerrain().
         \param xPos the x position of the left top corner of this tile on the screen
         \param yPos the y position of the left top corner of this tile on the screen
     */
@@ -306,6 +309,13 @@ public:
         update_impl();
     }
 
+    /**
+        Has this tile any state that changes over time and needs update() to be called every game cycle?
+        Such tiles are registered with Map::activateTile().
+        \return true if update() has something to do, false otherwise
+    */
+    bool needsUpdate() const noexcept { return !deadUnits.empty(); }
+
     void clearTerrain();
 
     void setTrack(Uint8 direction);
@@ -323,6 +333,12 @@ public:
     FixPoint harvestSpice();
     void setSpice(FixPoint newSpice);
 
+    /**
+        Adds the spice of this tile to the state hash of the game. load() cannot do this as the location is not known
+        at that time, so Map::load() calls this for every tile afterwards.
+    */
+    void addSpiceToStateHash() const;
+
     /**
         Returns the center point of this tile
         \return the center point in world coordinates
@@ -364,19 +380,19 @@ public:
     ObjectBase* getObjectWithID(Uint32 objectID) const;
 
 
-    const std::list<Uint32>& getAirUnitList() const {
+    const ObjectList& getAirUnitList() const {
         return assignedAirUnitList;
     }
 
-    const std::list<Uint32>& getInfantryList() const {
+    const InfantryList& getInfantryList() const {
         return assignedInfantryList;
     }
 
-    const std::list<Uint32>& getUndergroundUnitList() const {
+    const ObjectList& getUndergroundUnitList() const {
         return assignedUndergroundUnitList;
     }
 
-    const std::list<Uint32>& getNonInfantryGroundObjectList() const {
+    const ObjectList& getNonInfantryGroundObjectList() const {
         return assignedNonInfantryGroundObjectList;
     }
 
@@ -397,14 +413,17 @@ public:
         \param  houseID the house this tile should be explored for
         \param  cycle   the cycle this happens (normally the current game cycle)
     */
-    void setExplored(int houseID, Uint32 cycle) {
-        lastAccess[houseID] = cycle;
-        explored[houseID] = true;
-    }
+    void setExplored(int houseID, Uint32 cycle);
+
+    /**
+        Returns the game cycle this tile gets fogged for every house that explored it, unless it is seen again.
+        \return the game cycle or 0 if not explored by any house
+    */
+    Uint32 getFoggingCycle() const noexcept;
 
-    void setOwner(int newOwner) noexcept { owner = newOwner; }
+    void setOwner(int newOwner);
     void setSandRegion(Uint32 newSandRegion) noexcept { sandRegion = newSandRegion; }
-    void setDestroyedStructureTile(int newDestroyedStructureTile) noexcept { destroyedStructureTile = newDestroyedStructureTile; };
+    void setDestroyedStructureTile(int newDestroyedStructureTile);
 
     bool hasAGroundObject() const noexcept { return (hasInfantry() || hasANonInfantryGroundObject()); }
     bool hasAnAirUnit() const noexcept { return !assignedAirUnitList.empty(); }
@@ -466,6 +485,17 @@ public:
     Coord   location;   ///< location of this tile in map coordinates
 
 private:
+    /**
+        Sets the spice on this tile and updates the state hash of the game.
+        \param newSpice    the new amount of spice
+    */
+    void changeSpice(FixPoint newSpice);
+
+    /**
+        Returns the key of this tile in the Category_TileSpice of the state hash.
+        \return the key
+    */
+    Uint32 getStateHashKey() const noexcept { return (location.x << 16) | location.y; }
 
     Uint32      type;           ///< the type of the tile (Terrain_Sand, Terrain_Rock, ...)
 
@@ -483,15 +513,16 @@ private:
     std::vector<DAMAGETYPE>         damage;                         ///< damage positions
     std::vector<DEADUNITTYPE>       deadUnits;                      ///< dead units
 
-    std::list<Uint32>   assignedAirUnitList;                      ///< all the air units on this tile
-    std::list<Uint32>   assignedInfantryList;                     ///< all infantry units on this tile
-    std::list<Uint32>   assignedUndergroundUnitList;              ///< all underground units on this tile
-    std::list<Uint32>   assignedNonInfantryGroundObjectList;      ///< all structures/vehicles on this tile
+    ObjectList      assignedAirUnitList;                      ///< all the air units on this tile
+    InfantryList    assignedInfantryList;                     ///< all infantry units on this tile
+    ObjectList      assignedUndergroundUnitList;              ///< all underground units on this tile
+    ObjectList      assignedNonInfantryGroundObjectList;      ///< all structures/vehicles on this tile
 
     Uint32      lastAccess[NUM_TEAMS];    ///< contains for every team when this tile was seen last by this house
     bool        explored[NUM_TEAMS];      ///< contains for every team if this tile is explored
 
     void update_impl();
+    void updateOccupied();
 
     template<typename Pred>
     void selectFilter(int houseID, ObjectBase** lastCheckedObject, ObjectBase** lastSelectedObject, Pred&& predicate);
@@ -0,0 +1,228 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TILEATTRIBUTES_H
+#define TILEATTRIBUTES_H
+
+#include <DataTypes.h>
+#include <data.h>
+#include <fixmath/FixPoint.h>
+
+#include <array>
+#include <vector>
+
+// forward declarations
+class Map;
+class Tile;
+
+/**
+    The attributes of all tiles that are read by the hot loops of the simulation (passability checks, path planning),
+    stored as packed arrays next to Map::tiles (structure of arrays). Reading a byte from these arrays avoids touching
+    the large Tile objects and resolving the objects on them.
+
+    The arrays mirror the Tile they are derived from and are kept up to date by the Tile mutators: the terrain type by
+    Tile::setType() and Tile::setSpice(), the owner by Tile::setOwner() and the occupancy by the assign/unassign
+    methods (see Tile::updateOccupied()). After loading a savegame rebuild() must be called once all objects are loaded.
+
+    For every movement class there is a cost grid holding the cost of moving onto each tile in units of
+    TERRAINCOST_ONE (0 means the terrain is impassable). The grids follow the terrain type and are read directly by
+    AStarSearch; units on a tile are not part of the grids but are checked through the occupancy flags.
+*/
+class TileAttributes {
+public:
+    /// The ways of moving over the map. Tracked and wheeled vehicles may pass the same terrain but differ in speed.
+    enum MovementClass {
+        Movement_Tracked,
+        Movement_Wheeled,
+        Movement_Infantry,
+        Movement_Sandworm,
+        Movement_Air,
+        NUM_MOVEMENTCLASSES
+    };
+
+    /// Flags describing the objects on a tile
+    enum OccupancyFlags {
+        Occupied_Infantry           = 0x01,     ///< there is at least one infantry unit
+        Occupied_InfantryFull       = 0x02,     ///< there are NUM_INFANTRY_PER_TILE infantry units
+        Occupied_NonInfantryGround  = 0x04,     ///< there is a structure or ground vehicle
+        Occupied_Structure          = 0x08,     ///< the (first) non infantry ground object is a structure
+        Occupied_AirUnit            = 0x10,     ///< there is at least one air unit
+        Occupied_UndergroundUnit    = 0x20      ///< there is at least one underground unit (sandworm)
+    };
+
+    /// The terrain cost of moving with normal speed (a terrain difficulty of 1.0)
+    static constexpr Uint8 TERRAINCOST_ONE = 64;
+
+    TileAttributes(int sizeX, int sizeY);
+    ~TileAttributes();
+
+    TileAttributes(const TileAttributes &) = delete;
+    TileAttributes(TileAttributes &&) = delete;
+    TileAttributes& operator=(const TileAttributes &) = delete;
+    TileAttributes& operator=(TileAttributes &&) = delete;
+
+    /**
+        Changes the size of the map. All tiles are sand without owner and objects.
+        \param  sizeX   the width of the map
+        \param  sizeY   the height of the map
+    */
+    void reset(int sizeX, int sizeY);
+
+    /**
+        Derives the attributes of all tiles of map from the tiles. The objects on the tiles must be loaded already.
+        \param  map the map
+    */
+    void rebuild(const Map& map);
+
+    /**
+        Updates the terrain type of a tile and its passability.
+        \param  x       the x coordinate of the tile
+        \param  y       the y coordinate of the tile
+        \param  type    the new terrain type
+    */
+    void setType(int x, int y, int type) {
+        const int index = getIndex(x, y);
+        if(types[index] != type) {
+            terrainVersion++;
+        }
+        types[index] = static_cast<Uint8>(type);
+        for(int movementClass = 0; movementClass < NUM_MOVEMENTCLASSES; movementClass++) {
+            movementCosts[movementClass][index] = getMovementCost(static_cast<MovementClass>(movementClass), type);
+        }
+    }
+
+    /**
+        Updates the owner of a tile.
+        \param  x       the x coordinate of the tile
+        \param  y       the y coordinate of the tile
+        \param  owner   the house id of the new owner or INVALID
+    */
+    void setOwner(int x, int y, int owner) {
+        owners[getIndex(x, y)] = static_cast<Sint8>(owner);
+    }
+
+    /**
+        Updates the occupancy flags of a tile from its objects.
+        \param  tile    the tile that changed
+    */
+    void updateOccupancy(const Tile& tile);
+
+    /**
+        Returns the version of the static terrain. It changes every time the terrain type of a tile changes or a structure
+        is placed on or removed from a tile, so that data derived from the terrain (e.g. flow fields) can be recomputed.
+        \return the terrain version
+    */
+    Uint32 getTerrainVersion() const noexcept { return terrainVersion; }
+
+    int getType(int x, int y) const noexcept { return types[getIndex(x, y)]; }
+    int getOwner(int x, int y) const noexcept { return owners[getIndex(x, y)]; }
+    Uint8 getOccupancy(int x, int y) const noexcept { return occupancy[getIndex(x, y)]; }
+
+    /**
+        Can a unit of movementClass move over the terrain of this tile? Objects on the tile are not considered.
+        \param  x               the x coordinate of the tile
+        \param  y               the y coordinate of the tile
+        \param  movementClass   the movement class of the unit
+        \return true if the terrain is passable
+    */
+    bool isPassable(int x, int y, MovementClass movementClass) const noexcept {
+        return movementCosts[movementClass][getIndex(x, y)] != 0;
+    }
+
+    /**
+        Returns the cost grid of a movement class. The grid is indexed by y*sizeX+x and holds the cost of moving onto
+        each tile in units of TERRAINCOST_ONE or 0 if the terrain is impassable.
+        \param  movementClass   the movement class
+        \return the cost grid (sizeX*sizeY entries)
+    */
+    const Uint8* getMovementCosts(MovementClass movementClass) const noexcept { return movementCosts[movementClass].data(); }
+
+    /**
+        Might the objects on this tile block a unit of movementClass? If not the tile is passable exactly when its
+        terrain is; otherwise the unit has to decide (see UnitBase::canPass()).
+        \param  x               the x coordinate of the tile
+        \param  y               the y coordinate of the tile
+        \param  movementClass   the movement class of the unit
+        \return true if the tile is occupied by objects that might block the unit
+    */
+    bool mightBeBlocked(int x, int y, MovementClass movementClass) const noexcept {
+        return (occupancy[getIndex(x, y)] & getBlockingOccupancy(movementClass)) != 0;
+    }
+
+    bool isMountain(int x, int y) const noexcept { return getType(x, y) == Terrain_Mountain; }
+    bool hasAGroundObject(int x, int y) const noexcept { return (occupancy[getIndex(x, y)] & (Occupied_Infantry | Occupied_NonInfantryGround)) != 0; }
+    bool hasInfantry(int x, int y) const noexcept { return (occupancy[getIndex(x, y)] & Occupied_Infantry) != 0; }
+    bool infantryNotFull(int x, int y) const noexcept { return (occupancy[getIndex(x, y)] & Occupied_InfantryFull) == 0; }
+    bool hasANonInfantryGroundObject(int x, int y) const noexcept { return (occupancy[getIndex(x, y)] & Occupied_NonInfantryGround) != 0; }
+    bool hasAStructure(int x, int y) const noexcept { return (occupancy[getIndex(x, y)] & Occupied_Structure) != 0; }
+    bool hasAnAirUnit(int x, int y) const noexcept { return (occupancy[getIndex(x, y)] & Occupied_AirUnit) != 0; }
+    bool hasAnUndergroundUnit(int x, int y) const noexcept { return (occupancy[getIndex(x, y)] & Occupied_UndergroundUnit) != 0; }
+
+    /**
+        Returns how fast a unit of movementClass can move over a terrain type, regardless of whether it may enter it.
+        \param  movementClass   the movement class of the unit
+        \param  type            the terrain type
+        \return the speed factor in units of TERRAINCOST_ONE. Higher values mean slower.
+    */
+    static Uint8 getTerrainCost(MovementClass movementClass, int type);
+
+    /**
+        Returns the cost of moving onto a tile of a terrain type.
+        \param  movementClass   the movement class of the unit
+        \param  type            the terrain type
+        \return the terrain cost or 0 if a unit of movementClass cannot pass this terrain
+    */
+    static Uint8 getMovementCost(MovementClass movementClass, int type);
+
+    /**
+        Converts a terrain cost into the speed factor used by the units and the path search.
+        \param  cost    the terrain cost in units of TERRAINCOST_ONE
+        \return the speed factor (1.0 for TERRAINCOST_ONE)
+    */
+    static FixPoint toTerrainDifficulty(Uint8 cost) noexcept {
+        static_assert(TERRAINCOST_ONE == (1 << 6), "terrain costs are converted by a shift");
+        return FixPoint(static_cast<int>(cost)) >> 6;
+    }
+
+    /**
+        Returns the occupancy flags of the objects that might block a unit of movementClass.
+        \param  movementClass   the movement class of the unit
+        \return the mask of OccupancyFlags
+    */
+    static Uint8 getBlockingOccupancy(MovementClass movementClass) noexcept {
+        switch(movementClass) {
+            case Movement_Sandworm: return Occupied_UndergroundUnit;
+            case Movement_Air:      return Occupied_AirUnit;
+            default:                return Occupied_Infantry | Occupied_NonInfantryGround;
+        }
+    }
+
+private:
+    inline int getIndex(int x, int y) const noexcept { return y * sizeX + x; }
+
+    int sizeX;                      ///< the width of the map
+    int sizeY;                      ///< the height of the map
+
+    std::vector<Uint8> types;       ///< the terrain type of every tile
+    std::array<std::vector<Uint8>, NUM_MOVEMENTCLASSES> movementCosts;  ///< the cost grid of every movement class
+    std::vector<Sint8> owners;      ///< the owner of every tile
+    std::vector<Uint8> occupancy;   ///< the occupancy flags of every tile (see OccupancyFlags)
+    Uint32 terrainVersion = 0;      ///< incremented on every change of a terrain type or a structure (see getTerrainVersion())
+};
+
+#endif // TILEATTRIBUTES_H
@@ -0,0 +1,160 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VISIBILITYBITMAPS_H
+#define VISIBILITYBITMAPS_H
+
+#include <DataTypes.h>
+
+#include <array>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+    Packed bitmaps of the explored tiles of every house and of all tiles occupied by an object. Each map row is stored as
+    a sequence of 64 bit words so that a rectangular range of tiles can be tested 64 tiles at a time.
+
+    The bitmaps mirror Tile::isExploredByHouse() and Tile::hasAnObject() and are kept up to date by Tile::setExplored() and
+    the assign/unassign methods of Tile. Fog is not part of the bitmaps as it depends on the current game cycle; it is only
+    checked for the tiles that pass the bitmap test.
+*/
+class VisibilityBitmaps {
+public:
+    VisibilityBitmaps(int sizeX, int sizeY);
+    ~VisibilityBitmaps();
+
+    VisibilityBitmaps(const VisibilityBitmaps &) = delete;
+    VisibilityBitmaps(VisibilityBitmaps &&) = delete;
+    VisibilityBitmaps& operator=(const VisibilityBitmaps &) = delete;
+    VisibilityBitmaps& operator=(VisibilityBitmaps &&) = delete;
+
+    /**
+        Clears all bitmaps and changes the size of the map.
+        \param  sizeX   the width of the map
+        \param  sizeY   the height of the map
+    */
+    void reset(int sizeX, int sizeY);
+
+    /**
+        Marks a tile as explored by a house.
+        \param  houseID the house that explored the tile
+        \param  x       the x coordinate of the tile
+        \param  y       the y coordinate of the tile
+    */
+    inline void setExplored(int houseID, int x, int y) {
+        explored[houseID][getWordIndex(x, y)] |= getBitMask(x);
+    }
+
+    /**
+        Sets if there is any object on a tile.
+        \param  x           the x coordinate of the tile
+        \param  y           the y coordinate of the tile
+        \param  bOccupied   is there at least one object on this tile?
+    */
+    inline void setOccupied(int x, int y, bool bOccupied) {
+        if(bOccupied) {
+            occupied[getWordIndex(x, y)] |= getBitMask(x);
+        } else {
+            occupied[getWordIndex(x, y)] &= ~getBitMask(x);
+        }
+    }
+
+    /**
+        Visits all occupied tiles in the rectangle (x1,y1)-(x2,y2) that are explored by at least one house of houseMask.
+        The tiles are visited row by row from top to bottom and from left to right inside a row.
+        \param  houseMask   bit i is set if house i shall be considered
+        \param  x1          the left edge of the rectangle (must be on the map)
+        \param  y1          the top edge of the rectangle (must be on the map)
+        \param  x2          the right edge of the rectangle (inclusive, must be on the map)
+        \param  y2          the bottom edge of the rectangle (inclusive, must be on the map)
+        \param  visitor     called with the x and y coordinate of every matching tile
+    */
+    template<typename Visitor>
+    void visitExploredOccupiedTiles(Uint32 houseMask, int x1, int y1, int x2, int y2, Visitor&& visitor) const {
+        if((x1 > x2) || (y1 > y2)) {
+            return;
+        }
+
+        const int firstWord = x1 / BITS_PER_WORD;
+        const int lastWord = x2 / BITS_PER_WORD;
+
+        for(int y = y1; y <= y2; y++) {
+            const int rowIndex = y * wordsPerRow;
+
+            for(int word = firstWord; word <= lastWord; word++) {
+                Uint64 bits = occupied[rowIndex + word];
+                if(bits == 0) {
+                    continue;
+                }
+
+                Uint64 exploredBits = 0;
+                for(int houseID = 0; houseID < NUM_HOUSES; houseID++) {
+                    if(houseMask & (1u << houseID)) {
+                        exploredBits |= explored[houseID][rowIndex + word];
+                    }
+                }
+                bits &= exploredBits;
+
+                // cut off the tiles left of x1 and right of x2
+                if(word == firstWord) {
+                    bits &= ~Uint64(0) << (x1 % BITS_PER_WORD);
+                }
+                if(word == lastWord) {
+                    bits &= ~Uint64(0) >> (BITS_PER_WORD - 1 - (x2 % BITS_PER_WORD));
+                }
+
+                while(bits != 0) {
+                    visitor(word * BITS_PER_WORD + countTrailingZeros(bits), y);
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+
+private:
+    static const int BITS_PER_WORD = 64;
+
+    inline int getWordIndex(int x, int y) const { return y * wordsPerRow + x / BITS_PER_WORD; }
+    static inline Uint64 getBitMask(int x) { return Uint64(1) << (x % BITS_PER_WORD); }
+
+    static inline int countTrailingZeros(Uint64 bits) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(bits);
+#elif defined(_MSC_VER) && defined(_WIN64)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<int>(index);
+#else
+        int index = 0;
+        while((bits & 1) == 0) {
+            bits >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+
+    int     wordsPerRow;                                        ///< number of words per map row
+
+    std::array<std::vector<Uint64>, NUM_HOUSES> explored;       ///< the explored tiles of each house
+    std::vector<Uint64>                         occupied;       ///< the tiles with at least one object
+};
+
+#endif // VISIBILITYBITMAPS_H
@@ -37,3 +37,11 @@
 #ifndef LOGFILENAME
     #define LOGFILENAME "Dune Legacy.log"
 #endif
+
+#ifndef PAKMANIFESTFILENAME
+    #define PAKMANIFESTFILENAME "PakManifest.txt"
+#endif
+
+#ifndef OBJPICCACHEFILENAME
+    #define OBJPICCACHEFILENAME "ObjPics.cache"
+#endif
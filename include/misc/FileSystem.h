@@ -59,7 +59,7 @@ std::list<std::string> getFileNamesList(const std::string& directory, const std:
 
 /**
     This function finds all the files in the specified directory with the specified
-    extension.
+    extension. An empty extension matches all files (but no directories).
     \param  directory   the directory name
     \param  extension   the extension to search for
     \param  IgnoreCase  true = extension comparison is case insensitive
@@ -84,6 +84,25 @@ bool getCaseInsensitiveFilename(std::string& filepath);
 */
 bool existsFile(const std::string& path);
 
+/**
+    This function determines the size and the time of the last modification of a file
+    \param filepath    path to the file
+    \param size        is set to the size of the file in bytes
+    \param modifydate  is set to the time of the last modification
+    \return true on success, false if the file does not exist or cannot be accessed
+*/
+bool getFileSizeAndModifyDate(const std::string& filepath, uint64_t& size, uint64_t& modifydate);
+
+
+/**
+    Renames the file srcPath to destPath. An existing file destPath is replaced atomically, i.e. destPath is either
+    the old or the new file but never missing or incomplete.
+    \param srcPath     path to the file to rename
+    \param destPath    the new path of the file
+    \return true on success, false otherwise
+*/
+bool replaceFile(const std::string& srcPath, const std::string& destPath);
+
 
 /**
     Reads a complete file into a string. Caution: If the file contains 0-bytes they will also be contained in the returned string
@@ -19,7 +19,9 @@
 #define IFILESTREAM_H
 
 #include "InputStream.h"
+#include <stdio.h>
 #include <stdlib.h>
+#include <memory>
 #include <string>
 
 class IFileStream : public InputStream
@@ -32,17 +34,15 @@ public:
     bool open(const std::string& filename);
     void close();
 
-    std::string readString() override;
-
-    Uint8 readUint8() override;
-    Uint16 readUint16() override;
-    Uint32 readUint32() override;
-    Uint64 readUint64() override;
-    bool readBool() override;
-    float readFloat() override;
+protected:
+    void underflow(char* pData, size_t length) override;
+    bool isCompletelyBuffered() const override { return false; }
 
 private:
+    static constexpr size_t BUFFER_SIZE = 64*1024;     ///< the size of the chunks read from the file
+
     FILE* fp;
+    std::unique_ptr<char[]> pBuffer;                    ///< the current chunk of the file
 };
 
 #endif // IFILESTREAM_H
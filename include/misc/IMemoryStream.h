@@ -29,98 +29,21 @@
 class IMemoryStream : public InputStream
 {
 public:
-    IMemoryStream()
-     : currentPos(0), bufferSize(0), pBuffer(nullptr) {
+    IMemoryStream() {
         ;
     }
 
-    IMemoryStream(const char* data, int length)
-     : currentPos(0), bufferSize(length), pBuffer(data) {
-        ;
+    IMemoryStream(const char* data, int length) {
+        open(data, length);
     }
 
     ~IMemoryStream() = default;
 
     void open(const char* data, int length) {
-        currentPos = 0;
-        bufferSize = length;
-        pBuffer = data;
-    }
-
-    std::string readString() override
-    {
-        Uint32 length = readUint32();
-
-        if(currentPos + length > bufferSize) {
-            THROW(InputStream::eof, "IMemoryStream::readString(): End-of-File reached!");
-        }
-
-        std::string resultString(pBuffer + currentPos, length);
-        currentPos += length;
-        return resultString;
-    }
-
-    Uint8 readUint8() override
-    {
-        if(currentPos + sizeof(Uint8) > bufferSize) {
-            THROW(InputStream::eof, "IMemoryStream::readUint8(): End-of-File reached!");
-        }
-
-        Uint8 tmp = *((const Uint8*) (pBuffer + currentPos));
-        currentPos += sizeof(Uint8);
-        return tmp;
-    }
-
-    Uint16 readUint16() override
-    {
-        if(currentPos + sizeof(Uint16) > bufferSize) {
-            THROW(InputStream::eof, "IMemoryStream::readUint16(): End-of-File reached!");
-        }
-
-        Uint16 tmp = *((const Uint16*) (pBuffer + currentPos));
-        currentPos += sizeof(Uint16);
-        return SDL_SwapLE16(tmp);
+        // the whole data is the buffer; reading past its end is an End-of-File (see InputStream::underflow())
+        pReadPos = data;
+        pReadEnd = data + length;
     }
-
-    Uint32 readUint32() override
-    {
-        if(currentPos + sizeof(Uint32) > bufferSize) {
-            THROW(InputStream::eof, "IMemoryStream::readUint32(): End-of-File reached!");
-        }
-
-        Uint32 tmp = *((const Uint32*) (pBuffer + currentPos));
-        currentPos += sizeof(Uint32);
-        return SDL_SwapLE32(tmp);
-    }
-
-    Uint64 readUint64() override
-    {
-        if(currentPos + sizeof(Uint64) > bufferSize) {
-            THROW(InputStream::eof, "IMemoryStream::readUint64(): End-of-File reached!");
-        }
-
-        Uint64 tmp = *((const Uint64*) (pBuffer + currentPos));
-        currentPos += sizeof(Uint64);
-        return SDL_SwapLE64(tmp);
-    }
-
-    bool readBool() override
-    {
-        return (readUint8() == 1 ? true : false);
-    }
-
-    float readFloat() override
-    {
-        Uint32 tmp = readUint32();
-        float tmp2;
-        memcpy(&tmp2,&tmp,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
-        return tmp2;
-    }
-
-private:
-    size_t      currentPos;
-    size_t      bufferSize;
-    const char* pBuffer;
 };
 
 #endif // IMEMORYSTREAM_H
@@ -20,31 +20,86 @@
 
 #include <fixmath/FixPoint.h>
 #include <misc/SDL2pp.h>
+#include <misc/exceptions.h>
 
+#include <SDL2/SDL_endian.h>
+
+#include <string.h>
+#include <algorithm>
 #include <string>
 #include <list>
 #include <vector>
 #include <set>
 #include <exception>
 
+/// The base class of all binary input streams.
+/**
+    The data is read from a contiguous buffer [pReadPos, pReadEnd) which the derived classes provide. All read methods
+    are inline and non-virtual and only access this buffer. The virtual underflow() is only called when the buffer runs
+    out of data, e.g. to read the next chunk of a file.
+*/
 class InputStream
 {
 public:
     InputStream() { ; };
     virtual ~InputStream() { ; };
 
+    /**
+        Reads length bytes into pData.
+        \param pData   the buffer to read into
+        \param length  the number of bytes to read
+    */
+    void readBytes(void* pData, size_t length) {
+        if(static_cast<size_t>(pReadEnd - pReadPos) >= length) {
+            if(length > 0) {
+                memcpy(pData, pReadPos, length);
+                pReadPos += length;
+            }
+        } else {
+            underflow(static_cast<char*>(pData), length);
+        }
+    }
+
     /**
         readString reads in a strings from the stream.
         \return the read string
     */
-    virtual std::string readString() = 0;
+    std::string readString() {
+        const Uint32 length = readUint32();
 
-    virtual Uint8 readUint8() = 0;
-    virtual Uint16 readUint16() = 0;
-    virtual Uint32 readUint32() = 0;
-    virtual Uint64 readUint64() = 0;
-    virtual bool readBool() = 0;
-    virtual float readFloat() = 0;
+        std::string str;
+        if(static_cast<size_t>(pReadEnd - pReadPos) >= length) {
+            str.assign(pReadPos, length);
+            pReadPos += length;
+        } else {
+            checkUnbufferedLength(length);
+
+            // the length might be corrupt, so the string only grows with the data actually read
+            while(str.size() < length) {
+                const size_t oldSize = str.size();
+                str.resize(oldSize + std::min(static_cast<size_t>(length) - oldSize, static_cast<size_t>(MAX_CHUNK_SIZE)));
+                readBytes(&str[oldSize], str.size() - oldSize);
+            }
+        }
+        return str;
+    }
+
+    Uint8 readUint8() { return readPrimitive<Uint8>(); }
+    Uint16 readUint16() { return SDL_SwapLE16(readPrimitive<Uint16>()); }
+    Uint32 readUint32() { return SDL_SwapLE32(readPrimitive<Uint32>()); }
+    Uint64 readUint64() { return SDL_SwapLE64(readPrimitive<Uint64>()); }
+
+    bool readBool() {
+        return (readUint8() == 1 ? true : false);
+    }
+
+    float readFloat() {
+        static_assert(sizeof(float) == sizeof(Uint32), "Cannot load floats on this system");
+        Uint32 tmp = readUint32();
+        float tmp2;
+        memcpy(&tmp2,&tmp,sizeof(Uint32));
+        return tmp2;
+    }
 
     /**
         Reads in a Sint8 value.
@@ -133,14 +188,39 @@ public:
         \return the read vector
     */
     std::vector<Uint32> readUint32Vector() {
+        const Uint32 size = readUint32();
+
         std::vector<Uint32> vec;
-        Uint32 size = readUint32();
-        for(unsigned int i=0; i < size; i++) {
-            vec.push_back(readUint32());
+        if(static_cast<size_t>(pReadEnd - pReadPos) / sizeof(Uint32) >= size) {
+            vec.resize(size);
+            readUint32Array(vec.data(), size);
+        } else {
+            checkUnbufferedLength(static_cast<size_t>(size) * sizeof(Uint32));
+
+            // the size might be corrupt, so the vector only grows with the data actually read
+            while(vec.size() < size) {
+                const size_t oldSize = vec.size();
+                vec.resize(oldSize + std::min(static_cast<size_t>(size) - oldSize, MAX_CHUNK_SIZE / sizeof(Uint32)));
+                readUint32Array(&vec[oldSize], vec.size() - oldSize);
+            }
         }
         return vec;
     }
 
+    /**
+        Reads numValues Uint32 values written by OutputStream::writeUint32Array() (without size).
+        \param pValues     the array to read into
+        \param numValues   the number of values to read
+    */
+    void readUint32Array(Uint32* pValues, size_t numValues) {
+        readBytes(pValues, numValues * sizeof(Uint32));
+#if SDL_BYTEORDER != SDL_LIL_ENDIAN
+        for(size_t i = 0; i < numValues; i++) {
+            pValues[i] = SDL_SwapLE32(pValues[i]);
+        }
+#endif
+    }
+
     /**
         Reads a set of Uint32 written by writeUint32Set().
         \return the read set
@@ -181,6 +261,59 @@ public:
     private:
         std::string str;
     };
+
+protected:
+    static constexpr size_t MAX_CHUNK_SIZE = 64*1024;  ///< the maximum memory allocated for a length prefixed value before its data is read
+
+    /**
+        Checks a length read from the stream before memory is allocated for it. For a completely buffered stream
+        (e.g. a network packet) InputStream::eof is thrown if the stream has less data left.
+        \param length  the number of bytes that will be read
+    */
+    void checkUnbufferedLength(size_t length) const {
+        if(isCompletelyBuffered() && (static_cast<size_t>(pReadEnd - pReadPos) < length)) {
+            THROW(InputStream::eof, "InputStream::checkUnbufferedLength(): End-of-File reached!");
+        }
+    }
+
+    /**
+        Reads a value of type T in the byte order of the stream.
+        \return the read value
+    */
+    template<typename T>
+    T readPrimitive() {
+        T x;
+        if(static_cast<size_t>(pReadEnd - pReadPos) >= sizeof(T)) {
+            memcpy(&x, pReadPos, sizeof(T));
+            pReadPos += sizeof(T);
+        } else {
+            underflow(reinterpret_cast<char*>(&x), sizeof(T));
+        }
+        return x;
+    }
+
+    /**
+        This method is called if less than length bytes are left in the buffer. It has to read length bytes into
+        pData, starting with the bytes left in the buffer, and may refill the buffer. If there is not enough data
+        left InputStream::eof is thrown.
+        \param pData   the buffer to read into
+        \param length  the number of bytes to read
+    */
+    virtual void underflow(char* /*pData*/, size_t /*length*/) {
+        THROW(InputStream::eof, "InputStream::underflow(): End-of-File reached!");
+    }
+
+    /**
+        Is all data of this stream in the buffer? Then underflow() can only throw InputStream::eof. This is the case for
+        streams that do not override underflow().
+        \return true if the stream has no data beyond pReadEnd
+    */
+    virtual bool isCompletelyBuffered() const {
+        return true;
+    }
+
+    const char* pReadPos = nullptr;         ///< the next byte to read
+    const char* pReadEnd = nullptr;         ///< the end of the buffered data
 };
 
 #endif // INPUTSTREAM_H
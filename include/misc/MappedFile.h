@@ -0,0 +1,67 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <misc/SDL2pp.h>
+
+#include <stddef.h>
+#include <string>
+
+/**
+    A read-only memory mapping of a complete file. The content is paged in by the operating system on first access and
+    shared with the page cache; nothing is copied when reading it.
+*/
+class MappedFile
+{
+public:
+    /**
+        Maps the file filename into memory. An io_error is thrown if the file cannot be opened or mapped.
+        \param  filename    the file to map (utf-8 encoded)
+    */
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile &&) = delete;
+    MappedFile& operator=(const MappedFile &) = delete;
+    MappedFile& operator=(MappedFile &&) = delete;
+
+    /**
+        Get the content of the file. The pointer is valid as long as this object exists.
+        \return the mapped content (nullptr for an empty file)
+    */
+    const Uint8* getData() const noexcept { return pData; }
+
+    /**
+        Get the size of the file.
+        \return the size in bytes
+    */
+    size_t getSize() const noexcept { return size; }
+
+private:
+    const Uint8*    pData = nullptr;    ///< the mapped content
+    size_t          size = 0;           ///< the size of the mapped content in bytes
+
+#ifdef _WIN32
+    void*           hFile = nullptr;    ///< the handle of the opened file
+    void*           hMapping = nullptr; ///< the handle of the file mapping
+#endif
+};
+
+#endif // MAPPEDFILE_H
@@ -19,7 +19,9 @@
 #define OFILESTREAM_H
 
 #include "OutputStream.h"
+#include <stdio.h>
 #include <stdlib.h>
+#include <memory>
 #include <string>
 
 class OFileStream : public OutputStream
@@ -34,19 +36,19 @@ public:
 
     void flush() override;
 
-    // write operations
+protected:
+    void overflow(const char* pData, size_t length) override;
 
-    void writeString(const std::string& str) override;
+private:
+    /**
+        Writes out the buffered data.
+    */
+    void writeBuffer();
 
-    void writeUint8(Uint8 x) override;
-    void writeUint16(Uint16 x) override;
-    void writeUint32(Uint32 x) override;
-    void writeUint64(Uint64 x) override;
-    void writeBool(bool x) override;
-    void writeFloat(float x) override;
+    static constexpr size_t BUFFER_SIZE = 64*1024;     ///< the size of the chunks written to the file
 
-private:
     FILE* fp;
+    std::unique_ptr<char[]> pBuffer;                    ///< the data not yet written to the file
 };
 
 #endif // OFILESTREAM_H
@@ -19,6 +19,9 @@
 #define OMEMORYSTREAM_H
 
 #include "OutputStream.h"
+
+#include <misc/exceptions.h>
+
 #include <stdlib.h>
 #include <string>
 
@@ -26,7 +29,7 @@ class OMemoryStream : public OutputStream
 {
 public:
     OMemoryStream()
-     : currentPos(0), bufferSize(0), pBuffer(nullptr) {
+     : bufferSize(0), pBuffer(nullptr) {
         ;
     }
 
@@ -34,15 +37,29 @@ public:
         free(pBuffer);
     }
 
-    void open() {
-        free(pBuffer);
+    /**
+        Opens the stream with an empty buffer.
+        \param initialBufferSize   the initial size of the buffer; a good guess avoids growing the buffer while writing
+    */
+    void open(size_t initialBufferSize = 4) {
+        if(initialBufferSize < 4) {
+            initialBufferSize = 4;
+        }
+
+        if((pBuffer == nullptr) || (bufferSize < initialBufferSize)) {
+            free(pBuffer);
 
-        currentPos = 0;
-        bufferSize = 4;
-        pBuffer = (char*) malloc(4);
-        if(pBuffer == nullptr) {
-            THROW(OMemoryStream::error, "OMemoryStream::open(): malloc failed!");
+            bufferSize = initialBufferSize;
+            pBuffer = (char*) malloc(initialBufferSize);
+            if(pBuffer == nullptr) {
+                bufferSize = 0;
+                THROW(OMemoryStream::error, "OMemoryStream::open(): malloc failed!");
+            }
         }
+
+        // an existing buffer is reused
+        pWritePos = pBuffer;
+        pWriteEnd = pBuffer + bufferSize;
     }
 
     const char* getData() const {
@@ -50,7 +67,7 @@ public:
     }
 
     size_t getDataLength() const {
-        return (bReadOnly == true) ? bufferSize : currentPos;
+        return pWritePos - pBuffer;
     }
 
     void flush() override
@@ -58,65 +75,6 @@ public:
         ;
     }
 
-    void writeString(const std::string& str) override
-    {
-        ensureBufferSize(currentPos + str.length() + sizeof(Uint32));
-
-        writeUint32(str.length());
-
-        if(!str.empty()) {
-            memcpy(pBuffer + currentPos, str.c_str(), str.length());
-            currentPos += str.length();
-        }
-    }
-
-
-    void writeUint8(Uint8 x) override
-    {
-        ensureBufferSize(currentPos + sizeof(Uint8));
-        *((Uint8*) (pBuffer + currentPos)) = x;
-        currentPos += sizeof(Uint8);
-    }
-
-    void writeUint16(Uint16 x) override
-    {
-        ensureBufferSize(currentPos + sizeof(Uint16));
-        x = SDL_SwapLE16(x);
-        *((Uint16*) (pBuffer + currentPos)) = x;
-        currentPos += sizeof(Uint16);
-    }
-
-    void writeUint32(Uint32 x) override
-    {
-        ensureBufferSize(currentPos + sizeof(Uint32));
-        x = SDL_SwapLE32(x);
-        *((Uint32*) (pBuffer + currentPos)) = x;
-        currentPos += sizeof(Uint32);
-    }
-
-    void writeUint64(Uint64 x) override
-    {
-        ensureBufferSize(currentPos + sizeof(Uint64));
-        x = SDL_SwapLE64(x);
-        *((Uint64*) (pBuffer + currentPos)) = x;
-        currentPos += sizeof(Uint64);
-    }
-
-    void writeBool(bool x) override
-    {
-        writeUint8(x == true ? 1 : 0);
-    }
-
-    void writeFloat(float x) override
-    {
-        if(sizeof(float) != sizeof(Uint32)) {
-            THROW(OMemoryStream::error, "OMemoryStream::writeFloat(): sizeof(float) != sizeof(Uint32). Cannot save floats on such systems.");
-        }
-        Uint32 tmp;
-        memcpy(&tmp,&x,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
-        writeUint32(tmp);
-    }
-
     void ensureBufferSize(size_t minBufferSize) {
         if(minBufferSize < bufferSize) {
             return;
@@ -127,17 +85,28 @@ public:
             newBufferSize = minBufferSize;
         }
 
+        const size_t currentPos = getDataLength();
+
         char* pNewBuffer = (char*) realloc(pBuffer, newBufferSize);
         if(pNewBuffer == nullptr) {
             THROW(OMemoryStream::error, "OMemoryStream::ensureBufferSize(): realloc failed!");
         } else {
             pBuffer = pNewBuffer;
             bufferSize = newBufferSize;
+            pWritePos = pBuffer + currentPos;
+            pWriteEnd = pBuffer + bufferSize;
         }
     }
 
+protected:
+    void overflow(const char* pData, size_t length) override
+    {
+        ensureBufferSize(getDataLength() + length);
+        memcpy(pWritePos, pData, length);
+        pWritePos += length;
+    }
+
 private:
-    size_t  currentPos;
     size_t  bufferSize;
     char*   pBuffer;
 };
@@ -21,6 +21,9 @@
 #include <fixmath/FixPoint.h>
 #include <misc/SDL2pp.h>
 
+#include <SDL2/SDL_endian.h>
+
+#include <string.h>
 #include <string>
 #include <list>
 #include <utility>
@@ -28,6 +31,12 @@
 #include <set>
 #include <exception>
 
+/// The base class of all binary output streams.
+/**
+    The data is written into a contiguous buffer [pWritePos, pWriteEnd) which the derived classes provide. All write
+    methods are inline and non-virtual and only access this buffer. The virtual overflow() is only called when the
+    buffer is full, e.g. to write it out to a file or to grow it.
+*/
 class OutputStream
 {
 public:
@@ -40,14 +49,42 @@ public:
 
     // write operations
 
-    virtual void writeString(const std::string& str) = 0;
+    /**
+        Writes out length bytes from pData.
+        \param pData   the data to write
+        \param length  the number of bytes to write
+    */
+    void writeBytes(const void* pData, size_t length) {
+        if(static_cast<size_t>(pWriteEnd - pWritePos) >= length) {
+            if(length > 0) {
+                memcpy(pWritePos, pData, length);
+                pWritePos += length;
+            }
+        } else {
+            overflow(static_cast<const char*>(pData), length);
+        }
+    }
+
+    void writeString(const std::string& str) {
+        writeUint32(static_cast<Uint32>(str.length()));
+        writeBytes(str.data(), str.length());
+    }
+
+    void writeUint8(Uint8 x) { writePrimitive<Uint8>(x); }
+    void writeUint16(Uint16 x) { writePrimitive<Uint16>(SDL_SwapLE16(x)); }
+    void writeUint32(Uint32 x) { writePrimitive<Uint32>(SDL_SwapLE32(x)); }
+    void writeUint64(Uint64 x) { writePrimitive<Uint64>(SDL_SwapLE64(x)); }
 
-    virtual void writeUint8(Uint8 x) = 0;
-    virtual void writeUint16(Uint16 x) = 0;
-    virtual void writeUint32(Uint32 x) = 0;
-    virtual void writeUint64(Uint64 x) = 0;
-    virtual void writeBool(bool x) = 0;
-    virtual void writeFloat(float x) = 0;
+    void writeBool(bool x) {
+        writeUint8(x == true ? 1 : 0);
+    }
+
+    void writeFloat(float x) {
+        static_assert(sizeof(float) == sizeof(Uint32), "Cannot save floats on this system");
+        Uint32 tmp;
+        memcpy(&tmp,&x,sizeof(Uint32));
+        writeUint32(tmp);
+    }
 
     /**
         Writes out a Sint8 value.
@@ -127,9 +164,22 @@ public:
     */
     void writeUint32Vector(const std::vector<Uint32>& dataVector) {
         writeUint32(static_cast<Uint32>(dataVector.size()));
-        for(const Uint32 data : dataVector) {
-            writeUint32(data);
+        writeUint32Array(dataVector.data(), dataVector.size());
+    }
+
+    /**
+        Writes out an array of Uint32 (without its size).
+        \param  pValues     the values to write
+        \param  numValues   the number of values
+    */
+    void writeUint32Array(const Uint32* pValues, size_t numValues) {
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        writeBytes(pValues, numValues * sizeof(Uint32));
+#else
+        for(size_t i = 0; i < numValues; i++) {
+            writeUint32(pValues[i]);
         }
+#endif
     }
 
     /**
@@ -170,6 +220,32 @@ public:
     private:
         std::string str;
     };
+
+protected:
+    /**
+        Writes out a value of type T that is already in the byte order of the stream.
+        \param x    the value to write out
+    */
+    template<typename T>
+    void writePrimitive(T x) {
+        if(static_cast<size_t>(pWriteEnd - pWritePos) >= sizeof(T)) {
+            memcpy(pWritePos, &x, sizeof(T));
+            pWritePos += sizeof(T);
+        } else {
+            overflow(reinterpret_cast<const char*>(&x), sizeof(T));
+        }
+    }
+
+    /**
+        This method is called if there is not enough room for length bytes left in the buffer. It has to write out
+        the length bytes of pData after the data already in the buffer, e.g. by writing out or growing the buffer.
+        \param pData   the data to write
+        \param length  the number of bytes to write
+    */
+    virtual void overflow(const char* pData, size_t length) = 0;
+
+    char*   pWritePos = nullptr;            ///< the next byte to write
+    char*   pWriteEnd = nullptr;            ///< the end of the buffer
 };
 
 #endif // OUTPUTSTREAM_H
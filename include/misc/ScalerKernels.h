@@ -0,0 +1,62 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SCALERKERNELS_H
+#define SCALERKERNELS_H
+
+#include <SDL2/SDL_stdinc.h>
+
+/**
+    The per-row kernels of the Scale2x and Scale3x algorithms (see http://scale2x.sourceforge.net/algorithm.html ).
+    A kernel scales one row of width pixels and treats the first and last pixel of the row as the edge of the image
+    (the neighbours outside are clamped). prev and next are the rows above and below (clamped by the caller).
+
+    There is a scalar reference implementation and vectorized versions for SSE2 and AVX2. All versions produce exactly
+    the same output; getScale2xRowKernel() and getScale3xRowKernel() return the best one for the current CPU.
+*/
+namespace ScalerKernels {
+
+    typedef void Scale2xRowKernel(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1);
+    typedef void Scale3xRowKernel(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1, Uint8* dest2);
+
+    void scale2xRowScalar(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1);
+    void scale3xRowScalar(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1, Uint8* dest2);
+
+    /**
+        Get the SSE2 kernels.
+        \return the kernel or nullptr if not compiled in or not supported by the cpu
+    */
+    Scale2xRowKernel* getScale2xRowKernelSSE2();
+    Scale3xRowKernel* getScale3xRowKernelSSE2();
+
+    /**
+        Get the AVX2 kernels.
+        \return the kernel or nullptr if not compiled in or not supported by the cpu
+    */
+    Scale2xRowKernel* getScale2xRowKernelAVX2();
+    Scale3xRowKernel* getScale3xRowKernelAVX2();
+
+    /**
+        Get the fastest kernel for this cpu.
+        \return the kernel (never nullptr)
+    */
+    Scale2xRowKernel* getScale2xRowKernel();
+    Scale3xRowKernel* getScale3xRowKernel();
+}
+
+#endif // SCALERKERNELS_H
@@ -0,0 +1,195 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+/**
+    A vector that stores up to N elements inline and only allocates memory when it grows beyond N elements. It is
+    meant for short lists that are usually empty or hold a handful of elements, like the objects on a tile.
+
+    Only trivially copyable element types are supported. The elements keep their order (like std::list::push_back() and
+    std::list::remove()) but iterators are invalidated by every modification; iterate over a copy if the loop body may
+    modify the vector.
+
+    The heap capacity is not stored but derived from the number of elements (the next power of two, at least 2N), so
+    the pointer to the heap memory can share the space of the inline elements.
+*/
+template<typename T, unsigned int N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector only supports trivially copyable types");
+    static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+
+public:
+    typedef T           value_type;
+    typedef unsigned int size_type;
+    typedef T*          iterator;
+    typedef const T*    const_iterator;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(const SmallVector& o) {
+        assign(o.begin(), o.end());
+    }
+
+    SmallVector(SmallVector&& o) noexcept : numElements(o.numElements) {
+        std::memcpy(&storage, &o.storage, sizeof(storage));
+        o.numElements = 0;
+    }
+
+    ~SmallVector() {
+        if(isOnHeap()) {
+            delete[] storage.pHeap;
+        }
+    }
+
+    SmallVector& operator=(const SmallVector& o) {
+        if(this != &o) {
+            assign(o.begin(), o.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& o) noexcept {
+        if(this != &o) {
+            clear();
+            numElements = o.numElements;
+            std::memcpy(&storage, &o.storage, sizeof(storage));
+            o.numElements = 0;
+        }
+        return *this;
+    }
+
+    bool empty() const noexcept { return numElements == 0; }
+    size_type size() const noexcept { return numElements; }
+
+    T* data() noexcept { return isOnHeap() ? storage.pHeap : storage.inlineElements; }
+    const T* data() const noexcept { return isOnHeap() ? storage.pHeap : storage.inlineElements; }
+
+    iterator begin() noexcept { return data(); }
+    iterator end() noexcept { return data() + numElements; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return data() + numElements; }
+
+    T& front() { return data()[0]; }
+    const T& front() const { return data()[0]; }
+    T& back() { return data()[numElements - 1]; }
+    const T& back() const { return data()[numElements - 1]; }
+
+    T& operator[](size_type i) { return data()[i]; }
+    const T& operator[](size_type i) const { return data()[i]; }
+
+    /**
+        Appends an element.
+        \param  value   the element to append
+    */
+    void push_back(const T& value) {
+        const T copy = value;   // value might be an element of this vector
+
+        if(numElements < N) {
+            storage.inlineElements[numElements++] = copy;
+            return;
+        }
+
+        if(numElements == N) {
+            // move the inline elements to the heap
+            T* pHeap = new T[getCapacity(N + 1)];
+            std::memcpy(pHeap, storage.inlineElements, N * sizeof(T));
+            storage.pHeap = pHeap;
+        } else if(numElements == getCapacity(numElements)) {
+            T* pHeap = new T[getCapacity(numElements + 1)];
+            std::memcpy(pHeap, storage.pHeap, numElements * sizeof(T));
+            delete[] storage.pHeap;
+            storage.pHeap = pHeap;
+        }
+
+        storage.pHeap[numElements++] = copy;
+    }
+
+    /**
+        Removes all elements that are equal to value. The order of the other elements is kept.
+        \param  value   the element to remove
+    */
+    void remove(const T& value) {
+        const T copy = value;   // value might be an element of this vector
+        const auto newEnd = std::remove(begin(), end(), copy);
+        shrink(static_cast<size_type>(newEnd - begin()));
+    }
+
+    /**
+        Removes all elements.
+    */
+    void clear() noexcept {
+        if(isOnHeap()) {
+            delete[] storage.pHeap;
+        }
+        numElements = 0;
+    }
+
+    /**
+        Replaces the content with the elements of the range [first, last).
+        \param  first   the first element
+        \param  last    one past the last element
+    */
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        clear();
+        for(; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+private:
+    bool isOnHeap() const noexcept { return numElements > N; }
+
+    /**
+        Returns the capacity of the heap memory for a number of elements.
+        \param  n   the number of elements (must be greater than N)
+        \return the capacity
+    */
+    static size_type getCapacity(size_type n) noexcept {
+        size_type capacity = 2 * N;
+        while(capacity < n) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    void shrink(size_type newSize) noexcept {
+        if(isOnHeap() && (newSize <= N)) {
+            // move the remaining elements back inline
+            T* pHeap = storage.pHeap;
+            std::memcpy(storage.inlineElements, pHeap, newSize * sizeof(T));
+            delete[] pHeap;
+        }
+        numElements = newSize;
+    }
+
+    union Storage {
+        T   inlineElements[N];      ///< the elements if there are at most N
+        T*  pHeap;                  ///< the elements if there are more than N
+    } storage{};
+
+    size_type numElements = 0;      ///< the number of elements
+};
+
+#endif // SMALLVECTOR_H
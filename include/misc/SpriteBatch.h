@@ -0,0 +1,124 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <misc/TextureAtlas.h>
+
+#include <vector>
+
+/**
+    Collects sprites and draws all consecutive sprites from the same atlas page with one call to SDL_RenderGeometry.
+
+    copy() and copyEx() are drop-in replacements for SDL_RenderCopy() and SDL_RenderCopyEx(). If the texture is part
+    of the current atlas the sprite is added to the batch; otherwise the batch is flushed and the texture is drawn
+    directly. So the drawing order is always kept. Everything else that draws to the renderer (lines, rectangles,
+    changing the render target, reading the screen) must call flush() before.
+
+    Without SDL 2.0.18 (no SDL_RenderGeometry) the sprites are drawn with SDL_RenderCopy from the atlas pages; this
+    still avoids the texture switches.
+*/
+class SpriteBatch {
+public:
+    SpriteBatch() = default;
+    ~SpriteBatch() = default;
+
+    SpriteBatch(const SpriteBatch &) = delete;
+    SpriteBatch(SpriteBatch &&) = delete;
+    SpriteBatch& operator=(const SpriteBatch &) = delete;
+    SpriteBatch& operator=(SpriteBatch &&) = delete;
+
+    /**
+        Sets the atlas the sprites are looked up in. The batch is flushed before.
+        \param  pNewAtlas   the atlas or nullptr to draw everything directly
+    */
+    void setAtlas(const TextureAtlas* pNewAtlas) {
+        flush();
+        pAtlas = pNewAtlas;
+    }
+
+    /**
+        Draws (a part of) a texture like SDL_RenderCopy.
+        \param  pTexture    the texture to draw
+        \param  srcrect     the part of the texture or nullptr for the whole texture
+        \param  dstrect     the position on the screen or nullptr for the whole screen
+    */
+    void copy(SDL_Texture* pTexture, const SDL_Rect* srcrect, const SDL_Rect* dstrect) {
+        copyEx(pTexture, srcrect, dstrect, 0.0);
+    }
+
+    /**
+        Draws (a part of) a texture rotated around the center of dstrect like SDL_RenderCopyEx (without flipping).
+        \param  pTexture    the texture to draw
+        \param  srcrect     the part of the texture or nullptr for the whole texture
+        \param  dstrect     the position on the screen (must not be nullptr)
+        \param  angle       the angle in degrees (clockwise)
+    */
+    void copyEx(SDL_Texture* pTexture, const SDL_Rect* srcrect, const SDL_Rect* dstrect, double angle);
+
+    /**
+        Draws a region of an atlas page that is not looked up by texture (e.g. a glyph of a GlyphAtlas). Consecutive
+        regions of the same page are batched like the sprites of the current atlas.
+        \param  region      the region to draw (the page must use alpha blending)
+        \param  dstrect     the position on the screen
+    */
+    void copyRegion(const TextureAtlas::Region& region, const SDL_Rect& dstrect);
+
+    /**
+        Draws all collected sprites.
+    */
+    void flush();
+
+    /**
+        Get the number of sprites drawn since the last call to resetStatistics().
+        \return the number of sprites
+    */
+    int getNumSprites() const noexcept { return numSprites; }
+
+    /**
+        Get the number of draw calls since the last call to resetStatistics().
+        \return the number of draw calls
+    */
+    int getNumDrawCalls() const noexcept { return numDrawCalls; }
+
+    /**
+        Resets the number of sprites and draw calls.
+    */
+    void resetStatistics() {
+        numSprites = 0;
+        numDrawCalls = 0;
+    }
+
+private:
+    void drawDirect(SDL_Texture* pTexture, const SDL_Rect* srcrect, const SDL_Rect* dstrect, double angle);
+    void addQuad(const TextureAtlas::Region& region, const SDL_Rect& source, const SDL_Rect* dstrect, double angle, SDL_Color color);
+
+    const TextureAtlas* pAtlas = nullptr;       ///< the atlas sprites are looked up in
+    SDL_Texture*        pCurrentPage = nullptr; ///< the atlas page of the collected sprites
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    std::vector<SDL_Vertex> vertices;           ///< four vertices per collected sprite
+    std::vector<int>        indices;            ///< two triangles per collected sprite
+#endif
+
+    int numSprites = 0;                         ///< number of sprites drawn since resetStatistics()
+    int numDrawCalls = 0;                       ///< number of draw calls since resetStatistics()
+};
+
+#endif // SPRITEBATCH_H
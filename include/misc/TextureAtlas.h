@@ -0,0 +1,107 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <misc/SDL2pp.h>
+
+#include <unordered_map>
+#include <vector>
+
+/**
+    Packs the pixels of many small textures into a few big textures (pages), so that sprites from different
+    textures can be drawn in one draw call (see SpriteBatch). The original textures stay valid and are used as keys;
+    the atlas only stores a second copy of their pixels.
+
+    The pictures are packed into shelves: a picture is put right of the last picture of the first shelf that is high
+    enough and has space left, otherwise a new shelf is opened below. Every picture gets a transparent border of one
+    pixel so that filtering never picks up the neighbour.
+*/
+class TextureAtlas {
+public:
+    /// The place of a texture inside the atlas
+    struct Region {
+        SDL_Texture*    pPage;      ///< the page the texture is packed into
+        SDL_Rect        rect;       ///< the position and size inside the page
+        float           invPageW;   ///< 1.0 / width of the page
+        float           invPageH;   ///< 1.0 / height of the page
+        bool            bOpaque;    ///< has the picture neither a color key nor an alpha channel?
+    };
+
+    /**
+        Constructor
+        \param  pageSize    the width and height of each page in pixels; it is reduced if the renderer does not
+                            support textures of this size
+    */
+    explicit TextureAtlas(int pageSize = 2048);
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas(TextureAtlas &&) = delete;
+    TextureAtlas& operator=(const TextureAtlas &) = delete;
+    TextureAtlas& operator=(TextureAtlas &&) = delete;
+
+    /**
+        Copies the pixels of pSurface into the atlas and remembers them as the pixels of pTexture.
+        \param  pTexture    the texture that was created from pSurface
+        \param  pSurface    the picture (a color key is converted to transparent pixels)
+        \return true if the picture was added, false if it does not fit into a page or uploading failed
+    */
+    bool add(SDL_Texture* pTexture, SDL_Surface* pSurface);
+
+    /**
+        Get the region of a texture.
+        \param  pTexture    the texture to look up
+        \return the region or nullptr if pTexture is not in this atlas
+    */
+    const Region* find(SDL_Texture* pTexture) const {
+        auto iter = regions.find(pTexture);
+        return (iter != regions.end()) ? &iter->second : nullptr;
+    }
+
+    /**
+        Get the number of pages.
+        \return the number of pages
+    */
+    int getNumPages() const noexcept { return static_cast<int>(pages.size()); }
+
+private:
+    /// A row of pictures inside a page
+    struct Shelf {
+        int y;          ///< the top of this shelf
+        int height;     ///< the height of this shelf
+        int usedWidth;  ///< the width that is already used
+    };
+
+    /// A page and the shelves it is divided into
+    struct Page {
+        sdl2::texture_ptr   pTexture;
+        std::vector<Shelf>  shelves;
+        int                 usedHeight = 0;
+    };
+
+    bool allocate(int w, int h, int& pageIndex, int& x, int& y);
+    bool allocateInPage(Page& page, int w, int h, int& x, int& y);
+
+    int                                             pageSize;   ///< width and height of every page
+    std::vector<Page>                               pages;      ///< all pages
+    std::unordered_map<SDL_Texture*, Region>        regions;    ///< the region of every added texture
+};
+
+#endif // TEXTUREATLAS_H
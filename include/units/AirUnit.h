@@ -41,6 +41,8 @@ public:
     void checkPos() override;
     bool canPass(int xPos, int yPos) const override;
 
+    TileAttributes::MovementClass getMovementClass() const override { return TileAttributes::Movement_Air; }
+
     virtual FixPoint getMaxSpeed() const override {
         return currentMaxSpeed;
     }
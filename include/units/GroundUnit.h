@@ -62,29 +62,9 @@ public:
     bool hasBookedCarrier() const;
     const UnitBase* getCarrier() const;
 
-    /**
-        Returns how fast a unit can move over the specified terrain type.
-        \param  terrainType the type to consider
-        \return Returns a speed factor. Higher values mean slower.
-    */
-    FixPoint getTerrainDifficulty(TERRAINTYPE terrainType) const override
-    {
-        switch(terrainType) {
-            case Terrain_Slab:          return 1.0_fix;
-            case Terrain_Sand:          return 1.375_fix;
-            case Terrain_Rock:          return 1.5625_fix;
-            case Terrain_Dunes:         return 1.375_fix;
-            case Terrain_Mountain:      return 1.0_fix;
-            case Terrain_Spice:         return 1.375_fix;
-            case Terrain_ThickSpice:    return 1.375_fix;
-            case Terrain_SpiceBloom:    return 1.375_fix;
-            case Terrain_SpecialBloom:  return 1.375_fix;
-            default:                    return 1.0_fix;
-        }
-    }
+    TileAttributes::MovementClass getMovementClass() const override { return TileAttributes::Movement_Wheeled; }
 
 protected:
-    void move() override;
     void navigate() override;
 
     bool    awaitingPickup;     ///< Is this unit waiting for pickup?
@@ -71,6 +71,8 @@ public:
 
     bool canPass(int xPos, int yPos) const override;
 
+    TileAttributes::MovementClass getMovementClass() const override { return TileAttributes::Movement_Infantry; }
+
     inline int getTilePosition() const { return tilePosition; }
 
 protected:
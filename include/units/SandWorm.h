@@ -60,21 +60,7 @@ public:
 
     void playAttackSound() override;
 
-    FixPoint getTerrainDifficulty(TERRAINTYPE terrainType) const override
-    {
-        switch(terrainType) {
-            case Terrain_Slab:          return 1.0_fix;
-            case Terrain_Sand:          return 1.25_fix;
-            case Terrain_Rock:          return 1.0_fix;
-            case Terrain_Dunes:         return 1.25_fix;
-            case Terrain_Mountain:      return 1.0_fix;
-            case Terrain_Spice:         return 1.25_fix;
-            case Terrain_ThickSpice:    return 1.25_fix;
-            case Terrain_SpiceBloom:    return 1.25_fix;
-            case Terrain_SpecialBloom:  return 1.25_fix;
-            default:                    return 1.0_fix;
-        }
-    }
+    TileAttributes::MovementClass getMovementClass() const override { return TileAttributes::Movement_Sandworm; }
 
     bool isEating() const { return (drawnFrame != INVALID); }
 
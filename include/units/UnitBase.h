@@ -21,6 +21,7 @@
 #include <ObjectBase.h>
 
 #include <House.h>
+#include <TileAttributes.h>
 
 #include <list>
 
@@ -185,7 +186,9 @@ public:
     inline void setDestination(int newX, int newY) override
     {
         if((destination.x != newX) || (destination.y != newY)) {
+            leaveGroupMove();
             ObjectBase::setDestination(newX, newY);
+            joinGroupMove();
             clearPath();
         }
     }
@@ -194,6 +197,12 @@ public:
 
     virtual void setPickedUp(UnitBase* newCarrier);
 
+    /**
+        Adds this ground unit to the group move to its destination (see Map::joinGroupMove()). This is done whenever the
+        destination changes and for all units after loading a savegame, as the group moves are not saved.
+    */
+    void joinGroupMove();
+
     /**
         Updates this unit.
         \return true if this unit still exists, false if it was destroyed
@@ -204,12 +213,20 @@ public:
 
     virtual bool hasBumpyMovementOnRock() const { return false; }
 
+    /**
+        Returns the way this unit moves over the map. It determines the terrain costs and the cost grid used for path search.
+        \return the movement class of this unit
+    */
+    virtual TileAttributes::MovementClass getMovementClass() const = 0;
+
     /**
         Returns how fast a unit can move over the specified terrain type.
         \param  terrainType the type to consider
         \return Returns a speed factor. Higher values mean slower.
     */
-    virtual FixPoint getTerrainDifficulty(TERRAINTYPE terrainType) const { return 1; }
+    FixPoint getTerrainDifficulty(TERRAINTYPE terrainType) const {
+        return TileAttributes::toTerrainDifficulty(TileAttributes::getTerrainCost(getMovementClass(), terrainType));
+    }
 
     virtual int getCurrentAttackAngle() const;
 
@@ -269,6 +286,8 @@ protected:
     void quitDeviation();
 
     bool SearchPathWithAStar();
+    bool followFlowField();
+    void leaveGroupMove();
 
     void drawSmoke(int x, int y) const;
 
@@ -304,6 +323,8 @@ protected:
     Sint32   recalculatePathTimer;   ///< This timer is for recalculating the best path after x ticks
     Coord    nextSpot;               ///< The next spot to move to
     std::list<Coord> pathList;       ///< The path to the destination found so far
+    Coord    groupMoveDestination;   ///< The destination of the group move we joined or invalid (not saved, see joinGroupMove())
+    TileAttributes::MovementClass groupMoveClass;   ///< The movement class we joined the group move with
 
     Sint32  findTargetTimer;         ///< When to look for the next target?
     Sint32  primaryWeaponTimer;      ///< When can the primary weapon shot again?
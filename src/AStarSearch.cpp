@@ -27,16 +27,19 @@
 
 #define MAX_NODES_CHECKED   (128*128)
 
-AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destination) {
+AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destination)
+ : sizeX(pMap->getSizeX()), sizeY(pMap->getSizeY()), workspace(pMap->getPathSearchWorkspace()) {
     FixPoint rotationSpeed = 1.0_fix/(currentGame->objectData.data[pUnit->getItemID()][pUnit->getOriginalHouseID()].turnspeed * TILESIZE);
 
-    sizeX = pMap->getSizeX();
-    sizeY = pMap->getSizeY();
+    const TileAttributes& tileAttributes = pMap->getTileAttributes();
+    const TileAttributes::MovementClass movementClass = pUnit->getMovementClass();
+    const Uint8* movementCosts = tileAttributes.getMovementCosts(movementClass);
 
-    mapData = static_cast<TileData*>(calloc(sizeX*sizeY, sizeof(TileData)));
-    if(mapData == nullptr) {
-        throw std::bad_alloc();
-    }
+    workspace.beginSearch(sizeX, sizeY);
+    searchGeneration = workspace.getSearchGeneration();
+
+    std::vector<Coord>& openList = workspace.openList;
+    std::vector<short>& depthCheckCount = workspace.depthCheckCount;
 
     FixPoint heuristic = blockDistance(start, destination);
     FixPoint smallestHeuristic = FixPt_MAX;
@@ -47,8 +50,6 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
 
         putOnOpenListIfBetter(start, Coord::Invalid(), 0 , heuristic);
 
-        std::vector<short> depthCheckCount(std::min(sizeX, sizeY));
-
         int numNodesChecked = 0;
         while(openList.empty() == false) {
             Coord currentCoord = extractMin();
@@ -69,15 +70,21 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
                 //push a node for each direction we could go
                 for (int angle=0; angle<=7; angle++) {
                     Coord nextCoord = pMap->getMapPos(angle, currentCoord);
-                    if(pUnit->canPass(nextCoord.x, nextCoord.y)) {
-                        Tile& nextTile = *(pMap->getTile(nextCoord));
+                    if((nextCoord.x < 0) || (nextCoord.x >= sizeX) || (nextCoord.y < 0) || (nextCoord.y >= sizeY)) {
+                        continue;
+                    }
+
+                    // the terrain is looked up in the cost grid; only if there are objects on the tile that might block us the unit has to decide
+                    const Uint8 movementCost = movementCosts[nextCoord.y * sizeX + nextCoord.x];
+                    if((movementCost != 0)
+                        && (!tileAttributes.mightBeBlocked(nextCoord.x, nextCoord.y, movementClass) || pUnit->canPass(nextCoord.x, nextCoord.y))) {
                         FixPoint g = getMapData(currentCoord).g;
 
                         if((nextCoord.x != currentCoord.x) && (nextCoord.y != currentCoord.y)) {
                             //add diagonal movement cost
-                            g += FixPt_SQRT2*(pUnit->isAFlyingUnit() ? 1.0_fix : pUnit->getTerrainDifficulty((TERRAINTYPE) nextTile.getType()));
+                            g += FixPt_SQRT2*TileAttributes::toTerrainDifficulty(movementCost);
                         } else {
-                            g += (pUnit->isAFlyingUnit() ? 1.0_fix : pUnit->getTerrainDifficulty((TERRAINTYPE) nextTile.getType()));
+                            g += TileAttributes::toTerrainDifficulty(movementCost);
                         }
 
                         if(getMapData(currentCoord).parentCoord.isValid())  {
@@ -150,12 +157,11 @@ AStarSearch::AStarSearch(Map* pMap, UnitBase* pUnit, Coord start, Coord destinat
             }
         }
 
+        currentGame->getCycleProfiler().addPathSearch(numNodesChecked);
     }
 
 
 }
 
-AStarSearch::~AStarSearch() {
-    free(mapData);
-}
+AStarSearch::~AStarSearch() = default;
 
@@ -279,6 +279,9 @@ void Bullet::blitToScreen() const
         SDL_Texture* shimmerTex = pGFXManager->getZoomedObjPic(ObjPic_Bullet_SonicTemp, currentZoomlevel);
         SDL_Texture* shimmerMaskTex = pGFXManager->getZoomedObjPic(ObjPic_Bullet_Sonic, currentZoomlevel);
 
+        // the shimmer is taken from the screen; draw everything batched so far
+        currentGame->getSpriteBatch().flush();
+
         // switch to texture 'shimmerTex' for rendering
         SDL_Texture* oldRenderTarget = SDL_GetRenderTarget(renderer);
         SDL_SetRenderTarget(renderer, shimmerTex);
@@ -306,7 +309,7 @@ void Bullet::blitToScreen() const
         SDL_RenderCopy(renderer, shimmerTex, nullptr, &dest);
     } else {
         SDL_Rect source = calcSpriteSourceRect(graphic[currentZoomlevel], (numFrames > 1) ? drawnAngle: 0, numFrames);
-        SDL_RenderCopy(renderer, graphic[currentZoomlevel], &source, &dest);
+        currentGame->getSpriteBatch().copy(graphic[currentZoomlevel], &source, &dest);
     }
 }
 
@@ -378,6 +378,7 @@ void Command::executeCommand() const {
                 SDL_Log("Warning: Game is asynchronous in game cycle %d! Saved seed and current seed do not match: %ud != %ud", currentGame->getGameCycleCount(), parameter[0], currentSeed);
 #ifdef TEST_SYNC
                 currentGame->saveGame("test.sav");
+                currentGame->waitForSaveGame();
                 exit(0);
 #endif
             }
@@ -53,10 +53,21 @@ void CommandManager::save(OutputStream& stream) const {
     }
 }
 
-void CommandManager::load(InputStream& stream) {
+void CommandManager::load(InputStream& stream, ReplayKeyframes* pKeyframes) {
     try {
         while(1) {
             Uint32 cycle = stream.readUint32();
+
+            if(cycle == ReplayKeyframes::KEYFRAME_MARKER) {
+                // a keyframe of a replay file
+                if(pKeyframes != nullptr) {
+                    pKeyframes->load(stream);
+                } else {
+                    ReplayKeyframes().load(stream);
+                }
+                continue;
+            }
+
             addCommand(Command(stream), cycle);
         }
     } catch (InputStream::exception&) {
@@ -0,0 +1,184 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <CycleProfiler.h>
+
+#include <globals.h>
+
+#include <FileClasses/FontManager.h>
+
+#include <misc/draw_util.h>
+#include <misc/format.h>
+
+#include <sand.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+// weight of the current game cycle in the averages shown in the overlay
+#define AVERAGE_WEIGHT  0.05
+
+// number of item types listed in the overlay
+#define NUM_OVERLAY_ITEMS   5
+
+CycleProfiler::CycleProfiler() : performanceFrequency(static_cast<double>(SDL_GetPerformanceFrequency())) {
+}
+
+CycleProfiler::~CycleProfiler() {
+    stopCSV();
+}
+
+void CycleProfiler::setEnabled(bool bEnabled) {
+    if(bEnabled && !this->bEnabled) {
+        currentCycle = CycleData();
+        totalCycle = CycleData();
+        numCycles = 0;
+        averageSectionMs.fill(0.0);
+        averageItemMs.fill(0.0);
+        averagePathNodes = 0.0;
+        averageSprites = 0.0;
+        averageDrawCalls = 0.0;
+    }
+
+    this->bEnabled = bEnabled;
+}
+
+bool CycleProfiler::startCSV(const std::string& filename) {
+    stopCSV();
+
+    pCSVFile = fopen(filename.c_str(), "w");
+    if(pCSVFile == nullptr) {
+        SDL_Log("CycleProfiler::startCSV(): Cannot open '%s': %s", filename.c_str(), strerror(errno));
+        return false;
+    }
+
+    writeCSVHeader();
+    return true;
+}
+
+void CycleProfiler::stopCSV() {
+    if(pCSVFile != nullptr) {
+        fclose(pCSVFile);
+        pCSVFile = nullptr;
+    }
+}
+
+void CycleProfiler::endCycle(Uint32 gameCycle) {
+    if(!bEnabled) {
+        return;
+    }
+
+    if(pCSVFile != nullptr) {
+        writeCSVLine(gameCycle);
+    }
+
+    for(int section = 0; section < NUM_SECTIONS; section++) {
+        averageSectionMs[section] += AVERAGE_WEIGHT * (ticksToMilliseconds(currentCycle.sectionTime[section]) - averageSectionMs[section]);
+        totalCycle.sectionTime[section] += currentCycle.sectionTime[section];
+    }
+
+    for(int itemID = 0; itemID < Num_ItemID; itemID++) {
+        averageItemMs[itemID] += AVERAGE_WEIGHT * (ticksToMilliseconds(currentCycle.itemTime[itemID]) - averageItemMs[itemID]);
+        totalCycle.itemTime[itemID] += currentCycle.itemTime[itemID];
+        totalCycle.itemUpdates[itemID] += currentCycle.itemUpdates[itemID];
+    }
+
+    averagePathNodes += AVERAGE_WEIGHT * (currentCycle.numPathNodes - averagePathNodes);
+    totalCycle.numPathSearches += currentCycle.numPathSearches;
+    totalCycle.numPathNodes += currentCycle.numPathNodes;
+
+    averageSprites += AVERAGE_WEIGHT * (currentCycle.numSprites - averageSprites);
+    averageDrawCalls += AVERAGE_WEIGHT * (currentCycle.numDrawCalls - averageDrawCalls);
+    totalCycle.numSprites += currentCycle.numSprites;
+    totalCycle.numDrawCalls += currentCycle.numDrawCalls;
+
+    numCycles++;
+    currentCycle = CycleData();
+}
+
+void CycleProfiler::draw(int x, int y) const {
+    std::vector<std::string> lines;
+
+    for(int section = 0; section < NUM_SECTIONS; section++) {
+        lines.push_back(fmt::sprintf("%s: %.2f ms", getSectionName(static_cast<Section>(section)), averageSectionMs[section]));
+    }
+    lines.push_back(fmt::sprintf("A* nodes: %.0f", averagePathNodes));
+    lines.push_back(fmt::sprintf("sprites: %.0f in %.0f draw calls", averageSprites, averageDrawCalls));
+
+    // the most expensive structure and unit types
+    std::vector<int> itemIDs;
+    for(int itemID = ItemID_FirstID; itemID <= ItemID_LastID; itemID++) {
+        itemIDs.push_back(itemID);
+    }
+    const auto numItems = std::min(itemIDs.size(), static_cast<size_t>(NUM_OVERLAY_ITEMS));
+    std::partial_sort(itemIDs.begin(), itemIDs.begin() + numItems, itemIDs.end(),
+                      [this](int a, int b) { return averageItemMs[a] > averageItemMs[b]; });
+    for(size_t i = 0; i < numItems; i++) {
+        lines.push_back(fmt::sprintf("%s: %.2f ms", getItemNameByID(itemIDs[i]), averageItemMs[itemIDs[i]]));
+    }
+
+    for(const std::string& line : lines) {
+        SDL_Rect drawLocation = pFontManager->drawText(line, COLOR_WHITE, 14, x, y, HAlign::Right, VAlign::Top);
+        y += drawLocation.h;
+    }
+}
+
+double CycleProfiler::getTotalSeconds(Section section) const {
+    return ticksToMilliseconds(totalCycle.sectionTime[section]) / 1000.0;
+}
+
+double CycleProfiler::getTotalItemSeconds(int itemID) const {
+    return ticksToMilliseconds(totalCycle.itemTime[itemID]) / 1000.0;
+}
+
+const char* CycleProfiler::getSectionName(Section section) {
+    switch(section) {
+        case Section_Commands:  return "commands";
+        case Section_Houses:    return "houses";
+        case Section_Triggers:  return "triggers";
+        case Section_Objects:   return "objects";
+        case Section_Draw:      return "draw";
+        default:                return "unknown";
+    }
+}
+
+void CycleProfiler::writeCSVHeader() {
+    fprintf(pCSVFile, "cycle");
+    for(int section = 0; section < NUM_SECTIONS; section++) {
+        fprintf(pCSVFile, ",%s_us", getSectionName(static_cast<Section>(section)));
+    }
+    fprintf(pCSVFile, ",path_searches,path_nodes,sprites,draw_calls");
+    for(int itemID = ItemID_FirstID; itemID <= ItemID_LastID; itemID++) {
+        fprintf(pCSVFile, ",%s_us", getItemNameByID(itemID).c_str());
+    }
+    fprintf(pCSVFile, "\n");
+}
+
+void CycleProfiler::writeCSVLine(Uint32 gameCycle) {
+    fprintf(pCSVFile, "%u", gameCycle);
+    for(int section = 0; section < NUM_SECTIONS; section++) {
+        fprintf(pCSVFile, ",%.0f", 1000.0 * ticksToMilliseconds(currentCycle.sectionTime[section]));
+    }
+    fprintf(pCSVFile, ",%llu,%llu", static_cast<unsigned long long>(currentCycle.numPathSearches), static_cast<unsigned long long>(currentCycle.numPathNodes));
+    fprintf(pCSVFile, ",%llu,%llu", static_cast<unsigned long long>(currentCycle.numSprites), static_cast<unsigned long long>(currentCycle.numDrawCalls));
+    for(int itemID = ItemID_FirstID; itemID <= ItemID_LastID; itemID++) {
+        fprintf(pCSVFile, ",%.0f", 1000.0 * ticksToMilliseconds(currentCycle.itemTime[itemID]));
+    }
+    fprintf(pCSVFile, "\n");
+}
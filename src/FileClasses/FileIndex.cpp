@@ -0,0 +1,70 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <FileClasses/FileIndex.h>
+
+#include <FileClasses/Pakfile.h>
+
+#include <misc/FileSystem.h>
+#include <misc/string_util.h>
+
+FileIndex::FileIndex() = default;
+
+FileIndex::~FileIndex() = default;
+
+void FileIndex::addDirectory(const std::string& directory) {
+    for(const FileInfo& fileInfo : getFileList(directory, "")) {
+        Entry entry;
+        entry.externalPath = directory + "/" + fileInfo.name;
+
+        // emplace does not overwrite files added before
+        externalFiles.emplace(strToLower(fileInfo.name), std::move(entry));
+    }
+}
+
+void FileIndex::addPakfile(Pakfile* pPakfile) {
+    for(int i = 0; i < pPakfile->getNumFiles(); i++) {
+        Entry entry;
+        entry.pPakfile = pPakfile;
+        entry.fileIndex = i;
+
+        pakFileEntries.emplace(pPakfile->getFilename(i), std::move(entry));
+    }
+}
+
+const FileIndex::Entry* FileIndex::find(const std::string& filename) const {
+    const auto externalIter = externalFiles.find(strToLower(filename));
+    if(externalIter != externalFiles.end()) {
+        return &externalIter->second;
+    }
+
+    const auto pakIter = pakFileEntries.find(filename);
+    if(pakIter != pakFileEntries.end()) {
+        return &pakIter->second;
+    }
+
+    return nullptr;
+}
+
+sdl2::RWops_ptr FileIndex::open(const Entry& entry) {
+    if(entry.pPakfile != nullptr) {
+        return entry.pPakfile->openFile(entry.fileIndex);
+    }
+
+    return sdl2::RWops_ptr{ SDL_RWFromFile(entry.externalPath.c_str(), "rb") };
+}
@@ -18,23 +18,20 @@
 #include <FileClasses/FileManager.h>
 
 #include <globals.h>
+#include <config.h>
 
 #include <FileClasses/TextManager.h>
 
 #include <misc/FileSystem.h>
 
 #include <misc/fnkdat.h>
-#include <misc/md5.h>
 #include <misc/string_util.h>
 #include <misc/exceptions.h>
 
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
 
 FileManager::FileManager() {
     SDL_Log("\nFileManager is loading PAK-Files...");
-    SDL_Log("\nMD5-Checksum                      Filename");
 
     const auto search_path = getSearchPath();
 
@@ -44,8 +41,8 @@ FileManager::FileManager() {
             filepath += filename;
             if(getCaseInsensitiveFilename(filepath)) {
                 try {
-                    SDL_Log("%s  %s", md5FromFilename(filepath).c_str(), filepath.c_str());
                     pakFiles.push_back(std::make_unique<Pakfile>(filepath));
+                    pakFilepaths.push_back(filepath);
                 } catch (std::exception &e) {
                     pakFiles.clear();
 
@@ -59,7 +56,21 @@ FileManager::FileManager() {
 
     }
 
-    SDL_Log("%s", "");
+    // the checksums are only logged; computing them shall not delay the startup
+    char tmp[FILENAME_MAX];
+    fnkdat(PAKMANIFESTFILENAME, tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+    pakManifest = std::make_unique<PakManifest>(tmp);
+    SDL_Log("MD5-Checksum                      Filename (logged in the background)");
+    pakManifest->verifyInBackground(pakFilepaths);
+
+    // build the index once; external files take precedence over the content of the pak files
+    for(const auto& searchPath : search_path) {
+        fileIndex.addDirectory(searchPath);
+    }
+
+    for(const auto& pPakFile : pakFiles) {
+        fileIndex.addPakfile(pPakFile.get());
+    }
 }
 
 FileManager::~FileManager() = default;
@@ -127,64 +138,28 @@ std::vector<std::string> FileManager::getMissingFiles() {
 }
 
 sdl2::RWops_ptr FileManager::openFile(const std::string& filename) {
-    sdl2::RWops_ptr ret;
-
-    // try loading external file
-    for(const auto& searchPath : getSearchPath()) {
-        auto externalFilename = searchPath + "/";
-        externalFilename += filename;
-        if(getCaseInsensitiveFilename(externalFilename)) {
-            ret = sdl2::RWops_ptr{SDL_RWFromFile(externalFilename.c_str(), "rb")};
-            if(ret) {
-                return ret;
-            }
-        }
-    }
-
-    // now try loading from pak file
-    for(const auto& pPakFile : pakFiles) {
-        if(pPakFile->exists(filename)) {
-            return pPakFile->openFile(filename);
+    const FileIndex::Entry* pEntry = fileIndex.find(filename);
+    if(pEntry != nullptr) {
+        sdl2::RWops_ptr ret = FileIndex::open(*pEntry);
+        if(ret) {
+            return ret;
         }
     }
 
     THROW(io_error, "Cannot find '%s'!", filename);
 }
 
-bool FileManager::exists(const std::string& filename) const {
-
-    // try finding external file
-    for(const std::string& searchPath : getSearchPath()) {
-        auto externalFilename = searchPath + "/";
-        externalFilename += filename;
-        if(getCaseInsensitiveFilename(externalFilename)) {
-            return true;
-        }
-    }
-
-    // now try finding in one pak file
-    for(const auto& pPakFile : pakFiles) {
-        if(pPakFile->exists(filename)) {
-            return true;
-        }
+std::string FileManager::getContentKey() const {
+    std::string contentKey;
+    for(const auto& filepath : pakFilepaths) {
+        uint64_t size = 0;
+        uint64_t modifydate = 0;
+        getFileSizeAndModifyDate(filepath, size, modifydate);
+        contentKey += filepath + ":" + std::to_string(size) + ":" + std::to_string(modifydate) + "\n";
     }
-
-    return false;
+    return contentKey;
 }
 
-
-std::string FileManager::md5FromFilename(const std::string& filename) const {
-    unsigned char md5sum[16];
-
-    if(md5_file(filename.c_str(), md5sum) != 0) {
-        THROW(io_error, "Cannot open or read '%s'!", filename);
-    } else {
-
-        std::stringstream stream;
-        stream << std::setfill('0') << std::hex;
-        for(int i : md5sum) {
-            stream << std::setw(2) << i;
-        }
-        return stream.str();
-    }
+bool FileManager::exists(const std::string& filename) const {
+    return (fileIndex.find(filename) != nullptr);
 }
@@ -28,6 +28,11 @@
 
 #include <list>
 
+namespace {
+    /// the maximum number of texts kept in the cache of drawn texts
+    constexpr size_t MAX_CACHED_TEXTS = 128;
+}
+
 FontManager::FontManager() = default;
 
 FontManager::~FontManager() = default;
@@ -111,6 +116,69 @@ sdl2::texture_ptr FontManager::createTextureWithMultilineText(const std::string&
     return convertSurfaceToTexture(createSurfaceWithMultilineText(text, color, fontSize, bCentered));
 }
 
+SDL_Rect FontManager::drawText(const std::string& text, Uint32 color, unsigned int fontSize, int x, int y, HAlign halign, VAlign valign) {
+    SDL_Texture* pTexture = nullptr;
+    SDL_Rect dest = { x, y, 0, 0 };
+
+    if(GlyphAtlas::hasAllGlyphs(text)) {
+        const GlyphAtlas& glyphAtlas = getGlyphAtlas(fontSize, color);
+        dest.w = glyphAtlas.getTextWidth(text);
+        dest.h = glyphAtlas.getTextHeight();
+    } else {
+        pTexture = getCachedTextureWithText(text, color, fontSize);
+        SDL_QueryTexture(pTexture, nullptr, nullptr, &dest.w, &dest.h);
+    }
+
+    switch(halign) {
+        case HAlign::Left:      /*nothing*/         break;
+        case HAlign::Center:    dest.x -= dest.w/2; break;
+        case HAlign::Right:     dest.x -= dest.w-1; break;
+    }
+
+    switch(valign) {
+        case VAlign::Top:       /*nothing*/         break;
+        case VAlign::Center:    dest.y -= dest.h/2; break;
+        case VAlign::Bottom:    dest.y -= dest.h-1; break;
+    }
+
+    if(pTexture == nullptr) {
+        getGlyphAtlas(fontSize, color).draw(textBatch, text, dest.x, dest.y);
+        textBatch.flush();
+    } else {
+        SDL_RenderCopy(renderer, pTexture, nullptr, &dest);
+    }
+
+    return dest;
+}
+
+GlyphAtlas& FontManager::getGlyphAtlas(unsigned int fontSize, Uint32 color) {
+    auto& pGlyphAtlas = glyphAtlases[std::make_pair(fontSize, color)];
+    if(pGlyphAtlas == nullptr) {
+        pGlyphAtlas = std::make_unique<GlyphAtlas>(*getFont(fontSize), color);
+    }
+    return *pGlyphAtlas;
+}
+
+SDL_Texture* FontManager::getCachedTextureWithText(const std::string& text, Uint32 color, unsigned int fontSize) {
+    CachedTextKey key(text, color, fontSize);
+
+    auto iter = cachedTextIndex.find(key);
+    if(iter != cachedTextIndex.end()) {
+        // move to the front
+        cachedTexts.splice(cachedTexts.begin(), cachedTexts, iter->second);
+        return iter->second->pTexture.get();
+    }
+
+    if(cachedTexts.size() >= MAX_CACHED_TEXTS) {
+        cachedTextIndex.erase(cachedTexts.back().key);
+        cachedTexts.pop_back();
+    }
+
+    cachedTexts.push_front(CachedText{ key, createTextureWithText(text, color, fontSize) });
+    cachedTextIndex.emplace(std::move(key), cachedTexts.begin());
+    return cachedTexts.front().pTexture.get();
+}
+
 std::unique_ptr<Font> FontManager::loadFont(unsigned int fontSize) {
     return std::make_unique<TTFFont>( pFileManager->openFile("Philosopher-Bold.ttf"), fontSize );
 }
@@ -32,6 +32,11 @@
 #include <misc/draw_util.h>
 #include <misc/Scaler.h>
 #include <misc/exceptions.h>
+#include <misc/fnkdat.h>
+
+#include <config.h>
+
+#include <algorithm>
 
 /**
     Number of columns and rows each obj pic has
@@ -257,35 +262,17 @@ GFXManager::GFXManager() {
     SDL_Color fogTransparent = { 0, 0, 0, 96};
     SDL_SetPaletteColors(objPic[ObjPic_Terrain_HiddenFog][HOUSE_HARKONNEN][0]->format->palette, &fogTransparent, PALCOLOR_BLACK, 1);
 
-    // scale obj pics and apply color key
+    // apply color key; the other zoom levels, the shadows and the other houses are generated on demand (see generateObjPic())
     for(int id = 0; id < NUM_OBJPICS; id++) {
         for(int h = 0; h < (int) NUM_HOUSES; h++) {
-            if(objPic[id][h][0] != nullptr) {
-                if(objPic[id][h][1] == nullptr) {
-                    objPic[id][h][1] = generateDoubledObjPic(id, h);
-                }
-                SDL_SetColorKey(objPic[id][h][1].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
-
-                if(objPic[id][h][2] == nullptr) {
-                    objPic[id][h][2] = generateTripledObjPic(id, h);
+            for(int z = 0; z < NUM_ZOOMLEVEL; z++) {
+                if(objPic[id][h][z] != nullptr) {
+                    SDL_SetColorKey(objPic[id][h][z].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
                 }
-                SDL_SetColorKey(objPic[id][h][2].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
-
-                SDL_SetColorKey(objPic[id][h][0].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
             }
         }
     }
 
-    objPic[ObjPic_CarryallShadow][HOUSE_HARKONNEN][0] = createShadowSurface(objPic[ObjPic_Carryall][HOUSE_HARKONNEN][0].get());
-    objPic[ObjPic_CarryallShadow][HOUSE_HARKONNEN][1] = createShadowSurface(objPic[ObjPic_Carryall][HOUSE_HARKONNEN][1].get());
-    objPic[ObjPic_CarryallShadow][HOUSE_HARKONNEN][2] = createShadowSurface(objPic[ObjPic_Carryall][HOUSE_HARKONNEN][2].get());
-    objPic[ObjPic_FrigateShadow][HOUSE_HARKONNEN][0] = createShadowSurface(objPic[ObjPic_Frigate][HOUSE_HARKONNEN][0].get());
-    objPic[ObjPic_FrigateShadow][HOUSE_HARKONNEN][1] = createShadowSurface(objPic[ObjPic_Frigate][HOUSE_HARKONNEN][1].get());
-    objPic[ObjPic_FrigateShadow][HOUSE_HARKONNEN][2] = createShadowSurface(objPic[ObjPic_Frigate][HOUSE_HARKONNEN][2].get());
-    objPic[ObjPic_OrnithopterShadow][HOUSE_HARKONNEN][0] = createShadowSurface(objPic[ObjPic_Ornithopter][HOUSE_HARKONNEN][0].get());
-    objPic[ObjPic_OrnithopterShadow][HOUSE_HARKONNEN][1] = createShadowSurface(objPic[ObjPic_Ornithopter][HOUSE_HARKONNEN][1].get());
-    objPic[ObjPic_OrnithopterShadow][HOUSE_HARKONNEN][2] = createShadowSurface(objPic[ObjPic_Ornithopter][HOUSE_HARKONNEN][2].get());
-
     // load small detail pics
     smallDetailPicTex[Picture_Barracks] = extractSmallDetailPic("BARRAC.WSA");
     smallDetailPicTex[Picture_ConstructionYard] = extractSmallDetailPic("CONSTRUC.WSA");
@@ -828,39 +815,101 @@ GFXManager::GFXManager() {
 
     // pBackgroundSurface is separate as we never draw it but use it to construct other sprites
     pBackgroundSurface = convertSurfaceToDisplayFormat(PicFactory->createBackground().get());
+
+    // start generating the object pictures in the background
+    char tmp[FILENAME_MAX];
+    fnkdat(OBJPICCACHEFILENAME, tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+    objPicCache = std::make_unique<ObjPicCache>(tmp, settings.video.scaler + "\n" + pFileManager->getContentKey());
+
+    for(SDL_mutex*& mutex : objPicGroupMutex) {
+        mutex = SDL_CreateMutex();
+    }
+    objPicQueueMutex = SDL_CreateMutex();
+    objPicQueueCond = SDL_CreateCond();
+
+    for(unsigned int id : { ObjPic_Terrain, ObjPic_Terrain_Hidden, ObjPic_Terrain_HiddenFog, ObjPic_Terrain_Tracks, ObjPic_RockDamage, ObjPic_SandDamage, ObjPic_DestroyedStructure, ObjPic_Wall }) {
+        enqueueObjPic(id, HOUSE_HARKONNEN, PRIORITY_MAP);
+    }
+    for(unsigned int id = 0; id < NUM_OBJPICS; id++) {
+        enqueueObjPic(id, HOUSE_HARKONNEN, PRIORITY_DEFAULT);
+    }
+
+    const int numWorkers = std::min(4, std::max(1, SDL_GetCPUCount() - 1));
+    for(int i = 0; i < numWorkers; i++) {
+        SDL_Thread* pThread = SDL_CreateThread(objPicWorkerMain, "ObjPicWorker", (void*) this);
+        if(pThread == nullptr) {
+            // not fatal, the pictures are generated on demand
+            SDL_Log("GFXManager: Unable to create worker thread: %s", SDL_GetError());
+            break;
+        }
+        objPicWorkers.push_back(pThread);
+    }
 }
 
-GFXManager::~GFXManager() = default;
+GFXManager::~GFXManager() {
+    SDL_LockMutex(objPicQueueMutex);
+    bStopObjPicWorkers = true;
+    SDL_CondBroadcast(objPicQueueCond);
+    SDL_UnlockMutex(objPicQueueMutex);
+
+    for(SDL_Thread* pThread : objPicWorkers) {
+        SDL_WaitThread(pThread, nullptr);
+    }
+
+    objPicCache->save();
+
+    SDL_DestroyCond(objPicQueueCond);
+    SDL_DestroyMutex(objPicQueueMutex);
+    for(SDL_mutex* mutex : objPicGroupMutex) {
+        SDL_DestroyMutex(mutex);
+    }
+}
 
 SDL_Texture* GFXManager::getZoomedObjPic(unsigned int id, int house, unsigned int z) {
     if(id >= NUM_OBJPICS) {
         THROW(std::invalid_argument, "GFXManager::getZoomedObjPic(): Unit Picture with ID %u is not available!", id);
     }
 
-    if(objPic[id][house][z] == nullptr) {
-        // remap to this color
-        if(objPic[id][HOUSE_HARKONNEN][z] == nullptr) {
-            THROW(std::runtime_error, "GFXManager::getZoomedObjPic(): Unit Picture with ID %u is not loaded!", id);
+    if(objPicTex[id][house][z] == nullptr) {
+        ensureObjPic(id, house);
+
+        // converting a surface changes its blit map, which the workers use when remapping or shadowing the same picture
+        SDL_LockMutex(objPicGroupMutex[getObjPicGroup(id)]);
+        try {
+            convertObjPic(id, house, z);
+        } catch(...) {
+            SDL_UnlockMutex(objPicGroupMutex[getObjPicGroup(id)]);
+            throw;
         }
+        SDL_UnlockMutex(objPicGroupMutex[getObjPicGroup(id)]);
+    }
+
+    return objPicTex[id][house][z].get();
+}
 
-        objPic[id][house][z] = mapSurfaceColorRange(objPic[id][HOUSE_HARKONNEN][z].get(), PALCOLOR_HARKONNEN, houseToPaletteIndex[house]);
+void GFXManager::convertObjPic(unsigned int id, int house, unsigned int z) {
+    if(objPic[id][house][z] == nullptr) {
+        THROW(std::runtime_error, "GFXManager::getZoomedObjPic(): Unit Picture with ID %u is not loaded!", id);
     }
 
-    if(objPicTex[id][house][z] == nullptr) {
-        // now convert to display format
-        if(id == ObjPic_Windtrap) {
-            // Windtrap uses palette animation on PALCOLOR_WINDTRAP_COLORCYCLE; fake this
-            objPicTex[id][house][z] = convertSurfaceToTexture(generateWindtrapAnimationFrames(objPic[id][house][z].get()));
-        } else if(id == ObjPic_Bullet_SonicTemp) {
-            objPicTex[id][house][z] = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, objPic[id][house][z]->w, objPic[id][house][z]->h) };
-        } else if(id == ObjPic_SandwormShimmerTemp) {
-            objPicTex[id][house][z] = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, objPic[id][house][z]->w, objPic[id][house][z]->h) };
-        } else {
-            objPicTex[id][house][z] = convertSurfaceToTexture(objPic[id][house][z].get());
-        }
+    if(objPicAtlas[z] == nullptr) {
+        objPicAtlas[z] = std::make_unique<TextureAtlas>();
     }
 
-    return objPicTex[id][house][z].get();
+    // now convert to display format
+    if(id == ObjPic_Windtrap) {
+        // Windtrap uses palette animation on PALCOLOR_WINDTRAP_COLORCYCLE; fake this
+        sdl2::surface_ptr pWindtrapFrames = generateWindtrapAnimationFrames(objPic[id][house][z].get());
+        objPicTex[id][house][z] = convertSurfaceToTexture(pWindtrapFrames.get());
+        objPicAtlas[z]->add(objPicTex[id][house][z].get(), pWindtrapFrames.get());
+    } else if(id == ObjPic_Bullet_SonicTemp) {
+        objPicTex[id][house][z] = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, objPic[id][house][z]->w, objPic[id][house][z]->h) };
+    } else if(id == ObjPic_SandwormShimmerTemp) {
+        objPicTex[id][house][z] = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, objPic[id][house][z]->w, objPic[id][house][z]->h) };
+    } else {
+        objPicTex[id][house][z] = convertSurfaceToTexture(objPic[id][house][z].get());
+        objPicAtlas[z]->add(objPicTex[id][house][z].get(), objPic[id][house][z].get());
+    }
 }
 
 zoomable_texture GFXManager::getObjPic(unsigned int id, int house) {
@@ -958,6 +1007,12 @@ SDL_Texture* GFXManager::getMapChoicePiece(unsigned int num, int house) {
     return mapChoicePiecesTex[num][house].get();
 }
 
+void GFXManager::prefetchObjPics(int house) {
+    for(unsigned int id = ObjPic_Tank_Base; id <= ObjPic_Wall; id++) {
+        enqueueObjPic(id, house, PRIORITY_HOUSE);
+    }
+}
+
 Animation* GFXManager::getAnimation(unsigned int id) {
     if(id >= NUM_ANIMATION) {
         THROW(std::invalid_argument, "GFXManager::getAnimation(): Animation with ID %u is not available!", id);
@@ -1254,3 +1309,119 @@ sdl2::surface_ptr GFXManager::generateTripledObjPic(unsigned int id, int h) cons
 
     return pSurface;
 }
+
+void GFXManager::enqueueObjPic(unsigned int id, int house, int priority) {
+    SDL_LockMutex(objPicQueueMutex);
+    objPicQueue.push(ObjPicJob{ priority, objPicQueueSequence++, id, house });
+    SDL_CondSignal(objPicQueueCond);
+    SDL_UnlockMutex(objPicQueueMutex);
+}
+
+int GFXManager::objPicWorkerMain(void* data) {
+    GFXManager* pGFXManager = static_cast<GFXManager*>(data);
+
+    while(true) {
+        SDL_LockMutex(pGFXManager->objPicQueueMutex);
+        while(pGFXManager->objPicQueue.empty() && !pGFXManager->bStopObjPicWorkers) {
+            SDL_CondWait(pGFXManager->objPicQueueCond, pGFXManager->objPicQueueMutex);
+        }
+
+        if(pGFXManager->bStopObjPicWorkers) {
+            SDL_UnlockMutex(pGFXManager->objPicQueueMutex);
+            return 0;
+        }
+
+        // a picture may be queued more than once (e.g. with a higher priority); ensureObjPic() skips it the second time
+        const ObjPicJob job = pGFXManager->objPicQueue.top();
+        pGFXManager->objPicQueue.pop();
+        SDL_UnlockMutex(pGFXManager->objPicQueueMutex);
+
+        try {
+            pGFXManager->ensureObjPic(job.id, job.house);
+        } catch(std::exception& e) {
+            SDL_Log("GFXManager::objPicWorkerMain(): %s", e.what());
+        }
+    }
+}
+
+void GFXManager::ensureObjPic(unsigned int id, int house) {
+    // SDL mutexes are recursive, so generateObjPic() may ensure other pictures of the same group
+    SDL_LockMutex(objPicGroupMutex[getObjPicGroup(id)]);
+
+    if(!objPicReady[id][house]) {
+        try {
+            generateObjPic(id, house);
+        } catch(...) {
+            SDL_UnlockMutex(objPicGroupMutex[getObjPicGroup(id)]);
+            throw;
+        }
+        objPicReady[id][house] = true;
+    }
+
+    SDL_UnlockMutex(objPicGroupMutex[getObjPicGroup(id)]);
+}
+
+unsigned int GFXManager::getObjPicGroup(unsigned int id) {
+    // a shadow is generated from its unit and must not be generated while the unit picture is remapped
+    switch(id) {
+        case ObjPic_CarryallShadow:     return ObjPic_Carryall;
+        case ObjPic_FrigateShadow:      return ObjPic_Frigate;
+        case ObjPic_OrnithopterShadow:  return ObjPic_Ornithopter;
+        default:                        return id;
+    }
+}
+
+void GFXManager::generateObjPic(unsigned int id, int house) {
+    if((house != HOUSE_HARKONNEN) && (objPic[id][house][0] == nullptr)) {
+        // remap to this color
+        ensureObjPic(id, HOUSE_HARKONNEN);
+
+        for(unsigned int z = 0; z < NUM_ZOOMLEVEL; z++) {
+            if(objPic[id][HOUSE_HARKONNEN][z] == nullptr) {
+                return;
+            }
+
+            objPic[id][house][z] = loadOrGenerateObjPic(id, house, z, [&]() {
+                return mapSurfaceColorRange(objPic[id][HOUSE_HARKONNEN][z].get(), PALCOLOR_HARKONNEN, houseToPaletteIndex[house]);
+            });
+        }
+        return;
+    }
+
+    const unsigned int group = getObjPicGroup(id);
+    if(group != id) {
+        // shadow
+        ensureObjPic(group, HOUSE_HARKONNEN);
+
+        for(unsigned int z = 0; z < NUM_ZOOMLEVEL; z++) {
+            objPic[id][house][z] = loadOrGenerateObjPic(id, house, z, [&]() {
+                return createShadowSurface(objPic[group][HOUSE_HARKONNEN][z].get());
+            });
+        }
+        return;
+    }
+
+    if(objPic[id][house][0] == nullptr) {
+        return;
+    }
+
+    if(objPic[id][house][1] == nullptr) {
+        objPic[id][house][1] = loadOrGenerateObjPic(id, house, 1, [&]() { return generateDoubledObjPic(id, house); });
+        SDL_SetColorKey(objPic[id][house][1].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
+    }
+
+    if(objPic[id][house][2] == nullptr) {
+        objPic[id][house][2] = loadOrGenerateObjPic(id, house, 2, [&]() { return generateTripledObjPic(id, house); });
+        SDL_SetColorKey(objPic[id][house][2].get(), SDL_TRUE, PALCOLOR_TRANSPARENT);
+    }
+}
+
+template<typename Generator>
+sdl2::surface_ptr GFXManager::loadOrGenerateObjPic(unsigned int id, int house, unsigned int z, Generator&& generator) {
+    sdl2::surface_ptr pSurface = objPicCache->load(id, house, z);
+    if(pSurface == nullptr) {
+        pSurface = generator();
+        objPicCache->store(id, house, z, pSurface.get());
+    }
+    return pSurface;
+}
@@ -0,0 +1,125 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <FileClasses/GlyphAtlas.h>
+
+#include <FileClasses/Font.h>
+
+#include <misc/draw_util.h>
+#include <misc/exceptions.h>
+#include <misc/SpriteBatch.h>
+
+#include <globals.h>
+
+#include <algorithm>
+
+constexpr char GlyphAtlas::FIRST_GLYPH;
+constexpr char GlyphAtlas::LAST_GLYPH;
+
+namespace {
+    /// the width of the atlas texture; the glyphs are put into as many rows as needed
+    constexpr int ATLAS_WIDTH = 512;
+}
+
+GlyphAtlas::GlyphAtlas(Font& font, Uint32 color) : textHeight(font.getTextHeight()) {
+    // render every glyph like a text consisting of only this character (see FontManager::createSurfaceWithText())
+    std::array<sdl2::surface_ptr, NUM_GLYPHS> glyphSurfaces;
+    std::array<SDL_Point, NUM_GLYPHS> positions;
+    int x = 0;
+    int y = 0;
+    for(int i = 0; i < NUM_GLYPHS; i++) {
+        const std::string character(1, static_cast<char>(FIRST_GLYPH + i));
+
+        const int width = std::max(font.getTextWidth(character), 1);
+        glyphSurfaces[i] = sdl2::surface_ptr{ SDL_CreateRGBSurface(0, width, textHeight, SCREEN_BPP, RMASK, GMASK, BMASK, AMASK) };
+        if(glyphSurfaces[i] == nullptr) {
+            THROW(std::runtime_error, "GlyphAtlas::GlyphAtlas(): Cannot create surface: %s!", SDL_GetError());
+        }
+        SDL_SetSurfaceBlendMode(glyphSurfaces[i].get(), SDL_BLENDMODE_NONE);
+        SDL_FillRect(glyphSurfaces[i].get(), nullptr, COLOR_INVALID);
+        SDL_SetColorKey(glyphSurfaces[i].get(), SDL_TRUE, COLOR_INVALID);
+        font.drawTextOnSurface(glyphSurfaces[i].get(), character, color);
+
+        // one pixel between the glyphs so that filtering never picks up the neighbour
+        if(x + width > ATLAS_WIDTH) {
+            x = 0;
+            y += textHeight + 1;
+        }
+        positions[i] = SDL_Point{ x, y };
+        x += width + 1;
+    }
+
+    sdl2::surface_ptr pAtlasSurface{ SDL_CreateRGBSurface(0, ATLAS_WIDTH, y + textHeight, SCREEN_BPP, RMASK, GMASK, BMASK, AMASK) };
+    if(pAtlasSurface == nullptr) {
+        THROW(std::runtime_error, "GlyphAtlas::GlyphAtlas(): Cannot create surface: %s!", SDL_GetError());
+    }
+    SDL_SetSurfaceBlendMode(pAtlasSurface.get(), SDL_BLENDMODE_NONE);
+    SDL_FillRect(pAtlasSurface.get(), nullptr, COLOR_INVALID);
+    SDL_SetColorKey(pAtlasSurface.get(), SDL_TRUE, COLOR_INVALID);
+
+    for(int i = 0; i < NUM_GLYPHS; i++) {
+        SDL_Rect dest = { positions[i].x, positions[i].y, glyphSurfaces[i]->w, glyphSurfaces[i]->h };
+        SDL_BlitSurface(glyphSurfaces[i].get(), nullptr, pAtlasSurface.get(), &dest);
+    }
+
+    pTexture = convertSurfaceToTexture(pAtlasSurface.get());
+    SDL_SetTextureBlendMode(pTexture.get(), SDL_BLENDMODE_BLEND);
+
+    for(int i = 0; i < NUM_GLYPHS; i++) {
+        Glyph& glyph = glyphs[i];
+        glyph.region.pPage = pTexture.get();
+        glyph.region.rect = SDL_Rect{ positions[i].x, positions[i].y, glyphSurfaces[i]->w, glyphSurfaces[i]->h };
+        glyph.region.invPageW = 1.0f / pAtlasSurface->w;
+        glyph.region.invPageH = 1.0f / pAtlasSurface->h;
+        glyph.region.bOpaque = false;
+
+        int minX = 0;
+        font.getGlyphMetrics(FIRST_GLYPH + i, minX, glyph.advance);
+        glyph.offsetX = std::min(minX, 0);
+    }
+
+    kerning.resize(NUM_GLYPHS * NUM_GLYPHS);
+    for(int previousIndex = 0; previousIndex < NUM_GLYPHS; previousIndex++) {
+        for(int index = 0; index < NUM_GLYPHS; index++) {
+            kerning[previousIndex * NUM_GLYPHS + index] = static_cast<Sint16>(font.getKerning(FIRST_GLYPH + previousIndex, FIRST_GLYPH + index));
+        }
+    }
+}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+bool GlyphAtlas::hasAllGlyphs(const std::string& text) noexcept {
+    return std::all_of(text.begin(), text.end(), [](char character) {
+                            return (character >= FIRST_GLYPH) && (character <= LAST_GLYPH);
+                        });
+}
+
+int GlyphAtlas::getTextWidth(const std::string& text) const {
+    int width = 0;
+    layout(text, [&width](const Glyph& glyph, int x) {
+        width = std::max(width, x + glyph.region.rect.w);
+    });
+    return width;
+}
+
+void GlyphAtlas::draw(SpriteBatch& spriteBatch, const std::string& text, int x, int y) const {
+    layout(text, [&spriteBatch, x, y](const Glyph& glyph, int glyphX) {
+        const SDL_Rect dest = { x + glyphX, y, glyph.region.rect.w, glyph.region.rect.h };
+        spriteBatch.copyRegion(glyph.region, dest);
+    });
+}
@@ -0,0 +1,270 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <FileClasses/ObjPicCache.h>
+
+#include <misc/exceptions.h>
+
+#include <string.h>
+
+static const char CACHE_MAGIC[4] = { 'D', 'L', 'O', 'P' };
+
+namespace {
+
+/// Reads little endian values from a memory range and keeps track of the remaining size
+class CacheReader {
+public:
+    CacheReader(const Uint8* pData, size_t size) : pData(pData), remaining(size) { }
+
+    bool readUint32(Uint32& value) {
+        if(remaining < sizeof(Uint32)) {
+            return false;
+        }
+        memcpy(&value, pData, sizeof(Uint32));
+        value = SDL_SwapLE32(value);
+        pData += sizeof(Uint32);
+        remaining -= sizeof(Uint32);
+        return true;
+    }
+
+    const Uint8* skip(size_t size) {
+        if(remaining < size) {
+            return nullptr;
+        }
+        const Uint8* pCurrent = pData;
+        pData += size;
+        remaining -= size;
+        return pCurrent;
+    }
+
+private:
+    const Uint8*    pData;
+    size_t          remaining;
+};
+
+void appendUint32(std::vector<Uint8>& buffer, Uint32 value) {
+    value = SDL_SwapLE32(value);
+    const Uint8* pValue = reinterpret_cast<const Uint8*>(&value);
+    buffer.insert(buffer.end(), pValue, pValue + sizeof(Uint32));
+}
+
+}
+
+ObjPicCache::ObjPicCache(const std::string& filepath, const std::string& sourceKey)
+ : filepath(filepath), sourceKey(sourceKey), bChanged(false) {
+
+    mutex = SDL_CreateMutex();
+    if(mutex == nullptr) {
+        THROW(std::runtime_error, "ObjPicCache::ObjPicCache(): SDL_CreateMutex() failed: %s", SDL_GetError());
+    }
+
+    try {
+        pMappedFile = std::make_unique<MappedFile>(filepath);
+    } catch(std::exception&) {
+        // there is no cache yet
+        return;
+    }
+
+    if(readIndex() == false) {
+        SDL_Log("ObjPicCache: Discarding outdated or invalid cache file '%s'", filepath.c_str());
+        entries.clear();
+        pMappedFile.reset();
+    }
+}
+
+ObjPicCache::~ObjPicCache() {
+    SDL_DestroyMutex(mutex);
+}
+
+bool ObjPicCache::readIndex() {
+    CacheReader reader(pMappedFile->getData(), pMappedFile->getSize());
+
+    const Uint8* pMagic = reader.skip(sizeof(CACHE_MAGIC));
+    if((pMagic == nullptr) || (memcmp(pMagic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)) {
+        return false;
+    }
+
+    Uint32 version;
+    if(!reader.readUint32(version) || (version != CACHE_VERSION)) {
+        return false;
+    }
+
+    Uint32 keyLength;
+    if(!reader.readUint32(keyLength)) {
+        return false;
+    }
+    const Uint8* pKey = reader.skip(keyLength);
+    if((pKey == nullptr) || (sourceKey != std::string(reinterpret_cast<const char*>(pKey), keyLength))) {
+        return false;
+    }
+
+    Uint32 numEntries;
+    if(!reader.readUint32(numEntries)) {
+        return false;
+    }
+
+    for(Uint32 i = 0; i < numEntries; i++) {
+        Uint32 key;
+        Entry entry;
+        if(!reader.readUint32(key) || !reader.readUint32(entry.w) || !reader.readUint32(entry.h)
+            || !reader.readUint32(entry.colorKey) || !reader.readUint32(entry.blendMode) || !reader.readUint32(entry.numColors)) {
+            return false;
+        }
+
+        if((entry.numColors > 256) || (entry.w > 16384) || (entry.h > 16384)) {
+            return false;
+        }
+
+        entry.pPalette = reader.skip(entry.numColors * 4);
+        entry.pPixels = reader.skip(static_cast<size_t>(entry.w) * entry.h);
+        if((entry.pPalette == nullptr) || (entry.pPixels == nullptr)) {
+            return false;
+        }
+
+        entries[key] = entry;
+    }
+
+    return true;
+}
+
+sdl2::surface_ptr ObjPicCache::load(unsigned int id, int house, unsigned int zoom) const {
+    SDL_LockMutex(mutex);
+
+    const auto iter = entries.find(getKey(id, house, zoom));
+    if(iter == entries.end()) {
+        SDL_UnlockMutex(mutex);
+        return nullptr;
+    }
+
+    const Entry& entry = iter->second;
+
+    sdl2::surface_ptr pSurface{ SDL_CreateRGBSurface(0, entry.w, entry.h, 8, 0, 0, 0, 0) };
+    if(pSurface == nullptr) {
+        SDL_UnlockMutex(mutex);
+        return nullptr;
+    }
+
+    for(Uint32 y = 0; y < entry.h; y++) {
+        memcpy(static_cast<Uint8*>(pSurface->pixels) + y * pSurface->pitch, entry.pPixels + y * entry.w, entry.w);
+    }
+
+    SDL_Color colors[256];
+    for(Uint32 i = 0; i < entry.numColors; i++) {
+        colors[i].r = entry.pPalette[4*i];
+        colors[i].g = entry.pPalette[4*i + 1];
+        colors[i].b = entry.pPalette[4*i + 2];
+        colors[i].a = entry.pPalette[4*i + 3];
+    }
+    SDL_SetPaletteColors(pSurface->format->palette, colors, 0, entry.numColors);
+
+    if(entry.colorKey != NO_COLORKEY) {
+        SDL_SetColorKey(pSurface.get(), SDL_TRUE, entry.colorKey);
+    }
+    SDL_SetSurfaceBlendMode(pSurface.get(), static_cast<SDL_BlendMode>(entry.blendMode));
+
+    SDL_UnlockMutex(mutex);
+
+    return pSurface;
+}
+
+void ObjPicCache::store(unsigned int id, int house, unsigned int zoom, SDL_Surface* pSurface) {
+    if((pSurface == nullptr) || (pSurface->format->BytesPerPixel != 1) || (pSurface->format->palette == nullptr)) {
+        return;
+    }
+
+    Entry entry;
+    entry.w = pSurface->w;
+    entry.h = pSurface->h;
+
+    Uint32 colorKey;
+    entry.colorKey = (SDL_GetColorKey(pSurface, &colorKey) == 0) ? colorKey : NO_COLORKEY;
+
+    SDL_BlendMode blendMode;
+    SDL_GetSurfaceBlendMode(pSurface, &blendMode);
+    entry.blendMode = blendMode;
+
+    const SDL_Palette* pPalette = pSurface->format->palette;
+    entry.numColors = pPalette->ncolors;
+
+    std::vector<Uint8> data(entry.numColors * 4 + entry.w * entry.h);
+    for(Uint32 i = 0; i < entry.numColors; i++) {
+        data[4*i] = pPalette->colors[i].r;
+        data[4*i + 1] = pPalette->colors[i].g;
+        data[4*i + 2] = pPalette->colors[i].b;
+        data[4*i + 3] = pPalette->colors[i].a;
+    }
+
+    {
+        sdl2::surface_lock lock{ pSurface };
+        Uint8* pPixels = data.data() + entry.numColors * 4;
+        for(Uint32 y = 0; y < entry.h; y++) {
+            memcpy(pPixels + y * entry.w, static_cast<const Uint8*>(pSurface->pixels) + y * pSurface->pitch, entry.w);
+        }
+    }
+
+    SDL_LockMutex(mutex);
+
+    newData.push_back(std::move(data));
+    entry.pPalette = newData.back().data();
+    entry.pPixels = entry.pPalette + entry.numColors * 4;
+    entries[getKey(id, house, zoom)] = entry;
+    bChanged = true;
+
+    SDL_UnlockMutex(mutex);
+}
+
+void ObjPicCache::save() {
+    SDL_LockMutex(mutex);
+
+    if(bChanged) {
+        std::vector<Uint8> buffer(CACHE_MAGIC, CACHE_MAGIC + sizeof(CACHE_MAGIC));
+        appendUint32(buffer, CACHE_VERSION);
+        appendUint32(buffer, sourceKey.length());
+        buffer.insert(buffer.end(), sourceKey.begin(), sourceKey.end());
+        appendUint32(buffer, entries.size());
+
+        for(const auto& keyAndEntry : entries) {
+            const Entry& entry = keyAndEntry.second;
+            appendUint32(buffer, keyAndEntry.first);
+            appendUint32(buffer, entry.w);
+            appendUint32(buffer, entry.h);
+            appendUint32(buffer, entry.colorKey);
+            appendUint32(buffer, entry.blendMode);
+            appendUint32(buffer, entry.numColors);
+            buffer.insert(buffer.end(), entry.pPalette, entry.pPalette + entry.numColors * 4);
+            buffer.insert(buffer.end(), entry.pPixels, entry.pPixels + entry.w * entry.h);
+        }
+
+        // the file cannot be overwritten while it is mapped (at least on windows)
+        entries.clear();
+        newData.clear();
+        pMappedFile.reset();
+
+        auto pFile = sdl2::RWops_ptr{ SDL_RWFromFile(filepath.c_str(), "wb") };
+        if(!pFile || (SDL_RWwrite(pFile.get(), buffer.data(), buffer.size(), 1) != 1)) {
+            SDL_Log("ObjPicCache: Cannot write '%s'!", filepath.c_str());
+        }
+    }
+
+    entries.clear();
+    newData.clear();
+    pMappedFile.reset();
+    bChanged = false;
+
+    SDL_UnlockMutex(mutex);
+}
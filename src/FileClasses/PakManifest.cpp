@@ -0,0 +1,154 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <FileClasses/PakManifest.h>
+
+#include <misc/FileSystem.h>
+#include <misc/SDL2pp.h>
+#include <misc/md5.h>
+#include <misc/exceptions.h>
+
+#include <iomanip>
+#include <sstream>
+
+PakManifest::PakManifest(const std::string& manifestFilepath)
+ : manifestFilepath(manifestFilepath), verificationThread(nullptr) {
+    SDL_AtomicSet(&bQuit, 0);
+}
+
+PakManifest::~PakManifest() {
+    SDL_AtomicSet(&bQuit, 1);
+    waitForVerification();
+}
+
+void PakManifest::verifyInBackground(const std::vector<std::string>& filepaths) {
+    if(verificationThread != nullptr) {
+        THROW(std::runtime_error, "PakManifest::verifyInBackground(): The verification is already running!");
+    }
+
+    this->filepaths = filepaths;
+
+    verificationThread = SDL_CreateThread(verificationThreadMain, "PakManifest", (void*) this);
+    if(verificationThread == nullptr) {
+        // not worth failing for; the checksums are only logged
+        SDL_Log("PakManifest: Unable to create thread: %s", SDL_GetError());
+    }
+}
+
+void PakManifest::waitForVerification() {
+    if(verificationThread != nullptr) {
+        SDL_WaitThread(verificationThread, nullptr);
+        verificationThread = nullptr;
+    }
+}
+
+int PakManifest::verificationThreadMain(void* data) {
+    PakManifest* pPakManifest = static_cast<PakManifest*>(data);
+
+    try {
+        pPakManifest->verify();
+    } catch(std::exception& e) {
+        SDL_Log("PakManifest::verificationThreadMain(): %s", e.what());
+    }
+
+    return 0;
+}
+
+void PakManifest::verify() {
+    load();
+
+    bool bChanged = false;
+    for(const std::string& filepath : filepaths) {
+        if(SDL_AtomicGet(&bQuit) != 0) {
+            break;
+        }
+
+        Entry currentEntry;
+        if(getFileSizeAndModifyDate(filepath, currentEntry.size, currentEntry.modifydate) == false) {
+            SDL_Log("PakManifest: Cannot access '%s'!", filepath.c_str());
+            continue;
+        }
+
+        const auto iter = entries.find(filepath);
+        if((iter != entries.end()) && (iter->second.size == currentEntry.size) && (iter->second.modifydate == currentEntry.modifydate)) {
+            SDL_Log("%s  %s", iter->second.md5.c_str(), filepath.c_str());
+            continue;
+        }
+
+        currentEntry.md5 = md5FromFilename(filepath);
+        SDL_Log("%s  %s (changed)", currentEntry.md5.c_str(), filepath.c_str());
+
+        entries[filepath] = currentEntry;
+        bChanged = true;
+    }
+
+    if(bChanged) {
+        save();
+    }
+}
+
+void PakManifest::load() {
+    std::istringstream manifest(readCompleteFile(manifestFilepath));
+
+    std::string line;
+    while(std::getline(manifest, line)) {
+        if(line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        // <md5> <size> <modify date> <file path until the end of the line>
+        std::istringstream lineStream(line);
+        Entry entry;
+        std::string filepath;
+        if(!(lineStream >> entry.md5 >> entry.size >> entry.modifydate) || (lineStream.get() != ' ') || !std::getline(lineStream, filepath)) {
+            SDL_Log("PakManifest: Ignoring invalid line '%s' in '%s'!", line.c_str(), manifestFilepath.c_str());
+            continue;
+        }
+
+        entries[filepath] = entry;
+    }
+}
+
+void PakManifest::save() const {
+    std::ostringstream manifest;
+    manifest << "# MD5-Checksum, size and modification time of the PAK-Files" << std::endl;
+    for(const auto& entry : entries) {
+        manifest << entry.second.md5 << ' ' << entry.second.size << ' ' << entry.second.modifydate << ' ' << entry.first << std::endl;
+    }
+    const std::string data = manifest.str();
+
+    auto pFile = sdl2::RWops_ptr{ SDL_RWFromFile(manifestFilepath.c_str(), "wb") };
+    if(!pFile || (SDL_RWwrite(pFile.get(), data.c_str(), data.length(), 1) != 1)) {
+        SDL_Log("PakManifest: Cannot write '%s'!", manifestFilepath.c_str());
+    }
+}
+
+std::string PakManifest::md5FromFilename(const std::string& filepath) {
+    unsigned char md5sum[16];
+
+    if(md5_file(filepath.c_str(), md5sum) != 0) {
+        THROW(io_error, "Cannot open or read '%s'!", filepath);
+    }
+
+    std::stringstream stream;
+    stream << std::setfill('0') << std::hex;
+    for(int i : md5sum) {
+        stream << std::setw(2) << i;
+    }
+    return stream.str();
+}
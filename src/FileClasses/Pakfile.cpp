@@ -20,6 +20,7 @@
 #include <misc/SDL2pp.h>
 
 #include <stdlib.h>
+#include <string.h>
 #include <string>
 
 
@@ -36,16 +37,13 @@ Pakfile::Pakfile(const std::string& pakfilename, bool write)
 
     if(write == false) {
         // Open for reading
-        if( (fPakFile = SDL_RWFromFile(filename.c_str(), "rb")) == nullptr) {
-            THROW(std::invalid_argument, "Pakfile::Pakfile(): Cannot open " + pakfilename + "!");
-        }
-
         try {
-            readIndex();
+            pMappedFile = std::make_unique<MappedFile>(filename);
         } catch (std::exception&) {
-            SDL_RWclose(fPakFile);
-            throw;
+            THROW(std::invalid_argument, "Pakfile::Pakfile(): Cannot open " + pakfilename + "!");
         }
+
+        readIndex();
     } else {
         // Open for writing
         if( (fPakFile = SDL_RWFromFile(filename.c_str(), "wb")) == nullptr) {
@@ -171,45 +169,41 @@ void Pakfile::addFile(SDL_RWops* rwop, const std::string& filename) {
     \return SDL_RWops for this file
 */
 sdl2::RWops_ptr Pakfile::openFile(const std::string& filename) {
-    if(write == true) {
-        THROW(std::runtime_error, "Pakfile::openFile(): Writing files is not supported!");
-    }
-
     // find file
-    int index = -1;
     for(unsigned int i=0;i<fileEntries.size();i++) {
         if(filename == fileEntries[i].filename) {
-            index = i;
-            break;
+            return openFile(i);
         }
     }
 
-    if(index == -1) {
-        THROW(io_error, "Pakfile::openFile(): Cannot find file with name '%s' in this PAK file!", filename.c_str());
-    }
+    THROW(io_error, "Pakfile::openFile(): Cannot find file with name '%s' in this PAK file!", filename.c_str());
+}
 
-    // alloc RWop
-    SDL_RWops *pRWop;
-    if((pRWop = SDL_AllocRW()) == nullptr) {
-        throw std::bad_alloc();
+/// Opens a file in this PAK-File.
+/**
+    This method opens the nth file in this PAK-File. The returned SDL_RWops reads directly from the mapped PAK-File;
+    nothing is copied. The same restrictions as for openFile(const std::string&) apply.
+    \param  index   Index in pak-File
+    \return SDL_RWops for this file
+*/
+sdl2::RWops_ptr Pakfile::openFile(unsigned int index) {
+    if(write == true) {
+        THROW(std::runtime_error, "Pakfile::openFile(): Writing files is not supported!");
     }
 
-    // alloc RWopData
-    RWopData* pRWopData = new RWopData();
+    if(index >= fileEntries.size()) {
+        THROW(std::invalid_argument, "Pakfile::openFile(%ud): This Pakfile has only %ud entries!", index, fileEntries.size());
+    }
 
-    pRWop->type = PAKFILE_RWOP_TYPE;
-    pRWopData->curPakfile = this;
-    pRWopData->fileOffset = 0;
-    pRWopData->fileIndex = index;
+    const PakFileEntry& entry = fileEntries[index];
+    const int size = static_cast<int>(entry.endOffset + 1 - entry.startOffset);
 
-    pRWop->read = Pakfile::ReadFile;
-    pRWop->write = Pakfile::WriteFile;
-    pRWop->size = Pakfile::SizeFile;
-    pRWop->seek = Pakfile::SeekFile;
-    pRWop->close = Pakfile::CloseFile;
-    pRWop->hidden.unknown.data1 = (void*) pRWopData;
+    sdl2::RWops_ptr pRWop{ SDL_RWFromConstMem(pMappedFile->getData() + entry.startOffset, size) };
+    if(!pRWop) {
+        THROW(std::runtime_error, "Pakfile::openFile(): SDL_RWFromConstMem() failed: %s!", SDL_GetError());
+    }
 
-    return sdl2::RWops_ptr{ pRWop };
+    return pRWop;
 }
 
 bool Pakfile::exists(const std::string& filename) const {
@@ -223,166 +217,41 @@ bool Pakfile::exists(const std::string& filename) const {
 }
 
 
-size_t Pakfile::ReadFile(SDL_RWops* pRWop, void *ptr, size_t size, size_t n) {
-    if((pRWop == nullptr) || (ptr == nullptr) || (pRWop->hidden.unknown.data1 == nullptr)
-        || (pRWop->type != PAKFILE_RWOP_TYPE)) {
-            return 0;
-    }
-
-    int bytes2read = size*n;
-
-    RWopData* pRWopData = static_cast<RWopData*>(pRWop->hidden.unknown.data1);
-    Pakfile* pPakfile = pRWopData->curPakfile;
-    if(pPakfile == nullptr) {
-        return 0;
-    }
-
-    if(pRWopData->fileIndex >= pPakfile->fileEntries.size()) {
-        return 0;
-    }
-
-    uint32_t readstartoffset = pPakfile->fileEntries[pRWopData->fileIndex].startOffset + pRWopData->fileOffset;
-
-    if(readstartoffset > pPakfile->fileEntries[pRWopData->fileIndex].endOffset) {
-        return 0;
-    }
-
-    if(readstartoffset + bytes2read > pPakfile->fileEntries[pRWopData->fileIndex].endOffset) {
-        bytes2read = pPakfile->fileEntries[pRWopData->fileIndex].endOffset + 1 - readstartoffset;
-        // round to last full block
-        bytes2read /= size;
-        bytes2read *= size;
-        if(bytes2read == 0) {
-            return 0;
-        }
-    }
-
-    if(SDL_RWseek(pPakfile->fPakFile,readstartoffset,SEEK_SET) < 0) {
-        return 0;
-    }
-
-    if(SDL_RWread(pPakfile->fPakFile,ptr,bytes2read,1) != 1) {
-        return 0;
-    }
-
-    pRWopData->fileOffset += bytes2read;
-    return bytes2read/size;
-}
-
-size_t Pakfile::WriteFile(SDL_RWops *pRWop, const void *ptr, size_t size, size_t n) {
-    return 0;
-}
-
-Sint64 Pakfile::SizeFile(SDL_RWops *pRWop) {
-    if((pRWop == nullptr) || (pRWop->hidden.unknown.data1 == nullptr)
-        || (pRWop->type != PAKFILE_RWOP_TYPE)) {
-        return -1;
-    }
-
-    RWopData* pRWopData = static_cast<RWopData*>(pRWop->hidden.unknown.data1);
-    Pakfile* pPakfile = pRWopData->curPakfile;
-    if(pPakfile == nullptr) {
-        return -1;
-    }
-
-    if(pRWopData->fileIndex >= pPakfile->fileEntries.size()) {
-        return -1;
-    }
-
-    return static_cast<Sint64>(pPakfile->fileEntries[pRWopData->fileIndex].endOffset - pPakfile->fileEntries[pRWopData->fileIndex].startOffset + 1);
-}
-
-Sint64 Pakfile::SeekFile(SDL_RWops *pRWop, Sint64 offset, int whence) {
-    if((pRWop == nullptr) || (pRWop->hidden.unknown.data1 == nullptr)
-        || (pRWop->type != PAKFILE_RWOP_TYPE)) {
-        return -1;
-    }
-
-    RWopData* pRWopData = static_cast<RWopData*>(pRWop->hidden.unknown.data1);
-    Pakfile* pPakfile = pRWopData->curPakfile;
-    if(pPakfile == nullptr) {
-        return -1;
-    }
-
-    if(pRWopData->fileIndex >= pPakfile->fileEntries.size()) {
-        return -1;
-    }
-
-    Sint64 newOffset;
-
-    switch(whence) {
-        case SEEK_SET:
-        {
-            newOffset = offset;
-        } break;
-
-        case SEEK_CUR:
-        {
-            newOffset = pRWopData->fileOffset + offset;
-        } break;
-
-        case SEEK_END:
-        {
-            newOffset = pPakfile->fileEntries[pRWopData->fileIndex].endOffset - pPakfile->fileEntries[pRWopData->fileIndex].startOffset + 1 + offset;
-        } break;
-
-        default:
-        {
-            return -1;
-        } break;
-    }
-
-    if(newOffset > (pPakfile->fileEntries[pRWopData->fileIndex].endOffset - pPakfile->fileEntries[pRWopData->fileIndex].startOffset + 1)) {
-        return -1;
-    }
-
-    pRWopData->fileOffset = static_cast<size_t>(newOffset);
-    return newOffset;
-}
-
-int Pakfile::CloseFile(SDL_RWops *pRWop) {
-    if((pRWop == nullptr) || (pRWop->hidden.unknown.data1 == nullptr)
-        || (pRWop->type != PAKFILE_RWOP_TYPE)) {
-        return -1;
-    }
-
-    RWopData* pRWopData = static_cast<RWopData*>(pRWop->hidden.unknown.data1);
-    delete pRWopData;
-    pRWop->hidden.unknown.data1 = nullptr;
-    SDL_FreeRW(pRWop);
-    return 0;
-}
-
 void Pakfile::readIndex()
 {
+    const Uint8* pData = pMappedFile->getData();
+    const size_t filesize = pMappedFile->getSize();
+    size_t pos = 0;
+
     while(1) {
         PakFileEntry newEntry;
 
-        if(SDL_RWread(fPakFile,(void*) &newEntry.startOffset, sizeof(newEntry.startOffset), 1) != 1) {
-            THROW(std::runtime_error, "Pakfile::readIndex(): SDL_RWread() failed!");
+        if(pos + sizeof(newEntry.startOffset) > filesize) {
+            THROW(std::runtime_error, "Pakfile::readIndex(): Unexpected end of file!");
         }
 
         //pak-files are always little endian encoded
+        memcpy(&newEntry.startOffset, pData + pos, sizeof(newEntry.startOffset));
         newEntry.startOffset = SDL_SwapLE32(newEntry.startOffset);
         newEntry.endOffset = 0;
+        pos += sizeof(newEntry.startOffset);
 
         if(newEntry.startOffset == 0) {
             break;
         }
 
-        while(1) {
-            char tmp;
-            if(SDL_RWread(fPakFile,&tmp,1,1) != 1) {
-                THROW(std::runtime_error, "Pakfile::readIndex(): SDL_RWread() failed!");
-            }
-
-            if(tmp == '\0') {
-                break;
-            } else {
-                newEntry.filename += tmp;
-            }
+        if(newEntry.startOffset > filesize) {
+            THROW(std::runtime_error, "Pakfile::readIndex(): Invalid file offset!");
         }
 
+        const Uint8* pNameEnd = static_cast<const Uint8*>(memchr(pData + pos, '\0', filesize - pos));
+        if(pNameEnd == nullptr) {
+            THROW(std::runtime_error, "Pakfile::readIndex(): Unexpected end of file!");
+        }
+
+        newEntry.filename.assign(reinterpret_cast<const char*>(pData + pos), pNameEnd - (pData + pos));
+        pos = (pNameEnd - pData) + 1;
+
         if(fileEntries.empty() == false) {
             fileEntries.back().endOffset = newEntry.startOffset - 1;
         }
@@ -390,10 +259,16 @@ void Pakfile::readIndex()
         fileEntries.push_back(newEntry);
     }
 
-    Sint64 filesize = SDL_RWsize(fPakFile);
-    if(filesize < 0) {
-        THROW(std::runtime_error, "Pakfile::readIndex(): SDL_RWsize() failed!");
+    if(fileEntries.empty() == false) {
+        fileEntries.back().endOffset = static_cast<uint32_t>(filesize) - 1;
     }
 
-    fileEntries.back().endOffset = static_cast<size_t>(filesize) - 1;
+    // the files are stored behind the index in the order of their entries; otherwise endOffset + 1 - startOffset would wrap around
+    size_t previousOffset = pos;
+    for(const PakFileEntry& entry : fileEntries) {
+        if(entry.startOffset < previousOffset) {
+            THROW(std::runtime_error, "Pakfile::readIndex(): Invalid file offset!");
+        }
+        previousOffset = entry.startOffset;
+    }
 }
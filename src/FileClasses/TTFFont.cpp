@@ -78,3 +78,27 @@ int TTFFont::getTextWidth(const std::string& text) const {
     return width;
 }
 
+/// Returns the horizontal metrics of a single glyph
+/**
+    This methods returns where a glyph is drawn relative to the pen position and how far the pen advances after it.
+    \param  character   The unicode character of the glyph
+    \param  minX        The leftmost pixel of the glyph relative to the pen position
+    \param  advance     The number of pixels the pen advances after this glyph
+*/
+void TTFFont::getGlyphMetrics(Uint16 character, int& minX, int& advance) const {
+    int maxX, minY, maxY;
+    if(TTF_GlyphMetrics(pTTFFont.get(), character, &minX, &maxX, &minY, &maxY, &advance) < 0) {
+        THROW(std::invalid_argument, "TTFFont::getGlyphMetrics(): TTF_GlyphMetrics() failed: %s!", TTF_GetError());
+    }
+}
+
+/// Returns the kerning between two glyphs
+/**
+    This methods returns the number of pixels the pen is moved additionally if character follows previous.
+    \param  previous    The unicode character of the first glyph
+    \param  character   The unicode character of the second glyph
+    \return Number of pixels (may be negative)
+*/
+int TTFFont::getKerning(Uint16 previous, Uint16 character) const {
+    return TTF_GetFontKerningSizeGlyphs(pTTFFont.get(), previous, character);
+}
@@ -0,0 +1,100 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FlowField.h>
+
+#include <Map.h>
+
+#include <functional>
+#include <queue>
+#include <utility>
+
+FlowField::FlowField(Map* pMap, const Coord& destination, TileAttributes::MovementClass movementClass)
+ : destination(destination), movementClass(movementClass), terrainVersion(pMap->getTileAttributes().getTerrainVersion()),
+   sizeX(pMap->getSizeX()), sizeY(pMap->getSizeY()) {
+
+    integrationField.assign(sizeX*sizeY, FixPt_MAX);
+    directionField.assign(sizeX*sizeY, INVALID);
+
+    // Dijkstra search backwards from the destination; ties are broken by the tile index to be deterministic
+    typedef std::pair<FixPoint, int> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> openList;
+
+    integrationField[getIndex(destination.x, destination.y)] = 0;
+    openList.emplace(0, getIndex(destination.x, destination.y));
+
+    while(!openList.empty()) {
+        const QueueEntry entry = openList.top();
+        openList.pop();
+
+        const int index = entry.second;
+        if(entry.first > integrationField[index]) {
+            // outdated entry
+            continue;
+        }
+
+        const Coord current(index % sizeX, index / sizeX);
+
+        // every unit entering the current tile pays the cost of its terrain
+        const TileAttributes& tileAttributes = pMap->getTileAttributes();
+        const FixPoint terrainDifficulty = TileAttributes::toTerrainDifficulty(TileAttributes::getTerrainCost(movementClass, tileAttributes.getType(current.x, current.y)));
+
+        for(int angle = 0; angle < NUM_ANGLES; angle++) {
+            const Coord previous = Map::getMapPos(angle, current);
+            if(!pMap->tileExists(previous)) {
+                continue;
+            }
+
+            if((tileAttributes.isMountain(previous.x, previous.y) && (movementClass != TileAttributes::Movement_Infantry)) || tileAttributes.hasAStructure(previous.x, previous.y)) {
+                continue;
+            }
+
+            const bool bDiagonal = (previous.x != current.x) && (previous.y != current.y);
+            const FixPoint cost = entry.first + (bDiagonal ? FixPt_SQRT2*terrainDifficulty : terrainDifficulty);
+
+            const int previousIndex = getIndex(previous.x, previous.y);
+            if(cost < integrationField[previousIndex]) {
+                integrationField[previousIndex] = cost;
+                directionField[previousIndex] = (angle + NUM_ANGLES/2) % NUM_ANGLES;
+                openList.emplace(cost, previousIndex);
+            }
+        }
+    }
+}
+
+FlowField::~FlowField() = default;
+
+Coord FlowField::getNextSpot(const Coord& location) const {
+    if((location.x < 0) || (location.x >= sizeX) || (location.y < 0) || (location.y >= sizeY)) {
+        return Coord::Invalid();
+    }
+
+    const Sint8 angle = directionField[getIndex(location.x, location.y)];
+    if(angle == INVALID) {
+        return Coord::Invalid();
+    }
+
+    return Map::getMapPos(angle, location);
+}
+
+FixPoint FlowField::getCost(const Coord& location) const {
+    if((location.x < 0) || (location.x >= sizeX) || (location.y < 0) || (location.y >= sizeY)) {
+        return FixPt_MAX;
+    }
+
+    return integrationField[getIndex(location.x, location.y)];
+}
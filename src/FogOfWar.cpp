@@ -0,0 +1,215 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FogOfWar.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <House.h>
+#include <Map.h>
+#include <ObjectBase.h>
+#include <mmath.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+FogOfWar::FogOfWar(Map* pMap) : pMap(pMap) {
+    reset();
+}
+
+FogOfWar::~FogOfWar() = default;
+
+void FogOfWar::reset() {
+    sizeX = pMap->getSizeX();
+    sizeY = pMap->getSizeY();
+
+    observers.clear();
+    for(auto& viewCountOfHouse : viewCount) {
+        viewCountOfHouse.assign(sizeX*sizeY, 0);
+    }
+}
+
+void FogOfWar::rebuild() {
+    reset();
+
+    for(int x = 0; x < sizeX; x++) {
+        for(int y = 0; y < sizeY; y++) {
+            const Tile* pTile = pMap->getTile(x, y);
+
+            const auto registerObserver = [&](Uint32 objectID) {
+                const ObjectBase* pObject = currentGame->getObjectManager().getObject(objectID);
+
+                // a moving unit is assigned to two tiles and a structure to all tiles it covers
+                if((pObject != nullptr) && (pObject->getLocation() == pTile->getLocation())) {
+                    updateObserver(objectID, pObject->getOwner()->getHouseID(), pObject->getLocation(), pObject->getViewRange());
+                }
+            };
+
+            std::for_each(pTile->getInfantryList().begin(), pTile->getInfantryList().end(), registerObserver);
+            std::for_each(pTile->getNonInfantryGroundObjectList().begin(), pTile->getNonInfantryGroundObjectList().end(), registerObserver);
+        }
+    }
+}
+
+void FogOfWar::updateObserver(Uint32 objectID, int houseID, const Coord& location, int viewRange) {
+    if(objectID == NONE_ID) {
+        return;
+    }
+
+    if(!pMap->tileExists(location)) {
+        removeObserver(objectID);
+        return;
+    }
+
+    if(objectID >= observers.size()) {
+        observers.resize(objectID + 1);
+    }
+
+    Observer& observer = observers[objectID];
+
+    if(observer.location.isValid() && (observer.houseID == houseID) && (observer.viewRange == viewRange)) {
+        const int dx = location.x - observer.location.x;
+        const int dy = location.y - observer.location.y;
+
+        if((dx == 0) && (dy == 0)) {
+            return;
+        }
+
+        if((std::abs(dx) <= 1) && (std::abs(dy) <= 1)) {
+            // the usual case: the observer moved to a neighbour tile
+            const Stamp& stamp = getStamp(viewRange);
+            for(const Coord& offset : stamp.enteringTiles[getStepIndex(dx, dy)]) {
+                addView(houseID, location + offset);
+            }
+            for(const Coord& offset : stamp.leavingTiles[getStepIndex(dx, dy)]) {
+                removeView(houseID, location + offset);
+            }
+            observer.location = location;
+            return;
+        }
+    }
+
+    Observer newObserver;
+    newObserver.location = location;
+    newObserver.houseID = houseID;
+    newObserver.viewRange = viewRange;
+
+    // add the new view first so that tiles seen before and after are not unseen in between
+    addObserver(newObserver);
+    if(observer.location.isValid()) {
+        removeObserver(observer);
+    }
+    observer = newObserver;
+}
+
+void FogOfWar::changeObserverHouse(Uint32 objectID, int houseID, int viewRange) {
+    if((objectID >= observers.size()) || observers[objectID].location.isInvalid()) {
+        return;
+    }
+
+    updateObserver(objectID, houseID, observers[objectID].location, viewRange);
+}
+
+void FogOfWar::removeObserver(Uint32 objectID) {
+    if((objectID >= observers.size()) || observers[objectID].location.isInvalid()) {
+        return;
+    }
+
+    removeObserver(observers[objectID]);
+    observers[objectID] = Observer();
+}
+
+const FogOfWar::Stamp& FogOfWar::getStamp(int viewRange) {
+    if(viewRange >= static_cast<int>(stamps.size())) {
+        stamps.resize(viewRange + 1);
+    }
+
+    if(stamps[viewRange] != nullptr) {
+        return *stamps[viewRange];
+    }
+
+    // the same area as Map::viewMap()
+    const auto isInView = [viewRange](const Coord& offset) {
+        const auto distance = viewRange <= 1 ? maximumDistance(Coord(0, 0), offset) : blockDistanceApprox(Coord(0, 0), offset);
+        return distance <= viewRange;
+    };
+
+    auto pStamp = std::make_unique<Stamp>();
+
+    Coord offset;
+    for(offset.y = -viewRange; offset.y <= viewRange; offset.y++) {
+        for(offset.x = -viewRange; offset.x <= viewRange; offset.x++) {
+            if(isInView(offset)) {
+                pStamp->tiles.push_back(offset);
+            }
+        }
+    }
+
+    for(int dy = -1; dy <= 1; dy++) {
+        for(int dx = -1; dx <= 1; dx++) {
+            const Coord step(dx, dy);
+            for(const Coord& tileOffset : pStamp->tiles) {
+                // relative to the old location this tile is at tileOffset + step
+                if(!isInView(tileOffset + step)) {
+                    pStamp->enteringTiles[getStepIndex(dx, dy)].push_back(tileOffset);
+                }
+
+                // a tile at tileOffset of the old location is at tileOffset - step relative to the new location
+                if(!isInView(tileOffset - step)) {
+                    pStamp->leavingTiles[getStepIndex(dx, dy)].push_back(tileOffset - step);
+                }
+            }
+        }
+    }
+
+    stamps[viewRange] = std::move(pStamp);
+    return *stamps[viewRange];
+}
+
+void FogOfWar::addObserver(const Observer& observer) {
+    for(const Coord& offset : getStamp(observer.viewRange).tiles) {
+        addView(observer.houseID, observer.location + offset);
+    }
+}
+
+void FogOfWar::removeObserver(const Observer& observer) {
+    for(const Coord& offset : getStamp(observer.viewRange).tiles) {
+        removeView(observer.houseID, observer.location + offset);
+    }
+}
+
+void FogOfWar::addView(int houseID, const Coord& location) {
+    if(!pMap->tileExists(location)) {
+        return;
+    }
+
+    if(viewCount[houseID][location.y * sizeX + location.x]++ == 0) {
+        pMap->getTile(location)->setExplored(houseID, currentGame->getGameCycleCount());
+    }
+}
+
+void FogOfWar::removeView(int houseID, const Coord& location) {
+    if(!pMap->tileExists(location)) {
+        return;
+    }
+
+    if(--viewCount[houseID][location.y * sizeX + location.x] == 0) {
+        // remember when this tile was seen last; it gets fogged FOGTIME cycles from now
+        pMap->getTile(location)->setExplored(houseID, currentGame->getGameCycleCount());
+    }
+}
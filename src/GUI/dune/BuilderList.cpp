@@ -249,9 +249,7 @@ void BuilderList::draw(Point position) {
                 }
 
                 // draw price
-                sdl2::texture_ptr pPriceTexture = pFontManager->createTextureWithText(fmt::sprintf("%d", buildItem.price), COLOR_WHITE, 12);
-                SDL_Rect drawLocation = calcDrawingRect(pPriceTexture.get(), dest.x + 2, dest.y + BUILDERBTN_HEIGHT - getHeight(pPriceTexture.get()) + 3);
-                SDL_RenderCopy(renderer, pPriceTexture.get(), nullptr, &drawLocation);
+                pFontManager->drawText(fmt::sprintf("%d", buildItem.price), COLOR_WHITE, 12, dest.x + 2, dest.y + BUILDERBTN_HEIGHT + 2, HAlign::Left, VAlign::Bottom);
 
                 if(pStarport != nullptr) {
                     bool bSoldOut = (pStarport->getOwner()->getChoam().getNumAvailable(buildItem.itemID) == 0);
@@ -295,9 +293,7 @@ void BuilderList::draw(Point position) {
 
                 if(buildItem.num > 0) {
                     // draw number of this in build list
-                    sdl2::texture_ptr pNumberTexture = pFontManager->createTextureWithText(fmt::sprintf("%d", buildItem.num), COLOR_RED, 12);
-                    SDL_Rect drawLocationNumber = calcDrawingRect(pNumberTexture.get(), dest.x + BUILDERBTN_WIDTH - 3, dest.y + BUILDERBTN_HEIGHT + 2, HAlign::Right, VAlign::Bottom);
-                    SDL_RenderCopy(renderer, pNumberTexture.get(), nullptr, &drawLocationNumber);
+                    pFontManager->drawText(fmt::sprintf("%d", buildItem.num), COLOR_RED, 12, dest.x + BUILDERBTN_WIDTH - 3, dest.y + BUILDERBTN_HEIGHT + 2, HAlign::Right, VAlign::Bottom);
                 }
             }
 
@@ -139,6 +139,8 @@ void InGameMenu::onChildWindowClose(Window* pChildWindow) {
             if(bSave == false) {
                 // load window
                 try {
+                    // the file might be the savegame that is still being written in the background
+                    currentGame->waitForSaveGame();
                     currentGame->setNextGameInitSettings(GameInitSettings(FileName));
                 } catch (std::exception& e) {
                     // most probably the savegame file is not valid or from a different dune legacy version
@@ -31,6 +31,7 @@
 #include <misc/IFileStream.h>
 #include <misc/OFileStream.h>
 #include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
 #include <misc/FileSystem.h>
 #include <misc/fnkdat.h>
 #include <misc/draw_util.h>
@@ -68,6 +69,9 @@
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
 
 Game::Game() {
     currentZoomlevel = settings.video.preferredZoomLevel;
@@ -102,6 +106,7 @@ Game::~Game() {
         pNetworkManager->setOnReceiveCommandList(std::function<void (const std::string&, const CommandList&)>());
         pNetworkManager->setOnReceiveSelectionList(std::function<void (const std::string&, const std::set<Uint32>&, int)>());
         pNetworkManager->setOnPeerDisconnected(std::function<void (const std::string&, bool, int)>());
+        pNetworkManager->setOnReceiveStateHash(std::function<void (const std::string&, Uint32, Uint64)>());
     }
 
     for(StructureBase* pStructure : structureList) {
@@ -139,6 +144,8 @@ void Game::initGame(const GameInitSettings& newGameInitSettings) {
             if(loadSaveGame(gameInitSettings.getFilename()) == false) {
                 THROW(std::runtime_error, "Loading save game failed!");
             }
+
+            prefetchHouseGraphics();
         } break;
 
         case GameType::LoadMultiplayer: {
@@ -147,6 +154,8 @@ void Game::initGame(const GameInitSettings& newGameInitSettings) {
             if(loadSaveGame(memStream) == false) {
                 THROW(std::runtime_error, "Loading save game failed!");
             }
+
+            prefetchHouseGraphics();
         } break;
 
         case GameType::Campaign:
@@ -164,6 +173,8 @@ void Game::initGame(const GameInitSettings& newGameInitSettings) {
 
             INIMapLoader(this, gameInitSettings.getFilename(), gameInitSettings.getFiledata());
 
+            prefetchHouseGraphics();
+
             if(bReplay == false && gameInitSettings.getGameType() != GameType::CustomGame && gameInitSettings.getGameType() != GameType::CustomMultiplayer) {
                 /* do briefing */
                 SDL_Log("Briefing...");
@@ -176,7 +187,19 @@ void Game::initGame(const GameInitSettings& newGameInitSettings) {
     }
 }
 
-void Game::initReplay(const std::string& filename) {
+void Game::prefetchHouseGraphics() const {
+    if(pGFXManager == nullptr) {
+        return;
+    }
+
+    for(int i = 0; i < NUM_HOUSES; i++) {
+        if(house[i] != nullptr) {
+            pGFXManager->prefetchObjPics(i);
+        }
+    }
+}
+
+void Game::initReplay(const std::string& filename, Uint32 seekCycle) {
     bReplay = true;
 
     IFileStream fs;
@@ -191,23 +214,216 @@ void Game::initReplay(const std::string& filename) {
     // read GameInitInfo
     GameInitSettings loadedGameInitSettings(fs);
 
-    // load all commands
-    cmdManager.load(fs);
+    // load all commands and keyframes
+    cmdManager.load(fs, &replayKeyframes);
+
+    const Uint32 keyframeCycle = replayKeyframes.findKeyframe(seekCycle);
+    if(keyframeCycle == 0) {
+        initGame(loadedGameInitSettings);
+    } else {
+        // start at the keyframe; the commands are already loaded from the replay file (see loadSaveGame())
+        gameInitSettings = loadedGameInitSettings;
+
+        const std::string savegame = replayKeyframes.getSavegame(keyframeCycle);
+        IMemoryStream memStream(savegame.c_str(), savegame.size());
+        if(loadSaveGame(memStream) == false) {
+            THROW(std::runtime_error, "Loading keyframe of cycle %d failed!", keyframeCycle);
+        }
 
-    initGame(loadedGameInitSettings);
+        prefetchHouseGraphics();
+    }
+
+    skipToGameCycle = seekCycle;
 }
 
+void Game::seekReplay(Uint32 seekCycle) {
+    const Uint32 keyframeCycle = replayKeyframes.findKeyframe(seekCycle);
 
-void Game::processObjects()
-{
-    // update all tiles
-    for(int y = 0; y < currentGameMap->getSizeY(); y++) {
-        for(int x = 0; x < currentGameMap->getSizeX(); x++) {
-            currentGameMap->getTile(x,y)->update();
+    if((seekCycle >= gameCycleCount) && (keyframeCycle <= gameCycleCount)) {
+        // there is no keyframe between now and seekCycle => just simulate the remaining cycles
+        skipToGameCycle = seekCycle;
+    } else {
+        // restart the replay at the keyframe (see startReplay())
+        bReplaySeekRequested = true;
+        replaySeekCycle = seekCycle;
+        quitGame();
+    }
+}
+
+void Game::skipGameTime(Uint32 numCycles) {
+    if(bReplay) {
+        // replays can also go back in time (with shift) by restarting at an earlier keyframe
+        if(SDL_GetModState() & KMOD_SHIFT) {
+            seekReplay((gameCycleCount > numCycles) ? (gameCycleCount - numCycles) : 0);
+        } else {
+            seekReplay(gameCycleCount + numCycles);
+        }
+    } else if(gameType != GameType::CustomMultiplayer) {
+        skipToGameCycle = gameCycleCount + numCycles;
+    }
+}
+
+Uint64 Game::calculateStateHash() const {
+    StateHash hash = stateHash;
+
+    const auto addObject = [&hash](const ObjectBase* pObject) {
+        hash.add(StateHash::Category_ObjectHealth, pObject->getObjectID(), pObject->getHealth().getRawValue());
+        hash.add(StateHash::Category_ObjectPosition, 2*pObject->getObjectID(), pObject->getRealX().getRawValue());
+        hash.add(StateHash::Category_ObjectPosition, 2*pObject->getObjectID() + 1, pObject->getRealY().getRawValue());
+    };
+
+    for(const StructureBase* pStructure : structureList) {
+        addObject(pStructure);
+    }
+
+    for(const UnitBase* pUnit : unitList) {
+        addObject(pUnit);
+    }
+
+    hash.add(StateHash::Category_Random, 0, randomGen.getSeed());
+
+    return hash.getHash();
+}
+
+void Game::exchangeStateHash() {
+    const Uint64 hash = calculateStateHash();
+
+    localStateHashes[gameCycleCount] = hash;
+
+    // the peers are at most a few seconds apart
+    while(localStateHashes.size() > 16) {
+        localStateHashes.erase(localStateHashes.begin());
+    }
+
+    pNetworkManager->sendStateHash(gameCycleCount, hash);
+
+    // compare the hashes that were received before we reached their game cycle
+    std::list<std::tuple<std::string, Uint32, Uint64>> stateHashes;
+    stateHashes.swap(pendingStateHashes);
+    for(const auto& pendingHash : stateHashes) {
+        compareStateHash(std::get<0>(pendingHash), std::get<1>(pendingHash), std::get<2>(pendingHash));
+    }
+
+    if(desyncDumpCycle == gameCycleCount) {
+        char tmp[FILENAME_MAX];
+        fnkdat(fmt::sprintf("desync/state_%d_%s.txt", gameCycleCount, getLocalPlayerName()).c_str(), tmp, FILENAME_MAX, FNKDAT_USER | FNKDAT_CREAT);
+        dumpState(tmp);
+    }
+}
+
+void Game::compareStateHash(const std::string& name, Uint32 gameCycle, Uint64 hash) {
+    const auto iter = localStateHashes.find(gameCycle);
+    if(iter == localStateHashes.end()) {
+        if(gameCycle > gameCycleCount) {
+            pendingStateHashes.emplace_back(name, gameCycle, hash);
+        } else {
+            SDL_Log("Game::compareStateHash(): The state hash of '%s' for game cycle %d arrived too late", name.c_str(), gameCycle);
+        }
+        return;
+    }
+
+    if((iter->second == hash) || bDesyncDetected) {
+        return;
+    }
+
+    bDesyncDetected = true;
+
+    SDL_Log("Warning: Game is asynchronous to '%s' in game cycle %d! State hashes do not match: 0x%016llX != 0x%016llX",
+            name.c_str(), gameCycle, (unsigned long long) iter->second, (unsigned long long) hash);
+    addToNewsTicker(fmt::sprintf(_("Game is out of sync with %s!"), name));
+
+    // all peers detect the desync within a few cycles and dump their state at the next check to make the dumps comparable
+    desyncDumpCycle = (gameCycleCount / STATEHASH_INTERVAL + 1) * STATEHASH_INTERVAL;
+}
+
+void Game::dumpState(const std::string& filename) const {
+    FILE* pFile = fopen(filename.c_str(), "w");
+    if(pFile == nullptr) {
+        SDL_Log("Game::dumpState(): Cannot open '%s': %s", filename.c_str(), strerror(errno));
+        return;
+    }
+
+    // all fixed point values are written as raw values so that even the smallest difference shows up
+    fprintf(pFile, "cycle %u\n", gameCycleCount);
+    fprintf(pFile, "seed %u\n", randomGen.getSeed());
+    for(int category = 0; category < StateHash::NUM_CATEGORIES; category++) {
+        fprintf(pFile, "hash %s 0x%016llX\n", StateHash::getCategoryName(static_cast<StateHash::Category>(category)),
+                (unsigned long long) stateHash.getHash(static_cast<StateHash::Category>(category)));
+    }
+
+    for(int i = 0; i < NUM_HOUSES; i++) {
+        if(house[i] != nullptr) {
+            fprintf(pFile, "house %d credits %lld %lld\n", i,
+                    (long long) house[i]->getStoredCredits().getRawValue(), (long long) house[i]->getStartingCredits().getRawValue());
+        }
+    }
+
+    // sorted by object id
+    std::map<Uint32, const ObjectBase*> objects;
+    for(const StructureBase* pStructure : structureList) {
+        objects[pStructure->getObjectID()] = pStructure;
+    }
+    for(const UnitBase* pUnit : unitList) {
+        objects[pUnit->getObjectID()] = pUnit;
+    }
+    for(const auto& object : objects) {
+        const ObjectBase* pObject = object.second;
+        fprintf(pFile, "object %u item %d house %d position %lld %lld health %lld\n",
+                object.first, pObject->getItemID(), pObject->getOwner()->getHouseID(),
+                (long long) pObject->getRealX().getRawValue(), (long long) pObject->getRealY().getRawValue(),
+                (long long) pObject->getHealth().getRawValue());
+    }
+
+    for(int x = 0; x < currentGameMap->getSizeX(); x++) {
+        for(int y = 0; y < currentGameMap->getSizeY(); y++) {
+            const FixPoint spice = currentGameMap->getTile(x, y)->getSpice();
+            if(spice != 0) {
+                fprintf(pFile, "tile %d %d spice %lld\n", x, y, (long long) spice.getRawValue());
+            }
         }
     }
 
+    fclose(pFile);
+
+    SDL_Log("Game state of game cycle %d written to '%s'", gameCycleCount, filename.c_str());
+}
+
+void Game::recordReplayKeyframe() {
+    if(cmdManager.getStream() == nullptr) {
+        return;
+    }
+
+    // the last keyframe had KEYFRAME_INTERVAL game cycles to be compressed, so this hardly ever waits
+    replayKeyframes.waitForCompletion();
+    writeFinishedReplayKeyframe();
+
+    // the commands are in the replay file anyway
+    saveGame(replayKeyframes.getBuffer(), false);
+    replayKeyframes.addInBackground(gameCycleCount);
+}
+
+void Game::writeFinishedReplayKeyframe() {
+    const Uint32 keyframeCycle = replayKeyframes.pollFinished();
+
+    OutputStream* pReplayStream = cmdManager.getStream();
+    if((keyframeCycle != 0) && (pReplayStream != nullptr)) {
+        // the keyframe may follow commands of later cycles; CommandManager::load() does not mind
+        replayKeyframes.save(*pReplayStream, keyframeCycle);
+        pReplayStream->flush();
+    }
+}
+
+
+void Game::processObjects()
+{
+    // update the tiles with dead units
+    currentGameMap->updateActiveTiles();
+
+    // tiles that get fogged in this cycle have to be repainted on the radar
+    currentGameMap->getRadarChangeFeed().update(gameCycleCount);
+
     for(StructureBase* pStructure : structureList) {
+        CycleProfiler::ItemTimer timer(cycleProfiler, pStructure->getItemID());
         pStructure->update();
     }
 
@@ -216,6 +432,7 @@ void Game::processObjects()
     }
 
     for(UnitBase* pUnit : unitList) {
+        CycleProfiler::ItemTimer timer(cycleProfiler, pUnit->getItemID());
         pUnit->update();
     }
 
@@ -245,8 +462,16 @@ void Game::drawScreen()
     const auto x2 = BottomRightTile.x + 1;
     const auto y2 = BottomRightTile.y + 1;
 
+    // the map and everything on it is drawn through the sprite batch; sprites from the object picture atlas
+    // are collected and drawn with one draw call per atlas page
+    spriteBatch.setAtlas(pGFXManager->getObjPicAtlas(currentZoomlevel));
+    spriteBatch.resetStatistics();
+
     /* draw ground */
 
+    // the terrain is prerendered into chunks; only tracks and damage are drawn per tile
+    terrainChunkCache.draw(*currentGameMap, spriteBatch, x1, y1, x2, y2);
+
     currentGameMap->for_each(x1, y1, x2, y2,
         [](Tile& t) {
             t.blitGround(screenborder->world2screenX(t.getLocation().x*TILESIZE),
@@ -306,6 +531,9 @@ void Game::drawScreen()
                 screenborder->world2screenY(t.getLocation().y*TILESIZE));
         });
 
+    // lines and selection boxes are drawn directly
+    spriteBatch.flush();
+
     // draw the gathering point line if a structure is selected
     if(selectedList.size() == 1) {
         StructureBase *pStructure = dynamic_cast<StructureBase*>(getObjectManager().getObject(*selectedList.begin()));
@@ -343,7 +571,7 @@ void Game::drawScreen()
                             SDL_Rect source = { hideTile*zoomedTileSize, 0, zoomedTileSize, zoomedTileSize };
                             SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
                                                         zoomedTileSize, zoomedTileSize };
-                            SDL_RenderCopy(renderer, hiddenTexZoomed, &source, &drawLocation);
+                            spriteBatch.copy(hiddenTexZoomed, &source, &drawLocation);
                         }
 
                         if(gameInitSettings.getGameOptions().fogOfWar == true) {
@@ -359,7 +587,7 @@ void Game::drawScreen()
                                 SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
                                                             zoomedTileSize, zoomedTileSize };
 
-                                SDL_RenderCopy(renderer, hiddenFogTexZoomed, &source, &drawLocation);
+                                spriteBatch.copy(hiddenFogTexZoomed, &source, &drawLocation);
                             }
                         }
                     } else {
@@ -367,7 +595,7 @@ void Game::drawScreen()
                             SDL_Rect source = { zoomedTileSize*15, 0, zoomedTileSize, zoomedTileSize };
                             SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
                                                         zoomedTileSize, zoomedTileSize };
-                            SDL_RenderCopy(renderer, hiddenTexZoomed, &source, &drawLocation);
+                            spriteBatch.copy(hiddenTexZoomed, &source, &drawLocation);
                         }
                     }
                 } else {
@@ -375,12 +603,15 @@ void Game::drawScreen()
                     SDL_Rect source = { zoomedTileSize*15, 0, zoomedTileSize, zoomedTileSize };
                     SDL_Rect drawLocation = {   screenborder->world2screenX(x*TILESIZE), screenborder->world2screenY(y*TILESIZE),
                                                 zoomedTileSize, zoomedTileSize };
-                    SDL_RenderCopy(renderer, hiddenTexZoomed, &source, &drawLocation);
+                    spriteBatch.copy(hiddenTexZoomed, &source, &drawLocation);
                 }
             }
         }
     }
 
+    spriteBatch.setAtlas(nullptr);
+    cycleProfiler.addSpriteBatch(spriteBatch.getNumSprites(), spriteBatch.getNumDrawCalls());
+
 /////////////draw placement position
 
     if(currentCursorMode == CursorMode_Placing) {
@@ -495,27 +726,25 @@ void Game::drawScreen()
 
     // draw chat message currently typed
     if(chatMode) {
-        sdl2::texture_ptr pChatTexture = pFontManager->createTextureWithText("Chat: " + typingChatMessage + (((SDL_GetTicks() / 150) % 2 == 0) ? "_" : ""), COLOR_WHITE, 14);
-        SDL_Rect drawLocation = calcDrawingRect(pChatTexture.get(), 20, getRendererHeight() - 40);
-        SDL_RenderCopy(renderer, pChatTexture.get(), nullptr, &drawLocation);
+        pFontManager->drawText("Chat: " + typingChatMessage + (((SDL_GetTicks() / 150) % 2 == 0) ? "_" : ""), COLOR_WHITE, 14, 20, getRendererHeight() - 40);
     }
 
     if(bShowFPS) {
         std::string strFPS = fmt::sprintf("fps: %.1f ", 1000.0f/averageFrameTime);
 
-        sdl2::texture_ptr pFPSTexture = pFontManager->createTextureWithText(strFPS, COLOR_WHITE, 14);
-        SDL_Rect drawLocation = calcDrawingRect(pFPSTexture.get(),sideBarPos.x - strFPS.length()*8, 60);
-        SDL_RenderCopy(renderer, pFPSTexture.get(), nullptr, &drawLocation);
+        pFontManager->drawText(strFPS, COLOR_WHITE, 14, sideBarPos.x - strFPS.length()*8, 60);
+    }
+
+    if(bShowCycleProfiler) {
+        cycleProfiler.draw(sideBarPos.x - 8, 80);
     }
 
     if(bShowTime) {
         int seconds = getGameTime() / 1000;
         std::string strTime = fmt::sprintf(" %.2d:%.2d:%.2d", seconds / 3600, (seconds % 3600)/60, (seconds % 60) );
 
-        sdl2::texture_ptr pTimeTexture = pFontManager->createTextureWithText(strTime, COLOR_WHITE, 14);
-        SDL_Rect drawLocation = calcAlignedDrawingRect(pTimeTexture.get(), HAlign::Left, VAlign::Bottom);
-        drawLocation.y++;
-        SDL_RenderCopy(renderer, pTimeTexture.get(), nullptr, &drawLocation);
+        // one pixel lower than aligned to the bottom of the screen
+        pFontManager->drawText(strTime, COLOR_WHITE, 14, 0, getRendererHeight(), HAlign::Left, VAlign::Bottom);
     }
 
     if(finished) {
@@ -527,9 +756,7 @@ void Game::drawScreen()
             message = _("You Have Failed Your Mission.");
         }
 
-        sdl2::texture_ptr pFinishMessageTexture = pFontManager->createTextureWithText(message.c_str(), COLOR_WHITE, 28);
-        SDL_Rect drawLocation = calcDrawingRect(pFinishMessageTexture.get(), sideBarPos.x/2, topBarPos.h + (getRendererHeight()-topBarPos.h)/2, HAlign::Center, VAlign::Center);
-        SDL_RenderCopy(renderer, pFinishMessageTexture.get(), nullptr, &drawLocation);
+        pFontManager->drawText(message, COLOR_WHITE, 28, sideBarPos.x/2, topBarPos.h + (getRendererHeight()-topBarPos.h)/2, HAlign::Center, VAlign::Center);
     }
 
     if(pWaitingForOtherPlayers != nullptr) {
@@ -559,6 +786,11 @@ void Game::doInput()
             drawnMouseY = std::max(0, std::min(mouse->y, settings.video.height-1));
         }
 
+        // the contents of render target textures are lost when the renderer is reset (e.g. on a Direct3D device loss)
+        if((event.type == SDL_RENDER_TARGETS_RESET) || (event.type == SDL_RENDER_DEVICE_RESET)) {
+            terrainChunkCache.clear();
+        }
+
         if(pInGameMenu != nullptr) {
             pInGameMenu->handleInput(event);
 
@@ -1070,6 +1302,7 @@ void Game::runMainLoop() {
         pNetworkManager->setOnReceiveCommandList(std::bind(&CommandManager::addCommandList, &cmdManager, std::placeholders::_1, std::placeholders::_2));
         pNetworkManager->setOnReceiveSelectionList(std::bind(&Game::onReceiveSelectionList, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
         pNetworkManager->setOnPeerDisconnected(std::bind(&Game::onPeerDisconnected, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+        pNetworkManager->setOnReceiveStateHash(std::bind(&Game::onReceiveStateHash, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
 
         cmdManager.setNetworkCycleBuffer( MILLI2CYCLES(pNetworkManager->getMaxPeerRoundTripTime()) + 5 );
     }
@@ -1092,7 +1325,10 @@ void Game::runMainLoop() {
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
 
-        drawScreen();
+        {
+            CycleProfiler::SectionTimer timer(cycleProfiler, CycleProfiler::Section_Draw);
+            drawScreen();
+        }
 
         SDL_RenderPresent(renderer);
 
@@ -1134,6 +1370,12 @@ void Game::runMainLoop() {
             takeScreenshot();
         }
 
+        if(saveGameWriter.pollFinished() && saveGameWriter.isFailed()) {
+            addToNewsTicker(std::string("Game NOT saved: Cannot write \"") + saveGameWriter.getFilename() + "\".");
+        }
+
+        writeFinishedReplayKeyframe();
+
 
         while( (frameTime > getGameSpeed()) || (!finished && (gameCycleCount < skipToGameCycle)) )  {
 
@@ -1198,7 +1440,11 @@ void Game::runMainLoop() {
 
             if(!bWaitForNetwork && !bPause) {
                 pInterface->getRadarView().update();
-                cmdManager.executeCommands(gameCycleCount);
+
+                {
+                    CycleProfiler::SectionTimer timer(cycleProfiler, CycleProfiler::Section_Commands);
+                    cmdManager.executeCommands(gameCycleCount);
+                }
 
 //              SDL_Log("cycle %d : %d", gameCycleCount, currentGame->randomGen.getSeed());
 
@@ -1209,17 +1455,26 @@ void Game::runMainLoop() {
                 }
 #endif
 
-                for (int i = 0; i < NUM_HOUSES; i++) {
-                    if (house[i] != nullptr) {
-                        house[i]->update();
+                {
+                    CycleProfiler::SectionTimer timer(cycleProfiler, CycleProfiler::Section_Houses);
+                    for (int i = 0; i < NUM_HOUSES; i++) {
+                        if (house[i] != nullptr) {
+                            house[i]->update();
+                        }
                     }
                 }
 
                 screenborder->update();
 
-                triggerManager.trigger(gameCycleCount);
+                {
+                    CycleProfiler::SectionTimer timer(cycleProfiler, CycleProfiler::Section_Triggers);
+                    triggerManager.trigger(gameCycleCount);
+                }
 
-                processObjects();
+                {
+                    CycleProfiler::SectionTimer timer(cycleProfiler, CycleProfiler::Section_Objects);
+                    processObjects();
+                }
 
                 if ((indicatorFrame != NONE_ID) && (--indicatorTimer <= 0)) {
                     indicatorTimer = indicatorTime;
@@ -1229,7 +1484,17 @@ void Game::runMainLoop() {
                     }
                 }
 
+                cycleProfiler.endCycle(gameCycleCount);
+
                 gameCycleCount++;
+
+                if(!bReplay && (gameCycleCount % ReplayKeyframes::KEYFRAME_INTERVAL == 0)) {
+                    recordReplayKeyframe();
+                }
+
+                if((pNetworkManager != nullptr) && (gameCycleCount % STATEHASH_INTERVAL == 0)) {
+                    exchangeStateHash();
+                }
             }
 
             if(gameCycleCount <= skipToGameCycle) {
@@ -1246,6 +1511,9 @@ void Game::runMainLoop() {
 
     // Game is finished
 
+    replayKeyframes.waitForCompletion();
+    writeFinishedReplayKeyframe();
+
     if(bReplay == false && currentGame->won == true) {
         // save replay
         char tmp[FILENAME_MAX];
@@ -1259,6 +1527,7 @@ void Game::runMainLoop() {
         replystream.writeString(getLocalPlayerName());
         gameInitSettings.save(replystream);
         cmdManager.save(replystream);
+        replayKeyframes.saveAll(replystream);
     }
 
     if(pNetworkManager != nullptr) {
@@ -1469,6 +1738,11 @@ bool Game::loadSaveGame(InputStream& stream) {
         }
     }
 
+    // a keyframe of a multiplayer replay has no local player either (see saveGame()); it is found by name like in a multiplayer load
+    if(bReplay && (gameInitSettings.getGameType() == GameType::CustomMultiplayer)) {
+        bMultiplayerLoad = true;
+    }
+
     // we have to set the local player
     if(bMultiplayerLoad) {
         // get it from the gameInitSettings that started the game (not the one saved in the savegame)
@@ -1524,6 +1798,13 @@ bool Game::loadSaveGame(InputStream& stream) {
 
     //load the structures and units
     objectManager.load(stream);
+    currentGameMap->getTileAttributes().rebuild(*currentGameMap);
+    currentGameMap->getFogOfWar().rebuild();
+
+    // the group moves are not saved but derived from the destinations of the units
+    for(UnitBase* pUnit : unitList) {
+        pUnit->joinGroupMove();
+    }
 
     int numBullets = stream.readUint32();
     for(int i = 0; i < numBullets; i++) {
@@ -1553,7 +1834,10 @@ bool Game::loadSaveGame(InputStream& stream) {
     triggerManager.load(stream);
 
     // CommandManager is at the very end of the file. DO NOT CHANGE THIS!
-    cmdManager.load(stream);
+    // (a replay keyframe is loaded while replaying and the replay file already contains all commands)
+    if(!bReplay) {
+        cmdManager.load(stream);
+    }
 
     finished = false;
 
@@ -1561,98 +1845,97 @@ bool Game::loadSaveGame(InputStream& stream) {
 }
 
 
-bool Game::saveGame(const std::string& filename)
+void Game::saveGame(const std::string& filename)
 {
-    OFileStream fs;
+    // the game is only stopped while serializing it into memory
+    OMemoryStream& memStream = saveGameWriter.getBuffer();
+    saveGame(memStream);
 
-    if(fs.open(filename) == false) {
-        SDL_Log("Game::saveGame(): %s", strerror(errno));
-        currentGame->addToNewsTicker(std::string("Game NOT saved: Cannot open \"") + filename + "\".");
-        return false;
-    }
+    saveGameWriter.writeInBackground(filename);
+}
 
-    fs.writeUint32(SAVEMAGIC);
+void Game::saveGame(OutputStream& stream, bool bWithCommands)
+{
+    stream.writeUint32(SAVEMAGIC);
 
-    fs.writeUint32(SAVEGAMEVERSION);
+    stream.writeUint32(SAVEGAMEVERSION);
 
-    fs.writeString(VERSIONSTRING);
+    stream.writeString(VERSIONSTRING);
 
     // write gameInitSettings
-    gameInitSettings.save(fs);
+    gameInitSettings.save(stream);
 
-    fs.writeUint32(houseInfoListSetup.size());
+    stream.writeUint32(houseInfoListSetup.size());
     for(const GameInitSettings::HouseInfo& houseInfo : houseInfoListSetup) {
-        houseInfo.save(fs);
+        houseInfo.save(stream);
     }
 
     //write the map size
-    fs.writeUint32(currentGameMap->getSizeX());
-    fs.writeUint32(currentGameMap->getSizeY());
+    stream.writeUint32(currentGameMap->getSizeX());
+    stream.writeUint32(currentGameMap->getSizeY());
 
     // write GameCycleCount
-    fs.writeUint32(gameCycleCount);
+    stream.writeUint32(gameCycleCount);
 
     // write some settings
-    fs.writeSint8(static_cast<Sint8>(gameType));
-    fs.writeUint8(techLevel);
-    fs.writeUint32(randomGen.getSeed());
+    stream.writeSint8(static_cast<Sint8>(gameType));
+    stream.writeUint8(techLevel);
+    stream.writeUint32(randomGen.getSeed());
 
     // write out the unit/structure data
-    objectData.save(fs);
+    objectData.save(stream);
 
     //write the house(s) info
     for(int i=0; i<NUM_HOUSES; i++) {
-        fs.writeBool(house[i] != nullptr);
+        stream.writeBool(house[i] != nullptr);
 
         if(house[i] != nullptr) {
-            house[i]->save(fs);
+            house[i]->save(stream);
         }
     }
 
     if(gameInitSettings.getGameType() != GameType::CustomMultiplayer) {
-        fs.writeUint8(pLocalPlayer->getPlayerID());
+        stream.writeUint8(pLocalPlayer->getPlayerID());
     }
 
-    fs.writeBool(debug);
-    fs.writeBool(bCheatsEnabled);
+    stream.writeBool(debug);
+    stream.writeBool(bCheatsEnabled);
 
-    fs.writeUint32(winFlags);
-    fs.writeUint32(loseFlags);
+    stream.writeUint32(winFlags);
+    stream.writeUint32(loseFlags);
 
-    currentGameMap->save(fs);
+    currentGameMap->save(stream);
 
     // save the structures and units
-    objectManager.save(fs);
+    objectManager.save(stream);
 
-    fs.writeUint32(bulletList.size());
+    stream.writeUint32(bulletList.size());
     for(const Bullet* pBullet : bulletList) {
-        pBullet->save(fs);
+        pBullet->save(stream);
     }
 
-    fs.writeUint32(explosionList.size());
+    stream.writeUint32(explosionList.size());
     for(const Explosion* pExplosion : explosionList) {
-        pExplosion->save(fs);
+        pExplosion->save(stream);
     }
 
     if(gameInitSettings.getGameType() != GameType::CustomMultiplayer) {
         // save selection lists
 
         // write out selected units list
-        fs.writeUint32Set(selectedList);
+        stream.writeUint32Set(selectedList);
 
         // write the screenborder info
-        screenborder->save(fs);
+        screenborder->save(stream);
     }
 
     // save triggers
-    triggerManager.save(fs);
+    triggerManager.save(stream);
 
     // CommandManager is at the very end of the file. DO NOT CHANGE THIS!
-    cmdManager.save(fs);
-
-    fs.close();
-
-    return true;
+    if(bWithCommands) {
+        cmdManager.save(stream);
+    }
 }
 
 
@@ -1732,6 +2015,10 @@ void Game::onReceiveSelectionList(const std::string& name, const std::set<Uint32
     }
 }
 
+void Game::onReceiveStateHash(const std::string& name, Uint32 gameCycle, Uint64 hash) {
+    compareStateHash(name, gameCycle, hash);
+}
+
 void Game::onPeerDisconnected(const std::string& name, bool bHost, int cause) {
     pInterface->getChatManager().addInfoMessage(name + " disconnected!");
 }
@@ -2044,24 +2331,43 @@ void Game::handleKeyInput(SDL_KeyboardEvent& keyboardEvent) {
         } break;
 
         case SDLK_F4: {
-            // skip a 30 seconds
-            if(gameType != GameType::CustomMultiplayer || bReplay) {
-                skipToGameCycle = gameCycleCount + (10*1000)/GAMESPEED_DEFAULT;
-            }
+            // skip 10 seconds
+            skipGameTime((10*1000)/GAMESPEED_DEFAULT);
         } break;
 
         case SDLK_F5: {
-            // skip a 30 seconds
-            if(gameType != GameType::CustomMultiplayer || bReplay) {
-                skipToGameCycle = gameCycleCount + (30*1000)/GAMESPEED_DEFAULT;
-            }
+            // skip 30 seconds
+            skipGameTime((30*1000)/GAMESPEED_DEFAULT);
         } break;
 
         case SDLK_F6: {
             // skip 2 minutes
-            if(gameType != GameType::CustomMultiplayer || bReplay) {
-                skipToGameCycle = gameCycleCount + (120*1000)/GAMESPEED_DEFAULT;
+            skipGameTime((120*1000)/GAMESPEED_DEFAULT);
+        } break;
+
+        case SDLK_F9: {
+            if(SDL_GetModState() & KMOD_SHIFT) {
+                // start or stop writing the cycle profile
+                if(cycleProfiler.isWritingCSV()) {
+                    cycleProfiler.stopCSV();
+                    currentGame->addToNewsTicker(_("Cycle profile saved"));
+                } else {
+                    std::string profileFilename;
+                    int i = 1;
+                    do {
+                        profileFilename = "CycleProfile" + std::to_string(i) + ".csv";
+                        i++;
+                    } while(existsFile(profileFilename) == true);
+
+                    if(cycleProfiler.startCSV(profileFilename)) {
+                        currentGame->addToNewsTicker(_("Writing cycle profile") + ": '" + profileFilename + "'");
+                    }
+                }
+            } else {
+                bShowCycleProfiler = !bShowCycleProfiler;
             }
+
+            cycleProfiler.setEnabled(bShowCycleProfiler || cycleProfiler.isWritingCSV());
         } break;
 
         case SDLK_F10: {
@@ -0,0 +1,392 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+    The entry point of dunelegacy-headless. It replays a game without opening a visible window, without sound output and
+    without waiting between the game cycles:
+
+        dunelegacy-headless [--showlog] [--cycles=N] [--csv=FILE] replayfile
+        dunelegacy-headless [--showlog] --verify-keyframes replayfile
+        dunelegacy-headless [--showlog] --verify-seek=N replayfile
+
+    The replay file (e.g. replay/auto.rpl in the config directory) contains the map or savegame the game was started
+    with and all commands given during the game. The game is simulated until it is won or lost, until the last recorded
+    command has been executed or until N more game cycles have been simulated. At the end the number of simulated
+    cycles per second, the time spent in each part of a game cycle (see CycleProfiler) and a hash of the final game
+    state are printed. Running the same replay twice has to print the same hash. With --csv the time spent in every
+    single game cycle is written to FILE.
+
+    With --verify-keyframes the replay is run from the start and the state hash (see Game::calculateStateHash()) at
+    every keyframe cycle is compared to the state hash right after loading this keyframe (see ReplayKeyframes). As a
+    keyframe is a savegame this checks that saving and loading does not change the game state. The exit code is
+    EXIT_FAILURE if any hash differs.
+
+    With --verify-seek the replay is run from the start up to game cycle N and then seeked to game cycle N like in
+    the replay viewer: restarted from the latest keyframe before N and simulated up to N. Both runs have to end with the
+    same state hash; otherwise state that is not saved influences the simulation.
+
+    The original game data files are needed as the units and structures still load their graphics and sounds.
+*/
+
+#include <main.h>
+
+#include <globals.h>
+
+#include <config.h>
+
+#include <FileClasses/FileManager.h>
+#include <FileClasses/GFXManager.h>
+#include <FileClasses/SFXManager.h>
+#include <FileClasses/FontManager.h>
+#include <FileClasses/TextManager.h>
+#include <FileClasses/Palfile.h>
+#include <FileClasses/music/ADLPlayer.h>
+
+#include <GUI/GUIStyle.h>
+#include <GUI/dune/DuneStyle.h>
+
+#include <misc/fnkdat.h>
+#include <misc/Scaler.h>
+#include <misc/exceptions.h>
+#include <misc/SDL2pp.h>
+
+#include <SoundPlayer.h>
+#include <CycleProfiler.h>
+#include <Game.h>
+#include <HeadlessRunner.h>
+
+#include <sand.h>
+
+#include <SDL_ttf.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+
+static void printUsage() {
+    fprintf(stderr, "Usage:\n\tdunelegacy-headless [--showlog] [--cycles=N] [--csv=FILE] replayfile\n"
+                    "\tdunelegacy-headless [--showlog] --verify-keyframes replayfile\n"
+                    "\tdunelegacy-headless [--showlog] --verify-seek=N replayfile\n");
+}
+
+/**
+    Compares the state hash of the replay run from the start with the state hash of every keyframe right after loading it.
+    \param  replayFilename  the replay to check
+    \return true if all hashes are equal
+*/
+static bool verifyKeyframes(const std::string& replayFilename) {
+    // the state hashes at all keyframe cycles when running from the start
+    std::map<Uint32, Uint64> stateHashes;
+
+    currentGame = new Game();
+    currentGame->initReplay(replayFilename);
+    {
+        HeadlessRunner runner(*currentGame);
+        for(const Uint32 cycle : currentGame->getReplayKeyframes().getKeyframeCycles()) {
+            runner.run(cycle - currentGame->getGameCycleCount());
+            if(currentGame->getGameCycleCount() != cycle) {
+                // the game ended before
+                break;
+            }
+            stateHashes[cycle] = currentGame->calculateStateHash();
+        }
+    }
+    delete currentGame;
+    currentGame = nullptr;
+
+    bool bEqual = true;
+    for(const auto& stateHash : stateHashes) {
+        currentGame = new Game();
+        currentGame->initReplay(replayFilename, stateHash.first);
+        const Uint64 loadedStateHash = currentGame->calculateStateHash();
+        delete currentGame;
+        currentGame = nullptr;
+
+        printf("keyframe %-8u %016llX %016llX %s\n", stateHash.first, static_cast<unsigned long long>(stateHash.second),
+               static_cast<unsigned long long>(loadedStateHash), (stateHash.second == loadedStateHash) ? "ok" : "DIFFERENT");
+        bEqual = bEqual && (stateHash.second == loadedStateHash);
+    }
+
+    if(stateHashes.empty()) {
+        printf("no keyframes\n");
+    }
+
+    return bEqual;
+}
+
+/**
+    Compares the state hash of the replay run from the start up to seekCycle with the state hash after seeking to
+    seekCycle from the latest keyframe before it.
+    \param  replayFilename  the replay to check
+    \param  seekCycle       the game cycle to seek to
+    \return true if both hashes are equal
+*/
+static bool verifySeek(const std::string& replayFilename, Uint32 seekCycle) {
+    currentGame = new Game();
+    currentGame->initReplay(replayFilename);
+    {
+        HeadlessRunner runner(*currentGame);
+        runner.run((seekCycle > currentGame->getGameCycleCount()) ? seekCycle - currentGame->getGameCycleCount() : 0);
+    }
+    // the game might have ended before
+    seekCycle = currentGame->getGameCycleCount();
+    const Uint64 stateHash = currentGame->calculateStateHash();
+    delete currentGame;
+    currentGame = nullptr;
+
+    currentGame = new Game();
+    currentGame->initReplay(replayFilename, seekCycle);
+    const Uint32 keyframeCycle = currentGame->getGameCycleCount();
+    {
+        HeadlessRunner runner(*currentGame);
+        runner.run((seekCycle > currentGame->getGameCycleCount()) ? seekCycle - currentGame->getGameCycleCount() : 0);
+    }
+    const Uint64 seekedStateHash = currentGame->calculateStateHash();
+    const bool bReachedSeekCycle = (currentGame->getGameCycleCount() == seekCycle);
+    delete currentGame;
+    currentGame = nullptr;
+
+    printf("seek %u from keyframe %u: %016llX %016llX %s\n", seekCycle, keyframeCycle, static_cast<unsigned long long>(stateHash),
+           static_cast<unsigned long long>(seekedStateHash), (bReachedSeekCycle && (stateHash == seekedStateHash)) ? "ok" : "DIFFERENT");
+
+    return bReachedSeekCycle && (stateHash == seekedStateHash);
+}
+
+static void initSettings() {
+    settings.general.playIntro = false;
+    settings.general.playerName = "Player";
+    settings.general.language = "en";
+    settings.general.scrollSpeed = 50;
+    settings.general.showTutorialHints = false;
+    settings.video.fullscreen = false;
+    settings.video.physicalWidth = 640;
+    settings.video.physicalHeight = 480;
+    settings.video.width = 640;
+    settings.video.height = 480;
+    settings.video.frameLimit = false;
+    settings.video.preferredZoomLevel = 0;
+    settings.video.scaler = "ScaleNN";
+    settings.video.rotateUnitGraphics = false;
+    settings.audio.musicType = "adl";
+    settings.audio.playMusic = false;
+    settings.audio.musicVolume = 0;
+    settings.audio.playSFX = false;
+    settings.audio.sfxVolume = 0;
+    settings.network.serverPort = DEFAULT_PORT;
+    settings.network.metaServer = DEFAULT_METASERVER;
+    settings.network.debugNetwork = false;
+    settings.ai.campaignAI = DEFAULTAIPLAYERCLASS;
+}
+
+static void init() {
+    // nothing is shown or played but graphics and sounds are still loaded
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+    if(SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO) < 0) {
+        THROW(sdl_error, "Couldn't initialize SDL: %s!", SDL_GetError());
+    }
+
+    if(TTF_Init() < 0) {
+        THROW(sdl_error, "Couldn't initialize SDL2_ttf: %s!", TTF_GetError());
+    }
+
+    Scaler::setDefaultScaler(Scaler::getScalerByName(settings.video.scaler));
+
+    if(Mix_OpenAudio(AUDIO_FREQUENCY, AUDIO_S16SYS, 2, 1024) < 0) {
+        THROW(sdl_error, "Couldn't set %d Hz 16-bit audio. Reason: %s!", AUDIO_FREQUENCY, SDL_GetError());
+    }
+
+    pTextManager = std::make_unique<TextManager>();
+    pFileManager = std::make_unique<FileManager>();
+    pTextManager->loadData();
+
+    palette = LoadPalette_RW(pFileManager->openFile("IBM.PAL").get());
+
+    window = SDL_CreateWindow("Dune Legacy", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, settings.video.width, settings.video.height, SDL_WINDOW_HIDDEN);
+    if(window == nullptr) {
+        THROW(sdl_error, "Couldn't create window: %s!", SDL_GetError());
+    }
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE);
+    if(renderer == nullptr) {
+        THROW(sdl_error, "Couldn't create renderer: %s!", SDL_GetError());
+    }
+    screenTexture = SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, settings.video.width, settings.video.height);
+
+    pFontManager = std::make_unique<FontManager>();
+    pGFXManager = std::make_unique<GFXManager>();
+    pSFXManager = std::make_unique<SFXManager>();
+
+    GUIStyle::setGUIStyle(std::make_unique<DuneStyle>());
+
+    soundPlayer = std::make_unique<SoundPlayer>();
+    musicPlayer = std::make_unique<ADLPlayer>();
+}
+
+static void deinit() {
+    GUIStyle::destroyGUIStyle();
+
+    musicPlayer.reset();
+    soundPlayer.reset();
+    Mix_HaltMusic();
+    Mix_CloseAudio();
+
+    pTextManager.reset();
+    pSFXManager.reset();
+    pGFXManager.reset();
+    pFontManager.reset();
+    pFileManager.reset();
+
+    SDL_DestroyTexture(screenTexture);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+
+    TTF_Quit();
+    SDL_Quit();
+}
+
+int main(int argc, char *argv[]) {
+    bool bShowLog = false;
+    bool bVerifyKeyframes = false;
+    bool bVerifySeek = false;
+    Uint32 seekCycle = 0;
+    bool bCyclesGiven = false;
+    Uint32 maxCycles = std::numeric_limits<Uint32>::max();
+    std::string replayFilename;
+    std::string csvFilename;
+
+    for(int i=1; i < argc; i++) {
+        std::string parameter(argv[i]);
+
+        if(parameter == "--showlog") {
+            bShowLog = true;
+        } else if(parameter == "--verify-keyframes") {
+            bVerifyKeyframes = true;
+        } else if(parameter.compare(0, 14, "--verify-seek=") == 0) {
+            seekCycle = strtoul(argv[i] + strlen("--verify-seek="), nullptr, 10);
+            bVerifySeek = true;
+        } else if(parameter.compare(0, 9, "--cycles=") == 0) {
+            maxCycles = strtoul(argv[i] + strlen("--cycles="), nullptr, 10);
+            bCyclesGiven = true;
+        } else if(parameter.compare(0, 6, "--csv=") == 0) {
+            csvFilename = parameter.substr(strlen("--csv="));
+        } else if((parameter.compare(0, 2, "--") != 0) && replayFilename.empty()) {
+            replayFilename = parameter;
+        } else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(replayFilename.empty()) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    SDL_LogSetOutputFunction(logOutputFunction, nullptr);
+    SDL_LogSetAllPriority(bShowLog ? SDL_LOG_PRIORITY_VERBOSE : SDL_LOG_PRIORITY_ERROR);
+
+    try {
+        if(fnkdat(nullptr, nullptr, 0, FNKDAT_INIT) < 0) {
+            THROW(std::runtime_error, "Cannot initialize fnkdat!");
+        }
+
+        const std::vector<std::string> missingFiles = FileManager::getMissingFiles();
+        if(!missingFiles.empty()) {
+            for(const std::string& filename : missingFiles) {
+                fprintf(stderr, "Missing file: %s\n", filename.c_str());
+            }
+            return EXIT_FAILURE;
+        }
+
+        debug = false;
+
+        initSettings();
+        init();
+
+        if(bVerifyKeyframes || bVerifySeek) {
+            const bool bEqual = bVerifyKeyframes ? verifyKeyframes(replayFilename) : verifySeek(replayFilename, seekCycle);
+
+            deinit();
+
+            if(fnkdat(nullptr, nullptr, 0, FNKDAT_UNINIT) < 0) {
+                THROW(std::runtime_error, "Cannot uninitialize fnkdat!");
+            }
+
+            return bEqual ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        currentGame = new Game();
+        currentGame->initReplay(replayFilename);
+
+        if(!bCyclesGiven) {
+            // stop after the last recorded command; otherwise a replay of a game that was quit would run forever
+            const Uint32 numScheduledCycles = currentGame->getCommandManager().getNumScheduledCycles();
+            maxCycles = (numScheduledCycles > currentGame->getGameCycleCount()) ? numScheduledCycles - currentGame->getGameCycleCount() : 0;
+        }
+
+        {
+            if(!csvFilename.empty() && !currentGame->getCycleProfiler().startCSV(csvFilename)) {
+                THROW(io_error, "Cannot open '%s'!", csvFilename);
+            }
+
+            HeadlessRunner runner(*currentGame);
+            runner.run(maxCycles);
+            currentGame->getCycleProfiler().stopCSV();
+
+            const double totalSeconds = runner.getTotalSeconds();
+
+            printf("cycles:        %u (game cycle %u)\n", runner.getNumCycles(), currentGame->getGameCycleCount());
+            printf("time:          %.3f s\n", totalSeconds);
+            printf("cycles/sec:    %.1f\n", (totalSeconds > 0.0) ? runner.getNumCycles() / totalSeconds : 0.0);
+
+            const CycleProfiler& profiler = currentGame->getCycleProfiler();
+            for(int section = 0; section < CycleProfiler::Section_Draw; section++) {
+                const double sectionSeconds = profiler.getTotalSeconds(static_cast<CycleProfiler::Section>(section));
+                printf("  %-12s %.3f s (%.1f%%)\n", CycleProfiler::getSectionName(static_cast<CycleProfiler::Section>(section)),
+                       sectionSeconds, (totalSeconds > 0.0) ? 100.0 * sectionSeconds / totalSeconds : 0.0);
+            }
+            for(int itemID = ItemID_FirstID; itemID <= ItemID_LastID; itemID++) {
+                if(profiler.getTotalItemUpdates(itemID) > 0) {
+                    printf("    %-12s %.3f s (%llu updates)\n", getItemNameByID(itemID).c_str(), profiler.getTotalItemSeconds(itemID),
+                           static_cast<unsigned long long>(profiler.getTotalItemUpdates(itemID)));
+                }
+            }
+            printf("path searches: %llu (%llu nodes)\n", static_cast<unsigned long long>(profiler.getTotalPathSearches()),
+                   static_cast<unsigned long long>(profiler.getTotalPathNodes()));
+            printf("finished:      %s\n", currentGame->isGameFinished() ? "yes" : "no");
+            printf("state hash:    %s\n", runner.getStateHash().c_str());
+        }
+
+        delete currentGame;
+        currentGame = nullptr;
+
+        deinit();
+
+        if(fnkdat(nullptr, nullptr, 0, FNKDAT_UNINIT) < 0) {
+            THROW(std::runtime_error, "Cannot uninitialize fnkdat!");
+        }
+    } catch(const std::exception& e) {
+        fprintf(stderr, "An unhandled exception was thrown: %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <HeadlessRunner.h>
+
+#include <globals.h>
+
+#include <Game.h>
+#include <GameInterface.h>
+#include <House.h>
+
+#include <misc/OMemoryStream.h>
+#include <misc/md5.h>
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+HeadlessRunner::HeadlessRunner(Game& game) : game(game) {
+}
+
+HeadlessRunner::~HeadlessRunner() = default;
+
+void HeadlessRunner::run(Uint32 maxCycles) {
+    if(!bStarted) {
+        start();
+    }
+
+    CycleProfiler& profiler = game.cycleProfiler;
+    profiler.setEnabled(true);
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // the same steps as in Game::runMainLoop() without the ones for the screen (radar, screen border, indicator)
+    for(Uint32 i = 0; (i < maxCycles) && !game.bQuitGame && !game.finished; i++) {
+        {
+            CycleProfiler::SectionTimer timer(profiler, CycleProfiler::Section_Commands);
+            game.cmdManager.executeCommands(game.gameCycleCount);
+        }
+
+        {
+            CycleProfiler::SectionTimer timer(profiler, CycleProfiler::Section_Houses);
+            for(int h = 0; h < NUM_HOUSES; h++) {
+                if(game.house[h] != nullptr) {
+                    game.house[h]->update();
+                }
+            }
+        }
+
+        {
+            CycleProfiler::SectionTimer timer(profiler, CycleProfiler::Section_Triggers);
+            game.triggerManager.trigger(game.gameCycleCount);
+        }
+
+        {
+            CycleProfiler::SectionTimer timer(profiler, CycleProfiler::Section_Objects);
+            game.processObjects();
+        }
+
+        profiler.endCycle(game.gameCycleCount);
+
+        game.gameCycleCount++;
+        numCycles++;
+    }
+
+    totalSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+std::string HeadlessRunner::getStateHash() const {
+    OMemoryStream memStream;
+    memStream.open();
+    game.saveGame(memStream);
+
+    unsigned char md5sum[16];
+    md5(reinterpret_cast<const unsigned char*>(memStream.getData()), memStream.getDataLength(), md5sum);
+
+    std::stringstream md5stream;
+    md5stream << std::setfill('0') << std::hex;
+    for(int i = 0; i < 16; i++) {
+        md5stream << std::setw(2) << static_cast<int>(md5sum[i]);
+    }
+    return md5stream.str();
+}
+
+void HeadlessRunner::start() {
+    // the same preparations as in Game::runMainLoop()
+    if(game.pInterface == nullptr) {
+        // some players report to the chat of the interface
+        game.pInterface = std::make_unique<GameInterface>();
+    }
+
+    game.gameState = GameState::Running;
+    game.finishedLevel = false;
+
+    for(int h = 0; h < NUM_HOUSES; h++) {
+        if((game.house[h] != nullptr) && !game.house[h]->isAlive()) {
+            game.house[h]->lose(true);
+        }
+    }
+
+    if(game.bReplay) {
+        game.cmdManager.setReadOnly(true);
+    }
+
+    bStarted = true;
+}
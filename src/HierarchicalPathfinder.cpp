@@ -0,0 +1,442 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <HierarchicalPathfinder.h>
+
+#include <Map.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+
+// entrances shorter than this get a single transition point in the middle, longer ones get one at each end
+#define MIN_ENTRANCE_LENGTH_FOR_TWO_TRANSITIONS     6
+
+#define COST_STRAIGHT   10
+#define COST_DIAGONAL   14
+
+namespace {
+    typedef std::pair<int, int> QueueEntry;     // (cost, tile index); ties are broken by the tile index for determinism
+    typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> PriorityQueue;
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(Map* pMap) : pMap(pMap) {
+}
+
+HierarchicalPathfinder::~HierarchicalPathfinder() = default;
+
+void HierarchicalPathfinder::reset() {
+    sizeX = 0;
+    sizeY = 0;
+    numClustersX = 0;
+    numClustersY = 0;
+    bDirty = true;
+
+    blocked.clear();
+    clusters.clear();
+    borders.clear();
+    nodeOfTile.clear();
+}
+
+void HierarchicalPathfinder::onTileChanged(const Coord& location) {
+    if((sizeX != pMap->getSizeX()) || (sizeY != pMap->getSizeY())) {
+        // the graph is rebuilt from scratch on the next query anyway
+        return;
+    }
+
+    if(blocked[getTileIndex(location.x, location.y)] == !isStaticallyPassable(location.x, location.y)) {
+        return;
+    }
+
+    clusters[getClusterIndex(location.x / CLUSTER_SIZE, location.y / CLUSTER_SIZE)].bBordersDirty = true;
+    bDirty = true;
+}
+
+bool HierarchicalPathfinder::findWaypoints(const Coord& start, const Coord& destination, std::vector<Coord>& waypoints) {
+    waypoints.clear();
+
+    resizeIfNeeded();
+    rebuildDirtyClusters();
+
+    const int startTile = getTileIndex(start.x, start.y);
+    const int goalTile = getTileIndex(destination.x, destination.y);
+    const int startCluster = getClusterIndexOfTile(startTile);
+    const int goalCluster = getClusterIndexOfTile(goalTile);
+
+    if(startCluster == goalCluster) {
+        return false;
+    }
+
+    const int goalClusterOriginX = (destination.x / CLUSTER_SIZE) * CLUSTER_SIZE;
+    const int goalClusterOriginY = (destination.y / CLUSTER_SIZE) * CLUSTER_SIZE;
+
+    std::vector<int> startDistances;
+    std::vector<int> goalDistances;
+    calculateDistancesInCluster(startTile, startDistances);
+    calculateDistancesInCluster(goalTile, goalDistances);
+
+    searchGeneration++;
+    if(searchGeneration == 0) {
+        std::fill(searchStamp.begin(), searchStamp.end(), 0);
+        searchGeneration = 1;
+    }
+
+    PriorityQueue openList;
+
+    auto relax = [&](int tile, int parent, int cost) {
+        if((searchStamp[tile] == searchGeneration) && (searchCost[tile] <= cost)) {
+            return;
+        }
+        searchStamp[tile] = searchGeneration;
+        searchCost[tile] = cost;
+        searchParent[tile] = parent;
+        openList.emplace(cost + heuristic(tile, goalTile), tile);
+    };
+
+    const int startClusterOriginX = (start.x / CLUSTER_SIZE) * CLUSTER_SIZE;
+    const int startClusterOriginY = (start.y / CLUSTER_SIZE) * CLUSTER_SIZE;
+    for(const int node : clusters[startCluster].nodes) {
+        const int localIndex = ((node / sizeX) - startClusterOriginY) * CLUSTER_SIZE + ((node % sizeX) - startClusterOriginX);
+        if(startDistances[localIndex] != INT_MAX) {
+            relax(node, -1, startDistances[localIndex]);
+        }
+    }
+
+    bool bFound = false;
+    while(!openList.empty()) {
+        const QueueEntry entry = openList.top();
+        openList.pop();
+
+        const int tile = entry.second;
+        if(entry.first > searchCost[tile] + heuristic(tile, goalTile)) {
+            // outdated entry
+            continue;
+        }
+
+        if(tile == goalTile) {
+            bFound = true;
+            break;
+        }
+
+        const int cost = searchCost[tile];
+        const int clusterIndex = getClusterIndexOfTile(tile);
+        const Cluster& cluster = clusters[clusterIndex];
+        const int node = nodeOfTile[tile];
+
+        for(const Edge& edge : cluster.edges[node]) {
+            relax(edge.targetTile, tile, cost + edge.cost);
+        }
+
+        if(clusterIndex == goalCluster) {
+            const int localIndex = ((tile / sizeX) - goalClusterOriginY) * CLUSTER_SIZE + ((tile % sizeX) - goalClusterOriginX);
+            if(goalDistances[localIndex] != INT_MAX) {
+                relax(goalTile, tile, cost + goalDistances[localIndex]);
+            }
+        }
+    }
+
+    if(!bFound) {
+        return false;
+    }
+
+    for(int tile = goalTile; tile != -1; tile = searchParent[tile]) {
+        if(tile != startTile) {
+            waypoints.emplace_back(tile % sizeX, tile / sizeX);
+        }
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    return true;
+}
+
+void HierarchicalPathfinder::resizeIfNeeded() {
+    if((sizeX == pMap->getSizeX()) && (sizeY == pMap->getSizeY())) {
+        return;
+    }
+
+    sizeX = pMap->getSizeX();
+    sizeY = pMap->getSizeY();
+    numClustersX = (sizeX + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    numClustersY = (sizeY + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+
+    blocked.assign(sizeX*sizeY, false);
+    clusters.clear();
+    clusters.resize(numClustersX*numClustersY);
+    borders.clear();
+    borders.resize(2*numClustersX*numClustersY);
+    nodeOfTile.assign(sizeX*sizeY, -1);
+
+    searchCost.assign(sizeX*sizeY, 0);
+    searchParent.assign(sizeX*sizeY, -1);
+    searchStamp.assign(sizeX*sizeY, 0);
+    searchGeneration = 0;
+
+    bDirty = true;
+}
+
+void HierarchicalPathfinder::rebuildDirtyClusters() {
+    if(!bDirty) {
+        return;
+    }
+
+    // first refresh the passability of all changed clusters as borders depend on both sides
+    for(int clusterY = 0; clusterY < numClustersY; clusterY++) {
+        for(int clusterX = 0; clusterX < numClustersX; clusterX++) {
+            if(!clusters[getClusterIndex(clusterX, clusterY)].bBordersDirty) {
+                continue;
+            }
+
+            const int maxX = std::min((clusterX+1)*CLUSTER_SIZE, sizeX);
+            const int maxY = std::min((clusterY+1)*CLUSTER_SIZE, sizeY);
+            for(int y = clusterY*CLUSTER_SIZE; y < maxY; y++) {
+                for(int x = clusterX*CLUSTER_SIZE; x < maxX; x++) {
+                    blocked[getTileIndex(x, y)] = !isStaticallyPassable(x, y);
+                }
+            }
+        }
+    }
+
+    for(int clusterY = 0; clusterY < numClustersY; clusterY++) {
+        for(int clusterX = 0; clusterX < numClustersX; clusterX++) {
+            Cluster& cluster = clusters[getClusterIndex(clusterX, clusterY)];
+            if(!cluster.bBordersDirty) {
+                continue;
+            }
+
+            rebuildBorder(clusterX, clusterY, true);
+            rebuildBorder(clusterX, clusterY, false);
+            rebuildBorder(clusterX - 1, clusterY, true);
+            rebuildBorder(clusterX, clusterY - 1, false);
+
+            markEdgesDirty(clusterX, clusterY);
+            markEdgesDirty(clusterX - 1, clusterY);
+            markEdgesDirty(clusterX + 1, clusterY);
+            markEdgesDirty(clusterX, clusterY - 1);
+            markEdgesDirty(clusterX, clusterY + 1);
+
+            cluster.bBordersDirty = false;
+        }
+    }
+
+    for(int clusterY = 0; clusterY < numClustersY; clusterY++) {
+        for(int clusterX = 0; clusterX < numClustersX; clusterX++) {
+            if(clusters[getClusterIndex(clusterX, clusterY)].bEdgesDirty) {
+                rebuildCluster(clusterX, clusterY);
+            }
+        }
+    }
+
+    bDirty = false;
+}
+
+void HierarchicalPathfinder::rebuildBorder(int clusterX, int clusterY, bool bVertical) {
+    if((clusterX < 0) || (clusterY < 0)) {
+        return;
+    }
+
+    if((bVertical && (clusterX >= numClustersX - 1)) || (!bVertical && (clusterY >= numClustersY - 1)) || (clusterX >= numClustersX) || (clusterY >= numClustersY)) {
+        return;
+    }
+
+    std::vector<Transition>& transitions = borders[getBorderIndex(clusterX, clusterY, bVertical)];
+    transitions.clear();
+
+    // walk along the border; the tile at pos on the left/upper side is (x1,y1), the one on the right/lower side is (x1+dx,y1+dy)
+    const int dx = bVertical ? 1 : 0;
+    const int dy = bVertical ? 0 : 1;
+    const int first = bVertical ? clusterY*CLUSTER_SIZE : clusterX*CLUSTER_SIZE;
+    const int last = bVertical ? std::min((clusterY+1)*CLUSTER_SIZE, sizeY) : std::min((clusterX+1)*CLUSTER_SIZE, sizeX);
+
+    auto getTile1 = [&](int pos) {
+        return bVertical ? getTileIndex((clusterX+1)*CLUSTER_SIZE - 1, pos) : getTileIndex(pos, (clusterY+1)*CLUSTER_SIZE - 1);
+    };
+    auto getTile2 = [&](int pos) {
+        return getTile1(pos) + getTileIndex(dx, dy);
+    };
+    auto isOpen = [&](int pos1, int pos2) {
+        return (pos1 >= first) && (pos1 < last) && (pos2 >= first) && (pos2 < last) && !blocked[getTile1(pos1)] && !blocked[getTile2(pos2)];
+    };
+
+    int runStart = -1;
+    for(int pos = first; pos <= last; pos++) {
+        const bool bOpen = isOpen(pos, pos);
+
+        if(bOpen && (runStart == -1)) {
+            runStart = pos;
+        } else if(!bOpen && (runStart != -1)) {
+            const int runEnd = pos - 1;
+            if(runEnd - runStart + 1 < MIN_ENTRANCE_LENGTH_FOR_TWO_TRANSITIONS) {
+                const int middle = (runStart + runEnd) / 2;
+                transitions.push_back( { getTile1(middle), getTile2(middle), COST_STRAIGHT } );
+            } else {
+                transitions.push_back( { getTile1(runStart), getTile2(runStart), COST_STRAIGHT } );
+                transitions.push_back( { getTile1(runEnd), getTile2(runEnd), COST_STRAIGHT } );
+            }
+            runStart = -1;
+        }
+    }
+
+    // units may also squeeze diagonally through a gap that has no straight entrance
+    for(int pos = first; pos < last - 1; pos++) {
+        if(isOpen(pos, pos) || isOpen(pos + 1, pos + 1)) {
+            continue;
+        }
+
+        if(isOpen(pos, pos + 1)) {
+            transitions.push_back( { getTile1(pos), getTile2(pos + 1), COST_DIAGONAL } );
+        }
+        if(isOpen(pos + 1, pos)) {
+            transitions.push_back( { getTile1(pos + 1), getTile2(pos), COST_DIAGONAL } );
+        }
+    }
+}
+
+void HierarchicalPathfinder::rebuildCluster(int clusterX, int clusterY) {
+    Cluster& cluster = clusters[getClusterIndex(clusterX, clusterY)];
+
+    for(const int node : cluster.nodes) {
+        nodeOfTile[node] = -1;
+    }
+    cluster.nodes.clear();
+    cluster.edges.clear();
+
+    // collect the transitions on all four borders as (own tile, tile in neighbor cluster)
+    std::vector<Transition> interEdges;
+    if(clusterX < numClustersX - 1) {
+        for(const Transition& transition : borders[getBorderIndex(clusterX, clusterY, true)]) {
+            interEdges.push_back( { transition.first, transition.second, transition.cost } );
+        }
+    }
+    if(clusterY < numClustersY - 1) {
+        for(const Transition& transition : borders[getBorderIndex(clusterX, clusterY, false)]) {
+            interEdges.push_back( { transition.first, transition.second, transition.cost } );
+        }
+    }
+    if(clusterX > 0) {
+        for(const Transition& transition : borders[getBorderIndex(clusterX - 1, clusterY, true)]) {
+            interEdges.push_back( { transition.second, transition.first, transition.cost } );
+        }
+    }
+    if(clusterY > 0) {
+        for(const Transition& transition : borders[getBorderIndex(clusterX, clusterY - 1, false)]) {
+            interEdges.push_back( { transition.second, transition.first, transition.cost } );
+        }
+    }
+
+    for(const Transition& interEdge : interEdges) {
+        cluster.nodes.push_back(interEdge.first);
+    }
+    std::sort(cluster.nodes.begin(), cluster.nodes.end());
+    cluster.nodes.erase(std::unique(cluster.nodes.begin(), cluster.nodes.end()), cluster.nodes.end());
+
+    for(int i = 0; i < (int) cluster.nodes.size(); i++) {
+        nodeOfTile[cluster.nodes[i]] = i;
+    }
+
+    cluster.edges.resize(cluster.nodes.size());
+
+    for(const Transition& interEdge : interEdges) {
+        cluster.edges[nodeOfTile[interEdge.first]].push_back( { interEdge.second, interEdge.cost } );
+    }
+
+    const int originX = clusterX*CLUSTER_SIZE;
+    const int originY = clusterY*CLUSTER_SIZE;
+    std::vector<int> distances;
+    for(int i = 0; i < (int) cluster.nodes.size(); i++) {
+        calculateDistancesInCluster(cluster.nodes[i], distances);
+
+        for(int j = 0; j < (int) cluster.nodes.size(); j++) {
+            if(i == j) {
+                continue;
+            }
+
+            const int target = cluster.nodes[j];
+            const int distance = distances[((target / sizeX) - originY) * CLUSTER_SIZE + ((target % sizeX) - originX)];
+            if(distance != INT_MAX) {
+                cluster.edges[i].push_back( { target, distance } );
+            }
+        }
+    }
+
+    cluster.bEdgesDirty = false;
+}
+
+void HierarchicalPathfinder::calculateDistancesInCluster(int sourceTile, std::vector<int>& distances) {
+    const int sourceX = sourceTile % sizeX;
+    const int sourceY = sourceTile / sizeX;
+    const int originX = (sourceX / CLUSTER_SIZE) * CLUSTER_SIZE;
+    const int originY = (sourceY / CLUSTER_SIZE) * CLUSTER_SIZE;
+    const int maxX = std::min(originX + CLUSTER_SIZE, sizeX);
+    const int maxY = std::min(originY + CLUSTER_SIZE, sizeY);
+
+    distances.assign(CLUSTER_SIZE*CLUSTER_SIZE, INT_MAX);
+
+    // the source itself may be blocked (e.g. a structure that shall be attacked); we only need to be able to leave it
+    PriorityQueue queue;
+    const int sourceIndex = (sourceY - originY) * CLUSTER_SIZE + (sourceX - originX);
+    distances[sourceIndex] = 0;
+    queue.emplace(0, sourceIndex);
+
+    while(!queue.empty()) {
+        const QueueEntry entry = queue.top();
+        queue.pop();
+
+        const int localIndex = entry.second;
+        if(entry.first > distances[localIndex]) {
+            continue;
+        }
+
+        const int x = originX + localIndex % CLUSTER_SIZE;
+        const int y = originY + localIndex / CLUSTER_SIZE;
+
+        for(int dy = -1; dy <= 1; dy++) {
+            for(int dx = -1; dx <= 1; dx++) {
+                const int nx = x + dx;
+                const int ny = y + dy;
+                if(((dx == 0) && (dy == 0)) || (nx < originX) || (nx >= maxX) || (ny < originY) || (ny >= maxY) || blocked[getTileIndex(nx, ny)]) {
+                    continue;
+                }
+
+                const int neighborIndex = (ny - originY) * CLUSTER_SIZE + (nx - originX);
+                const int cost = entry.first + (((dx != 0) && (dy != 0)) ? COST_DIAGONAL : COST_STRAIGHT);
+                if(cost < distances[neighborIndex]) {
+                    distances[neighborIndex] = cost;
+                    queue.emplace(cost, neighborIndex);
+                }
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::markEdgesDirty(int clusterX, int clusterY) {
+    if((clusterX >= 0) && (clusterX < numClustersX) && (clusterY >= 0) && (clusterY < numClustersY)) {
+        clusters[getClusterIndex(clusterX, clusterY)].bEdgesDirty = true;
+    }
+}
+
+bool HierarchicalPathfinder::isStaticallyPassable(int x, int y) const {
+    const TileAttributes& tileAttributes = pMap->getTileAttributes();
+    return !tileAttributes.isMountain(x, y) && !tileAttributes.hasAStructure(x, y);
+}
+
+int HierarchicalPathfinder::heuristic(int tile1, int tile2) const {
+    const int dx = std::abs((tile1 % sizeX) - (tile2 % sizeX));
+    const int dy = std::abs((tile1 / sizeX) - (tile2 / sizeX));
+    return COST_STRAIGHT * std::max(dx, dy) + (COST_DIAGONAL - COST_STRAIGHT) * std::min(dx, dy);
+}
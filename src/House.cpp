@@ -53,7 +53,8 @@ House::House(int newHouse, int newCredits, int maxUnits, Uint8 teamID, int quota
     this->teamID = teamID;
 
     storedCredits = 0;
-    startingCredits = newCredits;
+    startingCredits = 0;
+    setStartingCredits(newCredits);
     oldCredits = lround(storedCredits+startingCredits);
 
     this->maxUnits = maxUnits;
@@ -86,8 +87,10 @@ House::House(InputStream& stream) : choam(this) {
     houseID = stream.readUint8();
     teamID = stream.readUint8();
 
-    storedCredits = stream.readFixPoint();
-    startingCredits = stream.readFixPoint();
+    storedCredits = 0;
+    startingCredits = 0;
+    setStoredCredits(stream.readFixPoint());
+    setStartingCredits(stream.readFixPoint());
     oldCredits = lround(storedCredits+startingCredits);
     maxUnits = stream.readSint32();
     quota = stream.readSint32();
@@ -229,7 +232,7 @@ void House::addCredits(FixPoint newCredits, bool wasRefined) {
             harvestedSpice += newCredits;
         }
 
-        storedCredits += newCredits;
+        setStoredCredits(storedCredits + newCredits);
         if(this == pLocalHouse) {
             if(((currentGame->winFlags & WINLOSEFLAGS_QUOTA) != 0) && (quota != 0)) {
                 if(storedCredits >= quota) {
@@ -243,6 +246,19 @@ void House::addCredits(FixPoint newCredits, bool wasRefined) {
 
 
 
+void House::setStoredCredits(FixPoint newStoredCredits) {
+    currentGame->getStateHash().update(StateHash::Category_HouseCredits, 2*houseID, storedCredits.getRawValue(), newStoredCredits.getRawValue());
+    storedCredits = newStoredCredits;
+}
+
+void House::setStartingCredits(FixPoint newStartingCredits) {
+    currentGame->getStateHash().update(StateHash::Category_HouseCredits, 2*houseID + 1, startingCredits.getRawValue(), newStartingCredits.getRawValue());
+    startingCredits = newStartingCredits;
+}
+
+
+
+
 void House::returnCredits(FixPoint newCredits) {
     if(newCredits > 0) {
         FixPoint leftCapacity = capacity - storedCredits;
@@ -250,7 +266,7 @@ void House::returnCredits(FixPoint newCredits) {
             addCredits(newCredits, false);
         } else {
             addCredits(leftCapacity, false);
-            startingCredits += (newCredits - leftCapacity);
+            setStartingCredits(startingCredits + (newCredits - leftCapacity));
         }
     }
 }
@@ -264,17 +280,17 @@ FixPoint House::takeCredits(FixPoint amount) {
     if(getCredits() >= 1) {
         if(storedCredits > amount) {
             taken = amount;
-            storedCredits -= amount;
+            setStoredCredits(storedCredits - amount);
         } else {
             taken = storedCredits;
-            storedCredits = 0;
+            setStoredCredits(0);
 
             if(startingCredits > (amount - taken)) {
-                startingCredits -= (amount - taken);
+                setStartingCredits(startingCredits - (amount - taken));
                 taken = amount;
             } else {
                 taken += startingCredits;
-                startingCredits = 0;
+                setStartingCredits(0);
             }
         }
     }
@@ -333,9 +349,9 @@ void House::update() {
     }
 
     if(storedCredits > capacity) {
-        --storedCredits;
+        setStoredCredits(storedCredits - 1);
         if(storedCredits < 0) {
-         storedCredits = 0;
+            setStoredCredits(0);
         }
 
         if(this == pLocalHouse) {
@@ -29,16 +29,20 @@
 #include <units/AirUnit.h>
 #include <structures/StructureBase.h>
 
+#include <algorithm>
 #include <climits>
 #include <stack>
 #include <set>
 
 Map::Map(int xSize, int ySize)
- : sizeX(xSize), sizeY(ySize), lastSinglySelectedObject(nullptr) {
+ : sizeX(xSize), sizeY(ySize), lastSinglySelectedObject(nullptr), hierarchicalPathfinder(this), spatialIndex(xSize, ySize), visibilityBitmaps(xSize, ySize), radarChangeFeed(xSize, ySize), tileAttributes(xSize, ySize), fogOfWar(this) {
 
     tiles.resize(sizeX * sizeY);
 
     init_tile_location();
+    init_visibility_bitmaps();
+    init_active_tiles();
+    init_terrain_chunks();
 }
 
 
@@ -55,6 +59,19 @@ void Map::load(InputStream& stream) {
         tile.load(stream);
 
     init_tile_location();
+
+    for (const auto& tile : tiles)
+        tile.addSpiceToStateHash();
+
+    hierarchicalPathfinder.reset();
+    spatialIndex.reset(sizeX, sizeY);
+    init_visibility_bitmaps();
+    init_active_tiles();
+    init_terrain_chunks();
+    init_radar_changes();
+    // the objects are not loaded yet; Game::loadSaveGame() rebuilds the attributes again afterwards
+    tileAttributes.rebuild(*this);
+    fogOfWar.reset();
 }
 
 void Map::save(OutputStream& stream) const {
@@ -65,6 +82,38 @@ void Map::save(OutputStream& stream) const {
         tile.save(stream);
 }
 
+void Map::joinGroupMove(const Coord& destination, TileAttributes::MovementClass movementClass) {
+    groupMoves[std::make_pair(tile_index(destination.x, destination.y), movementClass)].numUnits++;
+}
+
+void Map::leaveGroupMove(const Coord& destination, TileAttributes::MovementClass movementClass) {
+    const auto iter = groupMoves.find(std::make_pair(tile_index(destination.x, destination.y), movementClass));
+    if(iter == groupMoves.end()) {
+        return;
+    }
+
+    GroupMove& groupMove = iter->second;
+    groupMove.numUnits--;
+    if(groupMove.numUnits <= 0) {
+        groupMoves.erase(iter);
+    } else if(groupMove.numUnits < FlowField::MIN_GROUP_SIZE) {
+        groupMove.pFlowField.reset();
+    }
+}
+
+const FlowField* Map::getFlowField(const Coord& destination, TileAttributes::MovementClass movementClass) {
+    const auto iter = groupMoves.find(std::make_pair(tile_index(destination.x, destination.y), movementClass));
+    if((iter == groupMoves.end()) || (iter->second.numUnits < FlowField::MIN_GROUP_SIZE)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<FlowField>& pFlowField = iter->second.pFlowField;
+    if(!pFlowField || (pFlowField->getTerrainVersion() != tileAttributes.getTerrainVersion())) {
+        pFlowField = std::make_unique<FlowField>(this, destination, movementClass);
+    }
+    return pFlowField.get();
+}
+
 void Map::init_tile_location() {
     for (auto i = 0; i < sizeX; ++i) {
         for (auto j = 0; j < sizeY; ++j) {
@@ -73,6 +122,99 @@ void Map::init_tile_location() {
     }
 }
 
+void Map::init_visibility_bitmaps() {
+    visibilityBitmaps.reset(sizeX, sizeY);
+
+    for (const auto& tile : tiles) {
+        for (auto h = 0; h < NUM_HOUSES; h++) {
+            if (tile.isExploredByHouse(h)) {
+                visibilityBitmaps.setExplored(h, tile.getLocation().x, tile.getLocation().y);
+            }
+        }
+        visibilityBitmaps.setOccupied(tile.getLocation().x, tile.getLocation().y, tile.hasAnObject());
+    }
+}
+
+void Map::init_active_tiles() {
+    activeTileStripes.clear();
+    activeTileStripes.resize((sizeY + ACTIVE_TILE_STRIPE_HEIGHT - 1) / ACTIVE_TILE_STRIPE_HEIGHT);
+    activeTileFlags.assign(sizeX * sizeY, 0);
+
+    for (const auto& tile : tiles) {
+        if (tile.needsUpdate()) {
+            activateTile(tile.getLocation());
+        }
+    }
+}
+
+void Map::init_terrain_chunks() {
+    // every chunk gets a version newer than all versions handed out before, so that chunks prerendered for the
+    // previous content of this map (e.g. before loading a savegame) are not mistaken as up to date
+    const Uint32 version = terrainChunkVersions.empty() ? 1 : *std::max_element(terrainChunkVersions.begin(), terrainChunkVersions.end()) + 1;
+    terrainChunkVersions.assign(getNumTerrainChunksX() * getNumTerrainChunksY(), version);
+}
+
+void Map::init_radar_changes() {
+    radarChangeFeed.reset(sizeX, sizeY);
+
+    // loaded tiles may still get fogged without being touched again
+    for (const auto& tile : tiles) {
+        const auto foggingCycle = tile.getFoggingCycle();
+        if (foggingCycle != 0) {
+            radarChangeFeed.scheduleFogCheck(tile.getLocation().x, tile.getLocation().y, foggingCycle);
+        }
+    }
+}
+
+void Map::onTileAppearanceChanged(const Coord& location) {
+    radarChangeFeed.markChanged(location.x, location.y);
+
+    // the terrain tile of a tile depends on its 4 neighbours and they may lie in a different chunk
+    static const Coord neighbours[] = { Coord(0, 0), Coord(0, -1), Coord(1, 0), Coord(0, 1), Coord(-1, 0) };
+
+    for (const auto& offset : neighbours) {
+        const auto x = location.x + offset.x;
+        const auto y = location.y + offset.y;
+        if (tileExists(x, y)) {
+            terrainChunkVersions[(y / TERRAIN_CHUNK_SIZE) * getNumTerrainChunksX() + x / TERRAIN_CHUNK_SIZE]++;
+        }
+    }
+}
+
+void Map::activateTile(const Coord& location) {
+    const int index = tile_index(location.x, location.y);
+    if (activeTileFlags[index] != 0) {
+        return;
+    }
+
+    activeTileFlags[index] = 1;
+    activeTileStripes[location.y / ACTIVE_TILE_STRIPE_HEIGHT].push_back(index);
+}
+
+void Map::updateActiveTiles() {
+    // Tile::update() only changes the tile itself and every stripe only touches its own tiles and flags. Thus the
+    // stripes are independent of each other and the result does not depend on the order they are processed in.
+    for (auto& stripe : activeTileStripes) {
+        updateActiveTileStripe(stripe);
+    }
+}
+
+void Map::updateActiveTileStripe(std::vector<int>& stripe) {
+    stripe.erase(std::remove_if(stripe.begin(), stripe.end(),
+                                [this](int index) {
+                                    Tile& tile = tiles[index];
+                                    tile.update();
+
+                                    if (tile.needsUpdate()) {
+                                        return false;
+                                    }
+
+                                    activeTileFlags[index] = 0;
+                                    return true;
+                                }),
+                 stripe.end());
+}
+
 void Map::createSandRegions() {
     std::stack<Tile*> tileQueue;
     std::vector<bool> visited(tiles.size());
@@ -502,6 +644,8 @@ Coord Map::findClosestEdgePoint(const Coord& origin, const Coord& buildingSize)
 void Map::removeObjectFromMap(Uint32 objectID) {
     for (auto& tile : tiles)
         tile.unassignObject(objectID);
+
+    fogOfWar.removeObserver(objectID);
 }
 
 void Map::selectObjects(const House* pHouse, int x1, int y1, int x2, int y2, int realX, int realY, bool objectARGMode) {
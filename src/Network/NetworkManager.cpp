@@ -634,6 +634,20 @@ void NetworkManager::handlePacket(ENetPeer* peer, ENetPacketIStream& packetStrea
                 }
             } break;
 
+            case NETWORKPACKET_STATEHASH: {
+                PeerData* peerData = static_cast<PeerData*>(peer->data);
+                if(!peerData) {
+                    break;
+                }
+
+                Uint32 gameCycle = packetStream.readUint32();
+                Uint64 stateHash = packetStream.readUint64();
+
+                if(pOnReceiveStateHash) {
+                    pOnReceiveStateHash(peerData->name, gameCycle, stateHash);
+                }
+            } break;
+
             default: {
                 SDL_Log("NetworkManager: Unknown packet type %d", packetType);
             };
@@ -740,6 +754,15 @@ void NetworkManager::sendSelectedList(const std::set<Uint32>& selectedList, int
     sendPacketToAllConnectedPeers(packetStream, 0);
 }
 
+void NetworkManager::sendStateHash(Uint32 gameCycle, Uint64 stateHash) {
+    ENetPacketOStream packetStream(ENET_PACKET_FLAG_RELIABLE);
+    packetStream.writeUint32(NETWORKPACKET_STATEHASH);
+    packetStream.writeUint32(gameCycle);
+    packetStream.writeUint64(stateHash);
+
+    sendPacketToAllConnectedPeers(packetStream, 0);
+}
+
 int NetworkManager::getMaxPeerRoundTripTime() {
     int maxPeerRTT = 0;
 
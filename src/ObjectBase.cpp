@@ -279,10 +279,9 @@ void ObjectBase::setHealth(FixPoint newHealth) {
 
 void ObjectBase::setLocation(int xPos, int yPos) {
     if((xPos == INVALID_POS) && (yPos == INVALID_POS)) {
-        location.invalidate();
+        changeLocation(Coord::Invalid());
     } else if (currentGameMap->tileExists(xPos, yPos))  {
-        location.x = xPos;
-        location.y = yPos;
+        changeLocation(Coord(xPos, yPos));
         realX = location.x*TILESIZE;
         realY = location.y*TILESIZE;
 
@@ -290,6 +289,12 @@ void ObjectBase::setLocation(int xPos, int yPos) {
     }
 }
 
+void ObjectBase::changeLocation(const Coord& newLocation) {
+    const Coord previousLocation = location;
+    location = newLocation;
+    currentGameMap->getSpatialIndex().moveObject(this, previousLocation);
+}
+
 void ObjectBase::setObjectID(int newObjectID) {
     if(newObjectID >= 0) {
         objectID = newObjectID;
@@ -361,24 +366,41 @@ Coord ObjectBase::getClosestPoint(const Coord& point) const {
     return location;
 }
 
+/**
+    Returns the distance used for choosing between potential targets. Walls are targeted very last.
+*/
+static FixPoint getTargetDistance(const Coord& location, const ObjectBase* pTarget) {
+    const auto closestPoint = pTarget->getClosestPoint(location);
+    auto targetDistance = blockDistance(location, closestPoint);
+
+    if(pTarget->getItemID() == Structure_Wall) {
+        targetDistance += 20000000; //so that walls are targeted very last
+    }
+
+    return targetDistance;
+}
+
+/*
+    The following methods search the spatial index of the map ring by ring instead of walking structureList and unitList.
+    The result is the same as before: the closest target wins and if there are several at the same distance the one that
+    comes first in structureList/unitList (which is the one with the lowest object ID) wins.
+*/
+
 const StructureBase* ObjectBase::findClosestTargetStructure() const {
     const StructureBase *pClosestStructure = nullptr;
     auto closestDistance = FixPt_MAX;
-    for(const StructureBase* pStructure : structureList) {
+    currentGameMap->getSpatialIndex().visitObjectsAround(getLocation(), true, closestDistance, [&](ObjectBase* pObject) {
+        const auto pStructure = static_cast<const StructureBase*>(pObject);
         if(canAttack(pStructure)) {
-            const auto closestPoint = pStructure->getClosestPoint(getLocation());
-            auto structureDistance = blockDistance(getLocation(), closestPoint);
+            const auto structureDistance = getTargetDistance(getLocation(), pStructure);
 
-            if(pStructure->getItemID() == Structure_Wall) {
-                structureDistance += 20000000; //so that walls are targeted very last
-            }
-
-            if(structureDistance < closestDistance) {
+            if((structureDistance < closestDistance)
+                || ((structureDistance == closestDistance) && (pStructure->getObjectID() < pClosestStructure->getObjectID()))) {
                 closestDistance = structureDistance;
                 pClosestStructure = pStructure;
             }
         }
-    }
+    });
 
     return pClosestStructure;
 }
@@ -386,51 +408,41 @@ const StructureBase* ObjectBase::findClosestTargetStructure() const {
 const UnitBase* ObjectBase::findClosestTargetUnit() const {
     const UnitBase *pClosestUnit = nullptr;
     auto closestDistance = FixPt_MAX;
-    for(const UnitBase* pUnit : unitList) {
+    currentGameMap->getSpatialIndex().visitObjectsAround(getLocation(), false, closestDistance, [&](ObjectBase* pObject) {
+        const auto pUnit = static_cast<const UnitBase*>(pObject);
         if(canAttack(pUnit)) {
-            const auto closestPoint = pUnit->getClosestPoint(getLocation());
-            const auto unitDistance = blockDistance(getLocation(), closestPoint);
+            const auto unitDistance = getTargetDistance(getLocation(), pUnit);
 
-            if(unitDistance < closestDistance) {
+            if((unitDistance < closestDistance)
+                || ((unitDistance == closestDistance) && (pUnit->getObjectID() < pClosestUnit->getObjectID()))) {
                 closestDistance = unitDistance;
                 pClosestUnit = pUnit;
             }
         }
-    }
+    });
 
     return pClosestUnit;
 }
 
 const ObjectBase* ObjectBase::findClosestTarget() const {
-    const ObjectBase *pClosestObject = nullptr;
-    FixPoint closestDistance = FixPt_MAX;
-    for(const StructureBase* pStructure : structureList) {
-        if(canAttack(pStructure)) {
-            const auto closestPoint = pStructure->getClosestPoint(getLocation());
-            auto structureDistance = blockDistance(getLocation(), closestPoint);
-
-            if(pStructure->getItemID() == Structure_Wall) {
-                    structureDistance += 20000000; //so that walls are targeted very last
-            }
+    const ObjectBase *pClosestObject = findClosestTargetStructure();
+    FixPoint closestDistance = (pClosestObject != nullptr) ? getTargetDistance(getLocation(), pClosestObject) : FixPt_MAX;
 
-            if(structureDistance < closestDistance) {
-                closestDistance = structureDistance;
-                pClosestObject = pStructure;
-            }
-        }
-    }
-
-    for(const UnitBase* pUnit : unitList) {
+    // a unit has to be strictly closer than the closest structure
+    bool bClosestIsUnit = false;
+    currentGameMap->getSpatialIndex().visitObjectsAround(getLocation(), false, closestDistance, [&](ObjectBase* pObject) {
+        const auto pUnit = static_cast<const UnitBase*>(pObject);
         if(canAttack(pUnit)) {
-            const auto closestPoint = pUnit->getClosestPoint(getLocation());
-            const auto unitDistance = blockDistance(getLocation(), closestPoint);
+            const auto unitDistance = getTargetDistance(getLocation(), pUnit);
 
-            if(unitDistance < closestDistance) {
+            if((unitDistance < closestDistance)
+                || (bClosestIsUnit && (unitDistance == closestDistance) && (pUnit->getObjectID() < pClosestObject->getObjectID()))) {
                 closestDistance = unitDistance;
                 pClosestObject = pUnit;
+                bClosestIsUnit = true;
             }
         }
-    }
+    });
 
     return pClosestObject;
 }
@@ -478,32 +490,39 @@ const ObjectBase* ObjectBase::findTarget() const {
     ObjectBase *pClosestTarget = nullptr;
     auto closestTargetDistance = FixPt_MAX;
 
-    Coord coord;
+    const auto teamID = getOwner()->getTeamID();
+
+    Uint32 teamHouseMask = 0;
+    for(auto h = 0; h < NUM_HOUSES; h++) {
+        const auto* pHouse = currentGame->getHouse(h);
+        if((pHouse != nullptr) && (pHouse->getTeamID() == teamID)) {
+            teamHouseMask |= (1u << h);
+        }
+    }
+
+    // only tiles that are occupied and explored by our team are visited (in the same order as a plain row by row scan)
+    const auto startX = std::max(0, location.x - checkRange);
+    const auto endX = std::min(currentGameMap->getSizeX()-1, location.x + checkRange);
     const auto startY = std::max(0, location.y - checkRange);
     const auto endY = std::min(currentGameMap->getSizeY()-1, location.y + checkRange);
-    for(coord.y = startY; coord.y <= endY; coord.y++) {
-        const auto startX = std::max(0, location.x - checkRange);
-        const auto endX = std::min(currentGameMap->getSizeX()-1, location.x + checkRange);
-        for(coord.x = startX; coord.x <= endX; coord.x++) {
-
-            const auto targetDistance = blockDistance(location, coord);
-            if(targetDistance <= checkRange) {
-                Tile* pTile = currentGameMap->getTile(coord);
-                if( pTile->isExploredByTeam(getOwner()->getTeamID())
-                    && !pTile->isFoggedByTeam(getOwner()->getTeamID())
-                    && pTile->hasAnObject()) {
-
-                    const auto pNewTarget = pTile->getObject();
-                    if(((pNewTarget->getItemID() != Structure_Wall && pNewTarget->getItemID() != Unit_Carryall) || pClosestTarget == nullptr) && canAttack(pNewTarget)) {
-                        if(targetDistance < closestTargetDistance) {
-                            pClosestTarget = pNewTarget;
-                            closestTargetDistance = targetDistance;
-                        }
+    currentGameMap->getVisibilityBitmaps().visitExploredOccupiedTiles(teamHouseMask, startX, startY, endX, endY, [&](int x, int y) {
+        const Coord coord(x, y);
+
+        const auto targetDistance = blockDistance(location, coord);
+        if(targetDistance <= checkRange) {
+            Tile* pTile = currentGameMap->getTile(coord);
+            if(!pTile->isFoggedByTeam(teamID)) {
+
+                const auto pNewTarget = pTile->getObject();
+                if(((pNewTarget->getItemID() != Structure_Wall && pNewTarget->getItemID() != Unit_Carryall) || pClosestTarget == nullptr) && canAttack(pNewTarget)) {
+                    if(targetDistance < closestTargetDistance) {
+                        pClosestTarget = pNewTarget;
+                        closestTargetDistance = targetDistance;
                     }
                 }
             }
         }
-    }
+    });
 
     return pClosestTarget;
 }
@@ -22,41 +22,41 @@
 #include <Game.h>
 #include <ObjectBase.h>
 
+#include <misc/exceptions.h>
+
 void ObjectManager::save(OutputStream& stream) const {
     stream.writeUint32(nextFreeObjectID);
 
-    stream.writeUint32(objectMap.size());
-    for(const auto& objectEntry : objectMap) {
-        stream.writeUint32(objectEntry.second->getObjectID());
-        currentGame->saveObject(stream, objectEntry.second);
+    stream.writeUint32(numObjects);
+    for(ObjectBase* pObject : objectTable) {
+        if(pObject != nullptr) {
+            stream.writeUint32(pObject->getObjectID());
+            currentGame->saveObject(stream, pObject);
+        }
     }
 }
 
 void ObjectManager::load(InputStream& stream) {
     nextFreeObjectID = stream.readUint32();
+    if(nextFreeObjectID > MAX_OBJECT_ID) {
+        THROW(std::runtime_error, "ObjectManager::load(): The next free object ID %u is too large!", nextFreeObjectID);
+    }
 
-    Uint32 numObjects = stream.readUint32();
-    for(Uint32 i=0;i<numObjects;i++) {
+    // the IDs of all saved objects are below nextFreeObjectID
+    objectTable.reserve(nextFreeObjectID);
+
+    Uint32 numSavedObjects = stream.readUint32();
+    for(Uint32 i=0;i<numSavedObjects;i++) {
         Uint32 objectID = stream.readUint32();
+        if(objectID >= nextFreeObjectID) {
+            THROW(std::runtime_error, "ObjectManager::load(): The object ID %u is not below the next free object ID %u!", objectID, nextFreeObjectID);
+        }
 
         ObjectBase* pObject = currentGame->loadObject(stream,objectID);
         if(objectID != pObject->getObjectID()) {
             SDL_Log("ObjectManager::load(): The loaded object has a different ID than expected (%d!=%d)!",objectID,pObject->getObjectID());
         }
 
-        objectMap.insert( std::pair<Uint32,ObjectBase*>(objectID, pObject) );
-    }
-}
-
-Uint32 ObjectManager::addObject(ObjectBase* pObject) {
-    std::pair<ObjectMap::iterator,bool> insertPosition;
-
-    insertPosition = objectMap.insert( std::pair<Uint32,ObjectBase*>(nextFreeObjectID, pObject) );
-
-    if(insertPosition.second == false) {
-        // there is already such an object in the list
-        return NONE_ID;
-    } else {
-        return nextFreeObjectID++;  // Caution: Old value is returned but value is incremented afterwards
+        insertObject(objectID, pObject);
     }
 }
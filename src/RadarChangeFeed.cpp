@@ -0,0 +1,41 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <RadarChangeFeed.h>
+
+RadarChangeFeed::RadarChangeFeed(int sizeX, int sizeY) {
+    reset(sizeX, sizeY);
+}
+
+RadarChangeFeed::~RadarChangeFeed() = default;
+
+void RadarChangeFeed::reset(int sizeX, int sizeY) {
+    this->sizeX = sizeX;
+    bAllChanged = true;
+    changedTiles.clear();
+    changedFlags.assign(sizeX * sizeY, 0);
+    fogChecks = decltype(fogChecks)();
+}
+
+void RadarChangeFeed::update(Uint32 currentCycle) {
+    while(!fogChecks.empty() && (fogChecks.top().first <= currentCycle)) {
+        const int index = fogChecks.top().second;
+        fogChecks.pop();
+        markChanged(index % sizeX, index / sizeX);
+    }
+}
@@ -32,6 +32,8 @@
 
 #include <misc/draw_util.h>
 
+#include <algorithm>
+
 
 RadarView::RadarView()
  : RadarViewBase(), currentRadarMode(RadarMode::RadarOff), animFrame(NUM_STATIC_FRAMES - 1), animCounter(NUM_STATIC_FRAME_TIME)
@@ -75,9 +77,12 @@ void RadarView::draw(Point position)
 
             calculateScaleAndOffsets(mapSizeX, mapSizeY, scale, offsetX, offsetY);
 
-            updateRadarSurface(mapSizeX, mapSizeY, scale, offsetX, offsetY);
-
-            SDL_UpdateTexture(radarTexture.get(), nullptr, radarSurface->pixels, radarSurface->pitch);
+            // only the part of the surface that changed is uploaded
+            SDL_Rect updateRect = updateRadarSurface(mapSizeX, mapSizeY, scale, offsetX, offsetY);
+            if((updateRect.w > 0) && (updateRect.h > 0)) {
+                const Uint8* pPixels = static_cast<const Uint8*>(radarSurface->pixels) + updateRect.y * radarSurface->pitch + updateRect.x * sizeof(Uint32);
+                SDL_UpdateTexture(radarTexture.get(), &updateRect, pPixels, radarSurface->pitch);
+            }
 
             SDL_Rect dest = calcDrawingRect(radarTexture.get(), radarPosition.x, radarPosition.y);
             SDL_RenderCopy(renderer, radarTexture.get(), nullptr, &dest);
@@ -192,25 +197,58 @@ void RadarView::switchRadarMode(bool bOn) {
     }
 }
 
-void RadarView::updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int offsetX, int offsetY) {
+SDL_Rect RadarView::updateRadarSurface(int mapSizeX, int mapSizeY, int scale, int offsetX, int offsetY) {
+    const bool bRadar = ((currentRadarMode == RadarMode::RadarOn) || (currentRadarMode == RadarMode::AnimationRadarOff));
+
+    RadarChangeFeed& radarChangeFeed = currentGameMap->getRadarChangeFeed();
+    if(!bSurfaceValid || (bRadar != bLastRadar) || (debug != bLastDebug)) {
+        // every tile looks different now
+        radarChangeFeed.markAllChanged();
+        bSurfaceValid = true;
+        bLastRadar = bRadar;
+        bLastDebug = debug;
+    }
+
+    int minX = mapSizeX;
+    int minY = mapSizeY;
+    int maxX = -1;
+    int maxY = -1;
+
     sdl2::surface_lock lock{ radarSurface.get() };
-    for(int x = 0; x <  mapSizeX; x++) {
-        for(int y = 0; y <  mapSizeY; y++) {
 
-            Tile* pTile = currentGameMap->getTile(x,y);
+    const auto paintTile = [&](int x, int y) {
+        Tile* pTile = currentGameMap->getTile(x,y);
 
-            /* Selecting the right color is handled in Tile::getRadarColor() */
-            Uint32 color = pTile->getRadarColor(pLocalHouse, ((currentRadarMode == RadarMode::RadarOn) || (currentRadarMode == RadarMode::AnimationRadarOff)));
-            color = MapRGBA(radarSurface->format, color);
+        /* Selecting the right color is handled in Tile::getRadarColor() */
+        Uint32 color = pTile->getRadarColor(pLocalHouse, bRadar);
+        color = MapRGBA(radarSurface->format, color);
 
-            for(int j = 0; j < scale; j++) {
-                Uint32* p = ((Uint32*) ((Uint8 *) radarSurface->pixels + (offsetY + scale*y + j) * radarSurface->pitch)) + (offsetX + scale*x);
+        for(int j = 0; j < scale; j++) {
+            Uint32* p = ((Uint32*) ((Uint8 *) radarSurface->pixels + (offsetY + scale*y + j) * radarSurface->pitch)) + (offsetX + scale*x);
 
-                for(int i = 0; i < scale; i++, p++) {
-                    // Do not use putPixel here to avoid overhead
-                    *p = color;
-                }
+            for(int i = 0; i < scale; i++, p++) {
+                // Do not use putPixel here to avoid overhead
+                *p = color;
+            }
+        }
+
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    };
+
+    if(radarChangeFeed.consume(paintTile) == false) {
+        for(int x = 0; x <  mapSizeX; x++) {
+            for(int y = 0; y <  mapSizeY; y++) {
+                paintTile(x, y);
             }
         }
     }
+
+    if(maxX < 0) {
+        return { 0, 0, 0, 0 };
+    }
+
+    return { offsetX + scale*minX, offsetY + scale*minY, scale*(maxX - minX + 1), scale*(maxY - minY + 1) };
 }
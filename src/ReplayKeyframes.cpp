@@ -0,0 +1,173 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <ReplayKeyframes.h>
+
+#include <FileClasses/lodepng.h>
+
+#include <misc/exceptions.h>
+
+#include <vector>
+
+constexpr Uint32 ReplayKeyframes::KEYFRAME_MARKER;
+constexpr Uint32 ReplayKeyframes::KEYFRAME_INTERVAL;
+constexpr Uint32 ReplayKeyframes::MAX_COMPRESSION_RATIO;
+
+ReplayKeyframes::ReplayKeyframes()
+ : compressorThread(nullptr) {
+    SDL_AtomicSet(&bFinished, 0);
+}
+
+ReplayKeyframes::~ReplayKeyframes() {
+    waitForCompletion();
+}
+
+OMemoryStream& ReplayKeyframes::getBuffer() {
+    waitForCompletion();
+
+    // leave some room as the game usually grows
+    buffer.open(lastKeyframeSize + lastKeyframeSize / 8);
+    return buffer;
+}
+
+void ReplayKeyframes::addInBackground(Uint32 cycle) {
+    if((compressorThread != nullptr) || (SDL_AtomicGet(&bFinished) != 0)) {
+        THROW(std::runtime_error, "ReplayKeyframes::addInBackground(): The last keyframe has not been added yet!");
+    }
+
+    pendingCycle = cycle;
+    lastKeyframeSize = buffer.getDataLength();
+
+    compressorThread = SDL_CreateThread(compressorThreadMain, "ReplayKeyframes", (void*) this);
+    if(compressorThread == nullptr) {
+        // we can still compress it in this thread
+        SDL_Log("ReplayKeyframes: Unable to create thread: %s", SDL_GetError());
+        compressorThreadMain(this);
+    }
+}
+
+void ReplayKeyframes::waitForCompletion() {
+    if(compressorThread != nullptr) {
+        SDL_WaitThread(compressorThread, nullptr);
+        compressorThread = nullptr;
+    }
+}
+
+Uint32 ReplayKeyframes::pollFinished() {
+    if(SDL_AtomicGet(&bFinished) == 0) {
+        return 0;
+    }
+
+    waitForCompletion();
+    SDL_AtomicSet(&bFinished, 0);
+
+    if(pendingError != 0) {
+        SDL_Log("ReplayKeyframes::pollFinished(): Compressing keyframe of cycle %d failed: %s", pendingCycle, lodepng_error_text(pendingError));
+        return 0;
+    }
+
+    keyframes[pendingCycle] = std::move(pendingKeyframe);
+    return pendingCycle;
+}
+
+unsigned ReplayKeyframes::compress(const char* pSavegame, size_t length, Keyframe& keyframe) {
+    // a savegame compresses very well, so the fast default settings are good enough
+    std::vector<unsigned char> compressed;
+    const unsigned error = lodepng::compress(compressed, reinterpret_cast<const unsigned char*>(pSavegame), length);
+    if(error != 0) {
+        return error;
+    }
+
+    keyframe.uncompressedLength = static_cast<Uint32>(length);
+    keyframe.data.assign(compressed.begin(), compressed.end());
+    return 0;
+}
+
+int ReplayKeyframes::compressorThreadMain(void* data) {
+    ReplayKeyframes* pReplayKeyframes = static_cast<ReplayKeyframes*>(data);
+
+    pReplayKeyframes->pendingError = compress(pReplayKeyframes->buffer.getData(), pReplayKeyframes->buffer.getDataLength(), pReplayKeyframes->pendingKeyframe);
+
+    SDL_AtomicSet(&pReplayKeyframes->bFinished, 1);
+    return 0;
+}
+
+void ReplayKeyframes::save(OutputStream& stream, Uint32 cycle) const {
+    const Keyframe& keyframe = keyframes.at(cycle);
+
+    stream.writeUint32(KEYFRAME_MARKER);
+    stream.writeUint32(cycle);
+    stream.writeUint32(keyframe.uncompressedLength);
+    stream.writeString(keyframe.data);
+}
+
+void ReplayKeyframes::saveAll(OutputStream& stream) const {
+    for(const auto& keyframe : keyframes) {
+        save(stream, keyframe.first);
+    }
+}
+
+void ReplayKeyframes::load(InputStream& stream) {
+    const Uint32 cycle = stream.readUint32();
+
+    Keyframe keyframe;
+    keyframe.uncompressedLength = stream.readUint32();
+    keyframe.data = stream.readString();
+
+    if(keyframe.uncompressedLength / MAX_COMPRESSION_RATIO > keyframe.data.size()) {
+        // the replay can still be played without this keyframe
+        SDL_Log("ReplayKeyframes::load(): Ignoring corrupt keyframe of cycle %d", cycle);
+        return;
+    }
+
+    keyframes[cycle] = std::move(keyframe);
+}
+
+Uint32 ReplayKeyframes::findKeyframe(Uint32 cycle) const {
+    auto iter = keyframes.upper_bound(cycle);
+    if(iter == keyframes.begin()) {
+        return 0;
+    }
+
+    return (--iter)->first;
+}
+
+std::vector<Uint32> ReplayKeyframes::getKeyframeCycles() const {
+    std::vector<Uint32> cycles;
+    cycles.reserve(keyframes.size());
+    for(const auto& keyframe : keyframes) {
+        cycles.push_back(keyframe.first);
+    }
+    return cycles;
+}
+
+std::string ReplayKeyframes::getSavegame(Uint32 cycle) const {
+    const Keyframe& keyframe = keyframes.at(cycle);
+
+    std::vector<unsigned char> savegame;
+    const unsigned error = lodepng::decompress(savegame, reinterpret_cast<const unsigned char*>(keyframe.data.data()), keyframe.data.size());
+    if(error != 0) {
+        THROW(std::runtime_error, "ReplayKeyframes::getSavegame(): Decompressing keyframe of cycle %d failed: %s!", cycle, lodepng_error_text(error));
+    }
+
+    if(savegame.size() != keyframe.uncompressedLength) {
+        THROW(std::runtime_error, "ReplayKeyframes::getSavegame(): Keyframe of cycle %d is corrupt!", cycle);
+    }
+
+    return std::string(savegame.begin(), savegame.end());
+}
@@ -0,0 +1,122 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <SaveGameWriter.h>
+
+#include <misc/OFileStream.h>
+#include <misc/FileSystem.h>
+
+#include <misc/exceptions.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+SaveGameWriter::SaveGameWriter()
+ : writerThread(nullptr) {
+    SDL_AtomicSet(&bFinished, 0);
+}
+
+SaveGameWriter::~SaveGameWriter() {
+    waitForCompletion();
+}
+
+OMemoryStream& SaveGameWriter::getBuffer() {
+    waitForCompletion();
+
+    // leave some room as the game usually grows
+    buffer.open(lastSaveGameSize + lastSaveGameSize / 8);
+    return buffer;
+}
+
+void SaveGameWriter::writeInBackground(const std::string& filename) {
+    if(writerThread != nullptr) {
+        THROW(std::runtime_error, "SaveGameWriter::writeInBackground(): A savegame is already being written!");
+    }
+
+    this->filename = filename;
+    errorMessage.clear();
+    lastSaveGameSize = buffer.getDataLength();
+    SDL_AtomicSet(&bFinished, 0);
+
+    writerThread = SDL_CreateThread(writerThreadMain, "SaveGameWriter", (void*) this);
+    if(writerThread == nullptr) {
+        // we can still write it in this thread
+        SDL_Log("SaveGameWriter: Unable to create thread: %s", SDL_GetError());
+        write();
+    }
+}
+
+void SaveGameWriter::waitForCompletion() {
+    if(writerThread != nullptr) {
+        SDL_WaitThread(writerThread, nullptr);
+        writerThread = nullptr;
+    }
+}
+
+bool SaveGameWriter::pollFinished() {
+    if(SDL_AtomicGet(&bFinished) == 0) {
+        return false;
+    }
+
+    waitForCompletion();
+    SDL_AtomicSet(&bFinished, 0);
+    return true;
+}
+
+int SaveGameWriter::writerThreadMain(void* data) {
+    SaveGameWriter* pSaveGameWriter = static_cast<SaveGameWriter*>(data);
+
+    pSaveGameWriter->write();
+
+    return 0;
+}
+
+void SaveGameWriter::write() {
+    const std::string tmpFilename = filename + ".tmp";
+
+    OFileStream fs;
+    if(fs.open(tmpFilename) == false) {
+        errorMessage = std::string("Cannot open \"") + tmpFilename + "\": " + strerror(errno);
+    } else {
+        try {
+            fs.writeBytes(buffer.getData(), buffer.getDataLength());
+            fs.close();
+
+            if(replaceFile(tmpFilename, filename) == false) {
+                errorMessage = std::string("Cannot rename \"") + tmpFilename + "\" to \"" + filename + "\"";
+            }
+        } catch(std::exception& e) {
+            errorMessage = std::string("Cannot write \"") + tmpFilename + "\"";
+        }
+
+        if(!errorMessage.empty()) {
+            try {
+                fs.close();
+            } catch(OutputStream::exception&) {
+                // already failed; no exception may leave the writer thread
+            }
+            remove(tmpFilename.c_str());
+        }
+    }
+
+    if(!errorMessage.empty()) {
+        SDL_Log("SaveGameWriter::write(): %s", errorMessage.c_str());
+    }
+
+    SDL_AtomicSet(&bFinished, 1);
+}
@@ -0,0 +1,81 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <SpatialIndex.h>
+
+#include <ObjectBase.h>
+
+SpatialIndex::SpatialIndex(int sizeX, int sizeY) {
+    reset(sizeX, sizeY);
+}
+
+SpatialIndex::~SpatialIndex() = default;
+
+void SpatialIndex::reset(int sizeX, int sizeY) {
+    this->sizeX = sizeX;
+    this->sizeY = sizeY;
+    numBucketsX = (sizeX + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    numBucketsY = (sizeY + BUCKET_SIZE - 1) / BUCKET_SIZE;
+
+    for(Grid* pGrid : { &unitGrid, &structureGrid }) {
+        pGrid->buckets.clear();
+        pGrid->buckets.resize(numBucketsX * numBucketsY);
+        pGrid->unplacedObjects.clear();
+    }
+}
+
+void SpatialIndex::addObject(ObjectBase* pObject) {
+    Grid& grid = pObject->isAStructure() ? structureGrid : unitGrid;
+    getBucket(grid, pObject->getLocation()).push_back(pObject);
+}
+
+void SpatialIndex::removeObject(ObjectBase* pObject) {
+    Grid& grid = pObject->isAStructure() ? structureGrid : unitGrid;
+    std::vector<ObjectBase*>& bucket = getBucket(grid, pObject->getLocation());
+
+    const auto iter = std::find(bucket.begin(), bucket.end(), pObject);
+    if(iter != bucket.end()) {
+        // the order inside a bucket does not matter
+        *iter = bucket.back();
+        bucket.pop_back();
+    }
+}
+
+void SpatialIndex::moveObject(ObjectBase* pObject, const Coord& oldLocation) {
+    Grid& grid = pObject->isAStructure() ? structureGrid : unitGrid;
+    std::vector<ObjectBase*>& oldBucket = getBucket(grid, oldLocation);
+    std::vector<ObjectBase*>& newBucket = getBucket(grid, pObject->getLocation());
+    if(&oldBucket == &newBucket) {
+        return;
+    }
+
+    const auto iter = std::find(oldBucket.begin(), oldBucket.end(), pObject);
+    if(iter != oldBucket.end()) {
+        *iter = oldBucket.back();
+        oldBucket.pop_back();
+    }
+
+    newBucket.push_back(pObject);
+}
+
+std::vector<ObjectBase*>& SpatialIndex::getBucket(Grid& grid, const Coord& location) {
+    if(!isInside(location)) {
+        return grid.unplacedObjects;
+    }
+
+    return grid.buckets[(location.y / BUCKET_SIZE) * numBucketsX + (location.x / BUCKET_SIZE)];
+}
@@ -0,0 +1,29 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <StateHash.h>
+
+const char* StateHash::getCategoryName(Category category) {
+    switch(category) {
+        case Category_TileSpice:        return "tile spice";
+        case Category_HouseCredits:     return "house credits";
+        case Category_ObjectHealth:     return "object health";
+        case Category_ObjectPosition:   return "object positions";
+        case Category_Random:           return "random seed";
+        default:                        return "unknown";
+    }
+}
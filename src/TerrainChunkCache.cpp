@@ -0,0 +1,139 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <TerrainChunkCache.h>
+
+#include <globals.h>
+
+#include <Map.h>
+#include <ScreenBorder.h>
+#include <misc/SpriteBatch.h>
+
+#include <algorithm>
+
+void TerrainChunkCache::draw(const Map& map, SpriteBatch& spriteBatch, int x1, int y1, int x2, int y2) {
+    if((zoomlevel != currentZoomlevel) || (numChunksX != map.getNumTerrainChunksX()) || (numChunksY != map.getNumTerrainChunksY())) {
+        clear();
+        zoomlevel = currentZoomlevel;
+        numChunksX = map.getNumTerrainChunksX();
+        numChunksY = map.getNumTerrainChunksY();
+        chunks.resize(numChunksX * numChunksY);
+    }
+
+    if((x1 >= x2) || (y1 >= y2)) {
+        return;
+    }
+
+    frame++;
+
+    const int chunkSize = Map::TERRAIN_CHUNK_SIZE;
+    const int zoomedTileSize = world2zoomedWorld(TILESIZE);
+
+    for(int chunkY = y1 / chunkSize; chunkY <= (y2 - 1) / chunkSize; chunkY++) {
+        for(int chunkX = x1 / chunkSize; chunkX <= (x2 - 1) / chunkSize; chunkX++) {
+            Chunk& chunk = chunks[chunkY * numChunksX + chunkX];
+
+            if((chunk.pTexture == nullptr) || (chunk.version != map.getTerrainChunkVersion(chunkX, chunkY))) {
+                renderChunk(map, spriteBatch, chunk, chunkX, chunkY);
+            }
+            chunk.lastDrawn = frame;
+
+            const int tilesX = std::min(chunkSize, map.getSizeX() - chunkX * chunkSize);
+            const int tilesY = std::min(chunkSize, map.getSizeY() - chunkY * chunkSize);
+            SDL_Rect dest = {   screenborder->world2screenX(chunkX * chunkSize * TILESIZE),
+                                screenborder->world2screenY(chunkY * chunkSize * TILESIZE),
+                                tilesX * zoomedTileSize, tilesY * zoomedTileSize };
+            spriteBatch.copy(chunk.pTexture.get(), nullptr, &dest);
+        }
+    }
+
+    releaseUnusedChunks();
+}
+
+void TerrainChunkCache::clear() {
+    chunks.clear();
+    numChunksX = 0;
+    numChunksY = 0;
+    zoomlevel = -1;
+    numCachedPixels = 0;
+}
+
+void TerrainChunkCache::renderChunk(const Map& map, SpriteBatch& spriteBatch, Chunk& chunk, int chunkX, int chunkY) {
+    const int chunkSize = Map::TERRAIN_CHUNK_SIZE;
+    const int zoomedTileSize = world2zoomedWorld(TILESIZE);
+    const int tileX = chunkX * chunkSize;
+    const int tileY = chunkY * chunkSize;
+    const int tilesX = std::min(chunkSize, map.getSizeX() - tileX);
+    const int tilesY = std::min(chunkSize, map.getSizeY() - tileY);
+
+    if(chunk.pTexture == nullptr) {
+        chunk.pTexture = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SCREEN_FORMAT, SDL_TEXTUREACCESS_TARGET, tilesX * zoomedTileSize, tilesY * zoomedTileSize) };
+        if(chunk.pTexture == nullptr) {
+            THROW(std::runtime_error, "TerrainChunkCache::renderChunk(): Cannot create chunk texture: %s", SDL_GetError());
+        }
+        // the ground is opaque
+        SDL_SetTextureBlendMode(chunk.pTexture.get(), SDL_BLENDMODE_NONE);
+        numCachedPixels += tilesX * zoomedTileSize * tilesY * zoomedTileSize;
+    }
+
+    // the sprites collected so far belong to the old render target
+    spriteBatch.flush();
+
+    SDL_Texture* oldRenderTarget = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, chunk.pTexture.get());
+
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+    for(int y = 0; y < tilesY; y++) {
+        for(int x = 0; x < tilesX; x++) {
+            map.getTile(tileX + x, tileY + y)->blitTerrain(x * zoomedTileSize, y * zoomedTileSize);
+        }
+    }
+
+    spriteBatch.flush();
+
+    SDL_SetRenderTarget(renderer, oldRenderTarget);
+
+    chunk.version = map.getTerrainChunkVersion(chunkX, chunkY);
+    numRenderedChunks++;
+}
+
+void TerrainChunkCache::releaseUnusedChunks() {
+    while(numCachedPixels > MAX_CACHED_PIXELS) {
+        // release the chunk that was not drawn for the longest time but never one drawn in this frame
+        Chunk* pOldest = nullptr;
+        for(auto& chunk : chunks) {
+            if((chunk.pTexture != nullptr) && (chunk.lastDrawn != frame) && ((pOldest == nullptr) || (chunk.lastDrawn < pOldest->lastDrawn))) {
+                pOldest = &chunk;
+            }
+        }
+
+        if(pOldest == nullptr) {
+            return;
+        }
+
+        int w, h;
+        SDL_QueryTexture(pOldest->pTexture.get(), nullptr, nullptr, &w, &h);
+        numCachedPixels -= w * h;
+        pOldest->pTexture.reset();
+    }
+}
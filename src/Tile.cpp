@@ -35,6 +35,31 @@
 
 #define FOGTIME MILLI2CYCLES(10 * 1000)
 
+namespace {
+
+    /**
+        Reads a list of object ids in the format of OutputStream::writeUint32List().
+    */
+    template<typename List>
+    void readObjectList(InputStream& stream, List& list) {
+        const Uint32 size = stream.readUint32();
+        list.clear();
+        for (Uint32 i = 0; i < size; i++) {
+            list.push_back(stream.readUint32());
+        }
+    }
+
+    /**
+        Writes a list of object ids in the format of OutputStream::writeUint32List().
+    */
+    template<typename List>
+    void writeObjectList(OutputStream& stream, const List& list) {
+        stream.writeUint32(static_cast<Uint32>(list.size()));
+        stream.writeUint32Array(list.data(), list.size());
+    }
+
+}
+
 Tile::Tile() {
     type = Terrain_Sand;
 
@@ -84,6 +109,7 @@ void Tile::load(InputStream& stream) {
     owner = stream.readSint32();
     sandRegion = stream.readUint32();
 
+    // the location is not known yet, so the spice is added to the state hash by Map::load() (see addSpiceToStateHash())
     spice = stream.readFixPoint();
 
     bool bHasDamage, bHasDeadUnits, bHasAirUnits, bHasInfantry, bHasUndergroundUnits, bHasNonInfantryGroundObjects;
@@ -133,19 +159,19 @@ void Tile::load(InputStream& stream) {
     }
 
     if (bHasAirUnits) {
-        assignedAirUnitList = stream.readUint32List();
+        readObjectList(stream, assignedAirUnitList);
     }
 
     if (bHasInfantry) {
-        assignedInfantryList = stream.readUint32List();
+        readObjectList(stream, assignedInfantryList);
     }
 
     if (bHasUndergroundUnits) {
-        assignedUndergroundUnitList = stream.readUint32List();
+        readObjectList(stream, assignedUndergroundUnitList);
     }
 
     if (bHasNonInfantryGroundObjects) {
-        assignedNonInfantryGroundObjectList = stream.readUint32List();
+        readObjectList(stream, assignedNonInfantryGroundObjectList);
     }
 }
 
@@ -154,8 +180,15 @@ void Tile::save(OutputStream& stream) const {
 
     stream.writeBools(explored[0], explored[1], explored[2], explored[3], explored[4], explored[5], explored[6]);
 
-    stream.writeBools((lastAccess[0] != 0), (lastAccess[1] != 0), (lastAccess[2] != 0), (lastAccess[3] != 0), (lastAccess[4] != 0), (lastAccess[5] != 0), (lastAccess[6] != 0));
-    for (auto lastAccessFromTeam : lastAccess) {
+    // tiles that are currently seen were last seen now
+    Uint32 currentLastAccess[NUM_TEAMS];
+    for (int i = 0; i < NUM_TEAMS; i++) {
+        const bool bObserved = (i < NUM_HOUSES) && currentGameMap->getFogOfWar().isObservedByHouse(i, location);
+        currentLastAccess[i] = bObserved ? currentGame->getGameCycleCount() : lastAccess[i];
+    }
+
+    stream.writeBools((currentLastAccess[0] != 0), (currentLastAccess[1] != 0), (currentLastAccess[2] != 0), (currentLastAccess[3] != 0), (currentLastAccess[4] != 0), (currentLastAccess[5] != 0), (currentLastAccess[6] != 0));
+    for (auto lastAccessFromTeam : currentLastAccess) {
         if (lastAccessFromTeam != 0) {
             stream.writeUint32(lastAccessFromTeam);
         }
@@ -210,28 +243,30 @@ void Tile::save(OutputStream& stream) const {
     }
 
     if (!assignedAirUnitList.empty()) {
-        stream.writeUint32List(assignedAirUnitList);
+        writeObjectList(stream, assignedAirUnitList);
     }
 
     if (!assignedInfantryList.empty()) {
-        stream.writeUint32List(assignedInfantryList);
+        writeObjectList(stream, assignedInfantryList);
     }
 
     if (!assignedUndergroundUnitList.empty()) {
-        stream.writeUint32List(assignedUndergroundUnitList);
+        writeObjectList(stream, assignedUndergroundUnitList);
     }
 
     if (!assignedNonInfantryGroundObjectList.empty()) {
-        stream.writeUint32List(assignedNonInfantryGroundObjectList);
+        writeObjectList(stream, assignedNonInfantryGroundObjectList);
     }
 }
 
 void Tile::assignAirUnit(Uint32 newObjectID) {
     assignedAirUnitList.push_back(newObjectID);
+    updateOccupied();
 }
 
 void Tile::assignNonInfantryGroundObject(Uint32 newObjectID) {
     assignedNonInfantryGroundObjectList.push_back(newObjectID);
+    updateOccupied();
 }
 
 int Tile::assignInfantry(Uint32 newObjectID, Sint8 currentPosition) {
@@ -262,18 +297,17 @@ int Tile::assignInfantry(Uint32 newObjectID, Sint8 currentPosition) {
     }
 
     assignedInfantryList.push_back(newObjectID);
+    updateOccupied();
     return newPosition;
 }
 
 
 void Tile::assignUndergroundUnit(Uint32 newObjectID) {
     assignedUndergroundUnitList.push_back(newObjectID);
+    updateOccupied();
 }
 
-void Tile::blitGround(int xPos, int yPos) {
-    if (hasANonInfantryGroundObject() && getNonInfantryGroundObject()->isAStructure())
-        return;
-
+void Tile::blitTerrain(int xPos, int yPos) const {
     const auto tileIndex = getTerrainTile();
     const auto indexX = tileIndex % NUM_TERRAIN_TILES_X;
     const auto indexY = tileIndex / NUM_TERRAIN_TILES_X;
@@ -283,14 +317,23 @@ void Tile::blitGround(int xPos, int yPos) {
 
     //draw terrain
     if (destroyedStructureTile == DestroyedStructure_None || destroyedStructureTile == DestroyedStructure_Wall) {
-        SDL_RenderCopy(renderer, sprite[currentZoomlevel], &source, &drawLocation);
+        currentGame->getSpriteBatch().copy(sprite[currentZoomlevel], &source, &drawLocation);
     }
 
     if (destroyedStructureTile != DestroyedStructure_None) {
         SDL_Texture* pDestroyedStructureTex = pGFXManager->getZoomedObjPic(ObjPic_DestroyedStructure, currentZoomlevel);
         SDL_Rect source2 = { destroyedStructureTile*zoomed_tilesize, 0, zoomed_tilesize, zoomed_tilesize };
-        SDL_RenderCopy(renderer, pDestroyedStructureTex, &source2, &drawLocation);
+        currentGame->getSpriteBatch().copy(pDestroyedStructureTex, &source2, &drawLocation);
     }
+}
+
+void Tile::blitGround(int xPos, int yPos) {
+    if (hasANonInfantryGroundObject() && getNonInfantryGroundObject()->isAStructure())
+        return;
+
+    const auto zoomed_tilesize = world2zoomedWorld(TILESIZE);
+    SDL_Rect source = { 0, 0, zoomed_tilesize, zoomed_tilesize };
+    SDL_Rect drawLocation = { xPos, yPos, zoomed_tilesize, zoomed_tilesize };
 
     if (isFoggedByTeam(pLocalHouse->getTeamID()))
         return;
@@ -302,7 +345,7 @@ void Tile::blitGround(int xPos, int yPos) {
         if ((tracksCreationTime[i] != 0) && (tracktime < TRACKSTIME)) {
             source.x = ((10 - i) % 8)*zoomed_tilesize;
             SDL_SetTextureAlphaMod(pTracks, std::min(255, 256 * (TRACKSTIME - tracktime) / TRACKSTIME));
-            SDL_RenderCopy(renderer, pTracks, &source, &drawLocation);
+            currentGame->getSpriteBatch().copy(pTracks, &source, &drawLocation);
         }
     }
 
@@ -315,10 +358,10 @@ void Tile::blitGround(int xPos, int yPos) {
             zoomed_tilesize };
 
         if (damageItem.damageType == Terrain_RockDamage) {
-            SDL_RenderCopy(renderer, pGFXManager->getZoomedObjPic(ObjPic_RockDamage, currentZoomlevel), &source, &dest);
+            currentGame->getSpriteBatch().copy(pGFXManager->getZoomedObjPic(ObjPic_RockDamage, currentZoomlevel), &source, &dest);
         }
         else {
-            SDL_RenderCopy(renderer, pGFXManager->getZoomedObjPic(ObjPic_SandDamage, currentZoomlevel), &source, &drawLocation);
+            currentGame->getSpriteBatch().copy(pGFXManager->getZoomedObjPic(ObjPic_SandDamage, currentZoomlevel), &source, &drawLocation);
         }
     }
 }
@@ -419,7 +462,7 @@ void Tile::blitDeadUnits(int xPos, int yPos) {
                 screenborder->world2screenY(deadUnit.realPos.y) - zoomed_tile / 2,
                 zoomed_tile,
                 zoomed_tile };
-            SDL_RenderCopy(renderer, pTexture, &source, &dest);
+            currentGame->getSpriteBatch().copy(pTexture, &source, &dest);
         }
     }
 }
@@ -517,6 +560,20 @@ void Tile::blitSelectionRects(int xPos, int yPos) const {
                     blitObjectSelectionRect);
 }
 
+void Tile::assignDeadUnit(Uint8 type, Uint8 house, const Coord& position) {
+    DEADUNITTYPE newDeadUnit;
+    newDeadUnit.type = type;
+    newDeadUnit.house = house;
+    newDeadUnit.onSand = isSand() || isDunes();
+    newDeadUnit.realPos = position;
+    newDeadUnit.timer = 2000;
+
+    deadUnits.push_back(newDeadUnit);
+
+    // the timer of the dead unit runs down in update()
+    currentGameMap->activateTile(location);
+}
+
 void Tile::update_impl()
 {
     deadUnits.erase(
@@ -556,18 +613,53 @@ void Tile::selectAllPlayersUnitsOfType(int houseID, int itemID, ObjectBase** las
 
 void Tile::unassignAirUnit(Uint32 objectID) {
     assignedAirUnitList.remove(objectID);
+    updateOccupied();
 }
 
 void Tile::unassignNonInfantryGroundObject(Uint32 objectID) {
     assignedNonInfantryGroundObjectList.remove(objectID);
+    updateOccupied();
 }
 
 void Tile::unassignUndergroundUnit(Uint32 objectID) {
     assignedUndergroundUnitList.remove(objectID);
+    updateOccupied();
 }
 
 void Tile::unassignInfantry(Uint32 objectID, int currentPosition) {
     assignedInfantryList.remove(objectID);
+    updateOccupied();
+}
+
+void Tile::setExplored(int houseID, Uint32 cycle) {
+    lastAccess[houseID] = cycle;
+    explored[houseID] = true;
+    currentGameMap->getVisibilityBitmaps().setExplored(houseID, location.x, location.y);
+
+    auto& radarChangeFeed = currentGameMap->getRadarChangeFeed();
+    radarChangeFeed.markChanged(location.x, location.y);
+    radarChangeFeed.scheduleFogCheck(location.x, location.y, cycle + FOGTIME);
+}
+
+Uint32 Tile::getFoggingCycle() const noexcept {
+    Uint32 foggingCycle = 0;
+    for (auto h = 0; h < NUM_HOUSES; h++) {
+        if (explored[h]) {
+            foggingCycle = std::max(foggingCycle, lastAccess[h] + FOGTIME);
+        }
+    }
+    return foggingCycle;
+}
+
+void Tile::updateOccupied() {
+    currentGameMap->getVisibilityBitmaps().setOccupied(location.x, location.y, hasAnObject());
+    currentGameMap->getRadarChangeFeed().markChanged(location.x, location.y);
+    currentGameMap->getTileAttributes().updateOccupancy(*this);
+}
+
+void Tile::setOwner(int newOwner) {
+    owner = newOwner;
+    currentGameMap->getTileAttributes().setOwner(location.x, location.y, owner);
 }
 
 void Tile::unassignObject(Uint32 objectID) {
@@ -581,54 +673,50 @@ void Tile::unassignObject(Uint32 objectID) {
 void Tile::setType(int newType) {
     type = newType;
     destroyedStructureTile = DestroyedStructure_None;
+    currentGameMap->getTileAttributes().setType(location.x, location.y, type);
 
     if (type == Terrain_Spice) {
-        spice = currentGame->randomGen.rand(RANDOMSPICEMIN, RANDOMSPICEMAX);
+        changeSpice(currentGame->randomGen.rand(RANDOMSPICEMIN, RANDOMSPICEMAX));
     }
     else if (type == Terrain_ThickSpice) {
-        spice = currentGame->randomGen.rand(RANDOMTHICKSPICEMIN, RANDOMTHICKSPICEMAX);
+        changeSpice(currentGame->randomGen.rand(RANDOMTHICKSPICEMIN, RANDOMTHICKSPICEMAX));
     }
     else if (type == Terrain_Dunes) {
     }
     else {
-        spice = 0;
+        changeSpice(0);
 
         if (isRock()) {
             sandRegion = NONE_ID;
-            if (hasAnUndergroundUnit()) {
-                auto iter = assignedUndergroundUnitList.begin();
-
-                do {
-                    ObjectBase* current = currentGame->getObjectManager().getObject(*iter);
-                    ++iter;
+            // iterate over copies of the lists as destroying the objects modifies them
+            const auto undergroundUnitList = assignedUndergroundUnitList;
+            for (const auto objectID : undergroundUnitList) {
+                ObjectBase* current = currentGame->getObjectManager().getObject(objectID);
 
-                    if(current == nullptr)
-                        continue;
+                if(current == nullptr)
+                    continue;
 
-                    unassignUndergroundUnit(current->getObjectID());
-                    current->destroy();
-                } while(iter != assignedUndergroundUnitList.end());
+                unassignUndergroundUnit(current->getObjectID());
+                current->destroy();
             }
 
             if (type == Terrain_Mountain) {
-                if (hasANonInfantryGroundObject()) {
-                    auto iter = assignedNonInfantryGroundObjectList.begin();
-
-                    do {
-                        ObjectBase* current = currentGame->getObjectManager().getObject(*iter);
-                        ++iter;
+                const auto nonInfantryGroundObjectList = assignedNonInfantryGroundObjectList;
+                for (const auto objectID : nonInfantryGroundObjectList) {
+                    ObjectBase* current = currentGame->getObjectManager().getObject(objectID);
 
-                        if(current == nullptr)
-                            continue;
+                    if(current == nullptr)
+                        continue;
 
-                        unassignNonInfantryGroundObject(current->getObjectID());
-                        current->destroy();
-                    } while(iter != assignedNonInfantryGroundObjectList.end());
+                    unassignNonInfantryGroundObject(current->getObjectID());
+                    current->destroy();
                 }
             }
         }
     }
 
+    currentGameMap->onTileChanged(location);
+
     currentGameMap->for_each(location.x, location.y, location.x + 4, location.y + 4, [](Tile &t) { t.clearTerrain(); });
 }
 
@@ -636,16 +724,16 @@ void Tile::setType(int newType) {
 void Tile::squash() const {
     if (!hasInfantry()) return;
 
-    auto iter = assignedInfantryList.begin();
-    do {
-        InfantryBase* current = static_cast<InfantryBase*>(currentGame->getObjectManager().getObject(*iter));
-        ++iter;
+    // squashed infantry is removed from this tile, so iterate over a copy
+    const auto infantryList = assignedInfantryList;
+    for (const auto objectID : infantryList) {
+        InfantryBase* current = static_cast<InfantryBase*>(currentGame->getObjectManager().getObject(objectID));
 
         if(current == nullptr)
             continue;
 
         current->squash();
-    } while(iter != assignedInfantryList.end());
+    }
 }
 
 
@@ -661,10 +749,10 @@ FixPoint Tile::harvestSpice() {
     const auto oldSpice = spice;
 
     if ((spice - HARVESTSPEED) >= 0) {
-        spice -= HARVESTSPEED;
+        changeSpice(spice - HARVESTSPEED);
     }
     else {
-        spice = 0;
+        changeSpice(0);
     }
 
     if (oldSpice >= RANDOMTHICKSPICEMIN && spice < RANDOMTHICKSPICEMIN) {
@@ -680,6 +768,8 @@ FixPoint Tile::harvestSpice() {
 
 
 void Tile::setSpice(FixPoint newSpice) {
+    const auto oldType = type;
+
     if (newSpice <= 0) {
         type = Terrain_Sand;
     }
@@ -689,9 +779,30 @@ void Tile::setSpice(FixPoint newSpice) {
     else {
         type = Terrain_Spice;
     }
+    changeSpice(newSpice);
+
+    if (type != oldType) {
+        currentGameMap->getTileAttributes().setType(location.x, location.y, type);
+        currentGameMap->onTileAppearanceChanged(location);
+    }
+}
+
+
+void Tile::changeSpice(FixPoint newSpice) {
+    currentGame->getStateHash().update(StateHash::Category_TileSpice, getStateHashKey(), spice.getRawValue(), newSpice.getRawValue());
     spice = newSpice;
 }
 
+void Tile::addSpiceToStateHash() const {
+    currentGame->getStateHash().add(StateHash::Category_TileSpice, getStateHashKey(), spice.getRawValue());
+}
+
+
+void Tile::setDestroyedStructureTile(int newDestroyedStructureTile) {
+    destroyedStructureTile = newDestroyedStructureTile;
+    currentGameMap->onTileAppearanceChanged(location);
+}
+
 
 AirUnit* Tile::getAirUnit() const {
     return dynamic_cast<AirUnit*>(currentGame->getObjectManager().getObject(assignedAirUnitList.front()));
@@ -964,6 +1075,10 @@ bool Tile::isFoggedByHouse(int houseID) const noexcept {
         return false;
     }
 
+    if (currentGameMap->getFogOfWar().isObservedByHouse(houseID, location)) {
+        return false;
+    }
+
     return (currentGame->getGameCycleCount() - lastAccess[houseID]) >= FOGTIME;
 }
 
@@ -978,7 +1093,7 @@ bool Tile::isFoggedByTeam(int teamID) const noexcept {
     for (auto h = 0; h < NUM_HOUSES; h++) {
         const auto* pHouse = currentGame->getHouse(h);
         if ((pHouse != nullptr) && (pHouse->getTeamID() == teamID)) {
-            if((currentGame->getGameCycleCount() - lastAccess[h]) < FOGTIME) {
+            if(currentGameMap->getFogOfWar().isObservedByHouse(h, location) || ((currentGame->getGameCycleCount() - lastAccess[h]) < FOGTIME)) {
                 return false;
             }
         }
@@ -0,0 +1,129 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <TileAttributes.h>
+
+#include <Map.h>
+#include <Tile.h>
+
+namespace {
+    /// the speed factor of every movement class on every terrain type in units of TileAttributes::TERRAINCOST_ONE
+    const Uint8 terrainCosts[TileAttributes::NUM_MOVEMENTCLASSES][Terrain_SpecialBloom+1] = {
+        //  Slab    Sand    Rock    Dunes   Mountain    Spice   ThickSpice  SpiceBloom  SpecialBloom
+        {   64,     100,    88,     88,     64,         88,     88,         100,        100 },  // Movement_Tracked
+        {   64,     88,     100,    88,     64,         88,     88,         88,         88  },  // Movement_Wheeled
+        {   64,     88,     100,    88,     64,         88,     88,         88,         88  },  // Movement_Infantry
+        {   64,     80,     64,     80,     64,         80,     80,         80,         80  },  // Movement_Sandworm
+        {   64,     64,     64,     64,     64,         64,     64,         64,         64  }   // Movement_Air
+    };
+}
+
+constexpr Uint8 TileAttributes::TERRAINCOST_ONE;
+
+TileAttributes::TileAttributes(int sizeX, int sizeY) {
+    reset(sizeX, sizeY);
+}
+
+TileAttributes::~TileAttributes() = default;
+
+void TileAttributes::reset(int sizeX, int sizeY) {
+    this->sizeX = sizeX;
+    this->sizeY = sizeY;
+
+    types.assign(sizeX * sizeY, Terrain_Sand);
+    for(int movementClass = 0; movementClass < NUM_MOVEMENTCLASSES; movementClass++) {
+        movementCosts[movementClass].assign(sizeX * sizeY, getMovementCost(static_cast<MovementClass>(movementClass), Terrain_Sand));
+    }
+    owners.assign(sizeX * sizeY, INVALID);
+    occupancy.assign(sizeX * sizeY, 0);
+    terrainVersion++;
+}
+
+void TileAttributes::rebuild(const Map& map) {
+    reset(map.getSizeX(), map.getSizeY());
+
+    map.for_all([this](const Tile& tile) {
+        setType(tile.getLocation().x, tile.getLocation().y, tile.getType());
+        setOwner(tile.getLocation().x, tile.getLocation().y, tile.getOwner());
+        updateOccupancy(tile);
+    });
+}
+
+void TileAttributes::updateOccupancy(const Tile& tile) {
+    Uint8 flags = 0;
+
+    if(tile.hasInfantry()) {
+        flags |= Occupied_Infantry;
+        if(!tile.infantryNotFull()) {
+            flags |= Occupied_InfantryFull;
+        }
+    }
+
+    if(tile.hasANonInfantryGroundObject()) {
+        flags |= Occupied_NonInfantryGround;
+        if(tile.hasAStructure()) {
+            flags |= Occupied_Structure;
+        }
+    }
+
+    if(tile.hasAnAirUnit()) {
+        flags |= Occupied_AirUnit;
+    }
+
+    if(tile.hasAnUndergroundUnit()) {
+        flags |= Occupied_UndergroundUnit;
+    }
+
+    Uint8& tileOccupancy = occupancy[getIndex(tile.getLocation().x, tile.getLocation().y)];
+    if((tileOccupancy ^ flags) & Occupied_Structure) {
+        terrainVersion++;
+    }
+    tileOccupancy = flags;
+}
+
+Uint8 TileAttributes::getTerrainCost(MovementClass movementClass, int type) {
+    if((type < 0) || (type > Terrain_SpecialBloom)) {
+        return TERRAINCOST_ONE;
+    }
+
+    return terrainCosts[movementClass][type];
+}
+
+Uint8 TileAttributes::getMovementCost(MovementClass movementClass, int type) {
+    switch(movementClass) {
+        case Movement_Tracked:
+        case Movement_Wheeled: {
+            if(type == Terrain_Mountain) {
+                return 0;
+            }
+        } break;
+
+        case Movement_Sandworm: {
+            // sandworms cannot leave the sand (see Tile::isRock())
+            if((type == Terrain_Slab) || (type == Terrain_Rock) || (type == Terrain_Mountain)) {
+                return 0;
+            }
+        } break;
+
+        default: {
+            // infantry can climb mountains and air units fly over everything
+        } break;
+    }
+
+    return getTerrainCost(movementClass, type);
+}
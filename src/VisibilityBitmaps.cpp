@@ -0,0 +1,33 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <VisibilityBitmaps.h>
+
+VisibilityBitmaps::VisibilityBitmaps(int sizeX, int sizeY) {
+    reset(sizeX, sizeY);
+}
+
+VisibilityBitmaps::~VisibilityBitmaps() = default;
+
+void VisibilityBitmaps::reset(int sizeX, int sizeY) {
+    wordsPerRow = (sizeX + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    for(auto& exploredByHouse : explored) {
+        exploredByHouse.assign(wordsPerRow * sizeY, 0);
+    }
+    occupied.assign(wordsPerRow * sizeY, 0);
+}
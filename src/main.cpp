@@ -104,9 +104,11 @@ inline std::string demangleSymbol(const char* symbolname) {
 void setVideoMode(int displayIndex);
 void realign_buttons();
 
+#ifndef DUNELEGACY_HEADLESS
 static void printUsage() {
     fprintf(stderr, "Usage:\n\tdunelegacy [--showlog] [--fullscreen|--window] [--PlayerName=X] [--ServerPort=X]\n");
 }
+#endif
 
 int getLogicalToPhysicalResolutionFactor(int physicalWidth, int physicalHeight) {
     if(physicalWidth >= 1280*3 && physicalHeight >= 720*3) {
@@ -369,6 +371,8 @@ std::string getUserLanguage() {
 
 
 
+#ifndef DUNELEGACY_HEADLESS
+// dunelegacy-headless has its own main() in HeadlessMain.cpp
 int main(int argc, char *argv[]) {
     SDL_LogSetOutputFunction(logOutputFunction, nullptr);
     SDL_LogSetAllPriority(SDL_LOG_PRIORITY_WARN);
@@ -745,3 +749,4 @@ int main(int argc, char *argv[]) {
 
     return EXIT_SUCCESS;
 }
+#endif // DUNELEGACY_HEADLESS
@@ -30,6 +30,7 @@
 #include <io.h>
 #include <direct.h>
 #include <windows.h>
+#include <sys/stat.h>
 #else
 #include <dirent.h>
 #include <sys/stat.h>
@@ -115,12 +116,18 @@ std::list<FileInfo> getFileList(const std::string& directory, const std::string&
         do {
             std::string filename = fdata.name;
 
-            if(filename.length() < lowerExtension.length()+1) {
-                continue;
-            }
+            if(lowerExtension.empty()) {
+                if(fdata.attrib & _A_SUBDIR) {
+                    continue;
+                }
+            } else {
+                if(filename.length() < lowerExtension.length()+1) {
+                    continue;
+                }
 
-            if(filename[filename.length() - lowerExtension.length() - 1] != '.') {
-                continue;
+                if(filename[filename.length() - lowerExtension.length() - 1] != '.') {
+                    continue;
+                }
             }
 
             std::string ext = filename.substr(filename.length() - lowerExtension.length());
@@ -164,12 +171,18 @@ std::list<FileInfo> getFileList(const std::string& directory, const std::string&
     while((curEntry = readdir(dir)) != nullptr) {
             std::string filename = curEntry->d_name;
 
-            if(filename.length() < lowerExtension.length()+1) {
-                continue;
-            }
+            if(lowerExtension.empty()) {
+                if((filename == ".") || (filename == "..")) {
+                    continue;
+                }
+            } else {
+                if(filename.length() < lowerExtension.length()+1) {
+                    continue;
+                }
 
-            if(filename[filename.length() - lowerExtension.length() - 1] != '.') {
-                continue;
+                if(filename[filename.length() - lowerExtension.length() - 1] != '.') {
+                    continue;
+                }
             }
 
             std::string ext = filename.substr(filename.length() - lowerExtension.length());
@@ -185,6 +198,9 @@ std::list<FileInfo> getFileList(const std::string& directory, const std::string&
                     SDL_Log("stat(): %s", strerror(errno));
                     continue;
                 }
+                if(S_ISDIR(fdata.st_mode)) {
+                    continue;
+                }
                 Files.push_back(FileInfo(filename, fdata.st_size, fdata.st_mtime));
             }
     }
@@ -326,6 +342,47 @@ bool existsFile(const std::string& path) {
     return true;
 }
 
+bool getFileSizeAndModifyDate(const std::string& filepath, uint64_t& size, uint64_t& modifydate) {
+#ifdef _WIN32
+    WCHAR szwFilepath[MAX_PATH];
+    if(MultiByteToWideChar(CP_UTF8, 0, filepath.c_str(), -1, szwFilepath, MAX_PATH) == 0) {
+        SDL_Log("getFileSizeAndModifyDate(): Conversion of file path from utf-8 to utf-16 failed!");
+        return false;
+    }
+
+    struct _stat64 fdata;
+    if(_wstat64(szwFilepath, &fdata) != 0) {
+        return false;
+    }
+#else
+    struct stat fdata;
+    if(stat(filepath.c_str(), &fdata) != 0) {
+        return false;
+    }
+#endif
+
+    size = fdata.st_size;
+    modifydate = fdata.st_mtime;
+    return true;
+}
+
+bool replaceFile(const std::string& srcPath, const std::string& destPath) {
+#ifdef _WIN32
+    WCHAR szwSrcPath[MAX_PATH];
+    WCHAR szwDestPath[MAX_PATH];
+    if((MultiByteToWideChar(CP_UTF8, 0, srcPath.c_str(), -1, szwSrcPath, MAX_PATH) == 0)
+        || (MultiByteToWideChar(CP_UTF8, 0, destPath.c_str(), -1, szwDestPath, MAX_PATH) == 0)) {
+        SDL_Log("replaceFile(): Conversion of file path from utf-8 to utf-16 failed!");
+        return false;
+    }
+
+    // rename() on windows fails if the destination exists
+    return MoveFileExW(szwSrcPath, szwDestPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(srcPath.c_str(), destPath.c_str()) == 0;
+#endif
+}
+
 std::string readCompleteFile(const std::string& filename) {
     auto RWopsFile = sdl2::RWops_ptr{ SDL_RWFromFile(filename.c_str(),"r") };
 
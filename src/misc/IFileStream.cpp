@@ -19,12 +19,14 @@
 
 #include <misc/exceptions.h>
 
-#include <SDL2/SDL_endian.h>
+#include <algorithm>
 
 #ifdef _WIN32
     #include <windows.h>
 #endif
 
+constexpr size_t IFileStream::BUFFER_SIZE;
+
 IFileStream::IFileStream()
 {
     fp = nullptr;
@@ -61,9 +63,15 @@ bool IFileStream::open(const char* filename)
 
     #endif
 
+    pReadPos = nullptr;
+    pReadEnd = nullptr;
+
     if( (fp = fopen(pFilename,"rb")) == nullptr) {
         return false;
     } else {
+        if(pBuffer == nullptr) {
+            pBuffer = std::make_unique<char[]>(BUFFER_SIZE);
+        }
         return true;
     }
 }
@@ -79,97 +87,51 @@ void IFileStream::close()
         fclose(fp);
         fp = nullptr;
     }
-}
-
-std::string IFileStream::readString()
-{
-    Uint32 length;
-
-    length = readUint32();
-
-    if(length == 0) {
-        return "";
-    } else {
-        std::string str;
-
-        str.resize(length);
 
-        if(fread(&str[0],length,1,fp) != 1) {
-            if(feof(fp) != 0) {
-                THROW(InputStream::eof, "IFileStream::readString(): End-of-File reached!");
-            } else {
-                THROW(InputStream::error, "IFileStream::readString(): An I/O-Error occurred!");
-            }
-        }
-
-        return str;
-    }
+    pReadPos = nullptr;
+    pReadEnd = nullptr;
 }
 
-Uint8 IFileStream::readUint8()
+void IFileStream::underflow(char* pData, size_t length)
 {
-    Uint8 tmp;
-    if(fread(&tmp,sizeof(Uint8),1,fp) != 1) {
-        if(feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint8(): End-of-File reached!");
-        } else {
-            THROW(InputStream::error, "IFileStream::readUint8(): An I/O-Error occurred!");
-        }
+    // first take what is left in the buffer
+    const size_t numBuffered = pReadEnd - pReadPos;
+    if(numBuffered > 0) {
+        memcpy(pData, pReadPos, numBuffered);
+        pData += numBuffered;
+        length -= numBuffered;
     }
+    pReadPos = pReadEnd;
 
-    return tmp;
-}
-
-Uint16 IFileStream::readUint16()
-{
-    Uint16 tmp;
-    if(fread(&tmp,sizeof(Uint16),1,fp) != 1) {
-        if(feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint16(): End-of-File reached!");
-        } else {
-            THROW(InputStream::error, "IFileStream::readUint16(): An I/O-Error occurred!");
-        }
+    if(fp == nullptr) {
+        THROW(InputStream::error, "IFileStream::underflow(): The stream is not open!");
     }
 
-    return SDL_SwapLE16(tmp);
-}
-
-Uint32 IFileStream::readUint32()
-{
-    Uint32 tmp;
-    if(fread(&tmp,sizeof(Uint32),1,fp) != 1) {
-        if(feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint32(): End-of-File reached!");
+    while(length > 0) {
+        size_t numRead;
+        if(length >= BUFFER_SIZE) {
+            // big blocks are read directly
+            numRead = fread(pData, 1, length, fp);
+            pData += numRead;
+            length -= numRead;
         } else {
-            THROW(InputStream::error, "IFileStream::readUint32(): An I/O-Error occurred!");
+            numRead = fread(pBuffer.get(), 1, BUFFER_SIZE, fp);
+            pReadPos = pBuffer.get();
+            pReadEnd = pBuffer.get() + numRead;
+
+            const size_t numCopy = std::min(numRead, length);
+            memcpy(pData, pReadPos, numCopy);
+            pReadPos += numCopy;
+            pData += numCopy;
+            length -= numCopy;
         }
-    }
 
-    return SDL_SwapLE32(tmp);
-}
-
-Uint64 IFileStream::readUint64()
-{
-    Uint64 tmp;
-    if(fread(&tmp,sizeof(Uint64),1,fp) != 1) {
-        if(feof(fp) != 0) {
-            THROW(InputStream::eof, "IFileStream::readUint64(): End-of-File reached!");
-        } else {
-            THROW(InputStream::error, "IFileStream::readUint64(): An I/O-Error occurred!");
+        if(numRead == 0) {
+            if(feof(fp) != 0) {
+                THROW(InputStream::eof, "IFileStream::underflow(): End-of-File reached!");
+            } else {
+                THROW(InputStream::error, "IFileStream::underflow(): An I/O-Error occurred!");
+            }
         }
     }
-    return SDL_SwapLE64(tmp);
-}
-
-bool IFileStream::readBool()
-{
-    return (readUint8() == 1 ? true : false);
-}
-
-float IFileStream::readFloat()
-{
-    Uint32 tmp = readUint32();
-    float tmp2;
-    memcpy(&tmp2,&tmp,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
-    return tmp2;
 }
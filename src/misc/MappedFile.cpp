@@ -0,0 +1,126 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <misc/MappedFile.h>
+
+#include <misc/exceptions.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #include <errno.h>
+    #include <string.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filename) {
+    WCHAR szwPath[MAX_PATH];
+    if(MultiByteToWideChar(CP_UTF8, 0, filename.c_str(), -1, szwPath, MAX_PATH) == 0) {
+        THROW(io_error, "MappedFile::MappedFile(): Conversion of '%s' from utf-8 to utf-16 failed!", filename);
+    }
+
+    hFile = CreateFileW(szwPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(hFile == INVALID_HANDLE_VALUE) {
+        hFile = nullptr;
+        THROW(io_error, "MappedFile::MappedFile(): Cannot open '%s'!", filename);
+    }
+
+    LARGE_INTEGER fileSize;
+    if(GetFileSizeEx(hFile, &fileSize) == 0) {
+        CloseHandle(hFile);
+        THROW(io_error, "MappedFile::MappedFile(): Cannot determine the size of '%s'!", filename);
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+
+    if(size == 0) {
+        // empty files cannot be mapped
+        return;
+    }
+
+    hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(hMapping == nullptr) {
+        CloseHandle(hFile);
+        THROW(io_error, "MappedFile::MappedFile(): Cannot map '%s'!", filename);
+    }
+
+    pData = static_cast<const Uint8*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+    if(pData == nullptr) {
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        THROW(io_error, "MappedFile::MappedFile(): Cannot map '%s'!", filename);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if(pData != nullptr) {
+        UnmapViewOfFile(pData);
+    }
+
+    if(hMapping != nullptr) {
+        CloseHandle(hMapping);
+    }
+
+    if(hFile != nullptr) {
+        CloseHandle(hFile);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filename) {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0) {
+        THROW(io_error, "MappedFile::MappedFile(): Cannot open '%s': %s!", filename, strerror(errno));
+    }
+
+    struct stat fileStat;
+    if(fstat(fd, &fileStat) != 0) {
+        close(fd);
+        THROW(io_error, "MappedFile::MappedFile(): Cannot determine the size of '%s': %s!", filename, strerror(errno));
+    }
+    size = static_cast<size_t>(fileStat.st_size);
+
+    if(size == 0) {
+        // empty files cannot be mapped
+        close(fd);
+        return;
+    }
+
+    void* pMapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping stays valid after closing the file
+    close(fd);
+
+    if(pMapping == MAP_FAILED) {
+        THROW(io_error, "MappedFile::MappedFile(): Cannot map '%s': %s!", filename, strerror(errno));
+    }
+
+    pData = static_cast<const Uint8*>(pMapping);
+}
+
+MappedFile::~MappedFile() {
+    if(pData != nullptr) {
+        munmap(const_cast<Uint8*>(pData), size);
+    }
+}
+
+#endif
@@ -19,12 +19,14 @@
 
 #include <misc/exceptions.h>
 
-#include <SDL2/SDL_endian.h>
+#include <string.h>
 
 #ifdef _WIN32
     #include <windows.h>
 #endif
 
+constexpr size_t OFileStream::BUFFER_SIZE;
+
 OFileStream::OFileStream()
 {
     fp = nullptr;
@@ -32,14 +34,16 @@ OFileStream::OFileStream()
 
 OFileStream::~OFileStream()
 {
-    close();
+    try {
+        close();
+    } catch(OutputStream::exception&) {
+        // call close() before to handle errors
+    }
 }
 
 bool OFileStream::open(const char* filename)
 {
-    if(fp != nullptr) {
-        fclose(fp);
-    }
+    close();
 
     const char* pFilename = filename;
 
@@ -64,6 +68,11 @@ bool OFileStream::open(const char* filename)
     if( (fp = fopen(pFilename,"wb")) == nullptr) {
         return false;
     } else {
+        if(pBuffer == nullptr) {
+            pBuffer = std::make_unique<char[]>(BUFFER_SIZE);
+        }
+        pWritePos = pBuffer.get();
+        pWriteEnd = pBuffer.get() + BUFFER_SIZE;
         return true;
     }
 }
@@ -76,69 +85,63 @@ bool OFileStream::open(const std::string& filename)
 void OFileStream::close()
 {
     if(fp != nullptr) {
-        fclose(fp);
+        // the file is closed even if the rest cannot be written
+        bool bError = false;
+        try {
+            writeBuffer();
+        } catch(OutputStream::exception&) {
+            bError = true;
+        }
+
+        if(fclose(fp) != 0) {
+            bError = true;
+        }
         fp = nullptr;
+
+        pWritePos = nullptr;
+        pWriteEnd = nullptr;
+
+        if(bError) {
+            THROW(OutputStream::error, "OFileStream::close(): An I/O-Error occurred!");
+        }
     }
 }
 
 void OFileStream::flush() {
     if(fp != nullptr) {
+        writeBuffer();
         fflush(fp);
     }
 }
 
-void OFileStream::writeString(const std::string& str)
+void OFileStream::overflow(const char* pData, size_t length)
 {
-    writeUint32(str.length());
-
-    if(!str.empty()) {
-        if(fwrite(str.c_str(),str.length(),1,fp) != 1) {
-            THROW(OutputStream::error, "OFileStream::writeString(): An I/O-Error occurred!");
-        }
+    if(fp == nullptr) {
+        THROW(OutputStream::error, "OFileStream::overflow(): The stream is not open!");
     }
-}
 
-void OFileStream::writeUint8(Uint8 x)
-{
-    if(fwrite(&x,sizeof(Uint8),1,fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint8(): An I/O-Error occurred!");
-    }
-}
-
-void OFileStream::writeUint16(Uint16 x)
-{
-    x = SDL_SwapLE16(x);
+    writeBuffer();
 
-    if(fwrite(&x,sizeof(Uint16),1,fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint16(): An I/O-Error occurred!");
+    if(length >= BUFFER_SIZE) {
+        // big blocks are written directly
+        if(fwrite(pData,length,1,fp) != 1) {
+            THROW(OutputStream::error, "OFileStream::overflow(): An I/O-Error occurred!");
+        }
+    } else {
+        memcpy(pWritePos, pData, length);
+        pWritePos += length;
     }
 }
 
-void OFileStream::writeUint32(Uint32 x)
+void OFileStream::writeBuffer()
 {
-    x = SDL_SwapLE32(x);
+    const size_t length = pWritePos - pBuffer.get();
 
-    if(fwrite(&x,sizeof(Uint32),1,fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint32(): An I/O-Error occurred!");
-    }
-}
+    pWritePos = pBuffer.get();
 
-void OFileStream::writeUint64(Uint64 x)
-{
-    x = SDL_SwapLE64(x);
-    if(fwrite(&x,sizeof(Uint64),1,fp) != 1) {
-        THROW(OutputStream::error, "OFileStream::writeUint64(): An I/O-Error occurred!");
+    if(length > 0) {
+        if(fwrite(pBuffer.get(),length,1,fp) != 1) {
+            THROW(OutputStream::error, "OFileStream::writeBuffer(): An I/O-Error occurred!");
+        }
     }
 }
-
-void OFileStream::writeBool(bool x)
-{
-    writeUint8(x == true ? 1 : 0);
-}
-
-void OFileStream::writeFloat(float x)
-{
-    Uint32 tmp;
-    memcpy(&tmp,&x,sizeof(Uint32)); // workaround for a strange optimization in gcc 4.1
-    writeUint32(tmp);
-}
@@ -16,8 +16,10 @@
  */
 
 #include <misc/Scaler.h>
+#include <misc/ScalerKernels.h>
 
 #include <algorithm>
+#include <vector>
 
 DoubleSurfaceFunction* Scaler::defaultDoubleSurface = Scaler::doubleSurfaceScale2x;
 DoubleTiledSurfaceFunction* Scaler::defaultDoubleTiledSurface = Scaler::doubleTiledSurfaceScale2x;
@@ -173,6 +175,133 @@ sdl2::surface_ptr Scaler::tripleTiledSurfaceNN(SDL_Surface* src, int tilesX, int
 
 
 
+namespace {
+
+    /// Sheets smaller than this are scaled on the calling thread; starting threads would cost more than they save
+    const int MIN_PIXELS_FOR_THREADING = 32768;
+
+    /// Each thread should get at least this many source rows
+    const int MIN_ROWS_PER_THREAD = 16;
+
+    struct ScaleBand {
+        SDL_Surface*    src;
+        SDL_Surface*    dest;
+        int             tilesX;
+        int             tilesY;
+        int             factor;         ///< 2 for scale2x, 3 for scale3x
+        int             firstRow;       ///< first source row of this band
+        int             endRow;         ///< one past the last source row of this band
+    };
+
+    /**
+        Scales the source rows [band.firstRow, band.endRow) of a tiled surface. Every tile is scaled on its own, i.e.
+        pixels outside the tile are never used as neighbours.
+        \param  band    the rows to scale
+    */
+    void scaleBand(const ScaleBand& band) {
+        const int tileWidth = band.src->w / band.tilesX;
+        const int tileHeight = band.src->h / band.tilesY;
+
+        const Uint8* srcPixels = static_cast<const Uint8*>(band.src->pixels);
+        Uint8* destPixels = static_cast<Uint8*>(band.dest->pixels);
+        const int srcPitch = band.src->pitch;
+        const int destPitch = band.dest->pitch;
+
+        ScalerKernels::Scale2xRowKernel* scale2xRow = ScalerKernels::getScale2xRowKernel();
+        ScalerKernels::Scale3xRowKernel* scale3xRow = ScalerKernels::getScale3xRowKernel();
+
+        for(int row = band.firstRow; row < band.endRow; ++row) {
+            const int tileY = row / tileHeight;
+            const int y = row % tileHeight;
+
+            const Uint8* prev = srcPixels + (tileY*tileHeight + std::max(0, y-1))*srcPitch;
+            const Uint8* cur = srcPixels + row*srcPitch;
+            const Uint8* next = srcPixels + (tileY*tileHeight + std::min(tileHeight-1, y+1))*srcPitch;
+
+            Uint8* dest0 = destPixels + (row*band.factor)*destPitch;
+            Uint8* dest1 = dest0 + destPitch;
+
+            for(int i = 0; i < band.tilesX; ++i) {
+                const int offset = i*tileWidth;
+                if(band.factor == 2) {
+                    scale2xRow(prev + offset, cur + offset, next + offset, tileWidth, dest0 + 2*offset, dest1 + 2*offset);
+                } else {
+                    Uint8* dest2 = dest1 + destPitch;
+                    scale3xRow(prev + offset, cur + offset, next + offset, tileWidth, dest0 + 3*offset, dest1 + 3*offset, dest2 + 3*offset);
+                }
+            }
+        }
+    }
+
+    int scaleBandThreadMain(void* data) {
+        scaleBand(*static_cast<ScaleBand*>(data));
+        return 0;
+    }
+
+    /**
+        Scales all tiles of src into dest. Big sheets are split into bands of rows which are scaled in parallel.
+        \param  src     the source image (must be locked)
+        \param  dest    the destination image (must be locked)
+        \param  tilesX  number of subimages in x direction
+        \param  tilesY  number of subimages in y direction
+        \param  factor  2 for scale2x, 3 for scale3x
+    */
+    void scaleTiled(SDL_Surface* src, SDL_Surface* dest, int tilesX, int tilesY, int factor) {
+        const int numRows = (src->h / tilesY) * tilesY;
+        if(numRows <= 0 || src->w / tilesX <= 0) {
+            return;
+        }
+
+        int numBands = 1;
+        if(src->w * src->h >= MIN_PIXELS_FOR_THREADING) {
+            numBands = std::max(1, std::min(SDL_GetCPUCount(), numRows / MIN_ROWS_PER_THREAD));
+        }
+
+        std::vector<ScaleBand> bands;
+        for(int b = 0; b < numBands; ++b) {
+            bands.push_back({ src, dest, tilesX, tilesY, factor, (numRows * b) / numBands, (numRows * (b+1)) / numBands });
+        }
+
+        std::vector<SDL_Thread*> threads;
+        for(int b = 1; b < numBands; ++b) {
+            SDL_Thread* pThread = SDL_CreateThread(scaleBandThreadMain, "Scaler", &bands[b]);
+            if(pThread == nullptr) {
+                // scale this band ourself
+                scaleBand(bands[b]);
+            } else {
+                threads.push_back(pThread);
+            }
+        }
+
+        scaleBand(bands[0]);
+
+        for(SDL_Thread* pThread : threads) {
+            SDL_WaitThread(pThread, nullptr);
+        }
+    }
+
+    sdl2::surface_ptr createScaledSurface(SDL_Surface* src, int factor) {
+        // create new picture surface
+        auto returnPic = sdl2::surface_ptr{ SDL_CreateRGBSurface(0, src->w*factor, src->h*factor, 8, 0, 0, 0, 0) };
+        if (returnPic == nullptr) {
+            return nullptr;
+        }
+
+        SDL_SetPaletteColors(returnPic->format->palette, src->format->palette->colors, 0, src->format->palette->ncolors);
+        Uint32 ckey;
+        bool has_ckey = !SDL_GetColorKey(src, &ckey);
+        if (has_ckey) {
+            SDL_SetColorKey(returnPic.get(), SDL_TRUE, ckey);
+        }
+        if (src->flags & SDL_RLEACCEL) {
+            SDL_SetSurfaceRLE(returnPic.get(), SDL_TRUE);
+        }
+
+        return returnPic;
+    }
+}
+
+
 /**
     This function doubles a surface while smoothing edges (see http://scale2x.sourceforge.net/algorithm.html ).
     \param  src             the source image
@@ -185,6 +314,7 @@ sdl2::surface_ptr Scaler::doubleSurfaceScale2x(SDL_Surface* src) {
 
 /**
     This function doubles a surface while smoothing edges (see http://scale2x.sourceforge.net/algorithm.html ).
+    The rows are scaled by the fastest kernel for this cpu (see ScalerKernels) and big sheets are scaled by multiple threads.
     \param  src             the source image
     \param  tilesX          number of subimages in x direction
     \param  tilesY          number of subimages in y direction
@@ -195,85 +325,15 @@ sdl2::surface_ptr Scaler::doubleTiledSurfaceScale2x(SDL_Surface* src, int tilesX
         return nullptr;
     }
 
-    int srcWidth = src->w;
-    int srcHeight = src->h;
-
-    // create new picture surface
-    auto returnPic = sdl2::surface_ptr{ SDL_CreateRGBSurface(0, srcWidth*2, srcHeight*2, 8, 0, 0, 0, 0) };
+    auto returnPic = createScaledSurface(src, 2);
     if (returnPic == nullptr) {
         return nullptr;
     }
 
-    SDL_SetPaletteColors(returnPic->format->palette, src->format->palette->colors, 0, src->format->palette->ncolors);
-    Uint32 ckey;
-    bool has_ckey = !SDL_GetColorKey(src, &ckey);
-    if (has_ckey) {
-        SDL_SetColorKey(returnPic.get(), SDL_TRUE, ckey);
-    }
-    if (src->flags & SDL_RLEACCEL) {
-        SDL_SetSurfaceRLE(returnPic.get(), SDL_TRUE);
-    }
-
-    Uint8* srcPixels = (Uint8*) src->pixels;
-    Uint8* destPixels = (Uint8*) returnPic->pixels;
-
-    int tileWidth = srcWidth / tilesX;
-    int tileHeight = srcHeight / tilesY;
-
     sdl2::surface_lock return_lock{ returnPic.get() };
     sdl2::surface_lock src_lock{ src };
 
-    for(int j=0;j<tilesY;++j) {
-        for(int i=0;i<tilesX;++i) {
-
-
-
-            /*
-
-            Scale center pixel E into 4 new pixels
-
-                Source            Dest
-            +---+---+---+
-            | A | B | C |       +--+--+
-            +---+---+---+       |E0|E1|
-            | D | E | F |   ->  +--+--+
-            +---+---+---+       |E2|E3|
-            | G | H | I |       +--+--+
-            +---+---+---+
-
-            */
-
-            for(int y = 0; y < tileHeight; ++y) {
-                for(int x = 0; x < tileWidth; ++x) {
-                    Uint8 E = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+x) );
-                    Uint8 B = *( srcPixels + (j*tileHeight+std::max(0,y-1))*src->pitch + (i*tileWidth+x) );
-                    Uint8 H = *( srcPixels + (j*tileHeight+std::min(tileHeight-1,y+1))*src->pitch + (i*tileWidth+x) );
-                    Uint8 D = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+std::max(0,x-1)) );
-                    Uint8 F = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+std::min(tileWidth-1,x+1)) );
-
-                    Uint8 E0, E1, E2, E3;
-
-                    if(B != H && D != F) {
-                        E0 = (D == B) ? D : E;
-                        E1 = (B == F) ? F : E;
-                        E2 = (D == H) ? D : E;
-                        E3 = (H == F) ? F : E;
-                    } else {
-                        E0 = E;
-                        E1 = E;
-                        E2 = E;
-                        E3 = E;
-                    }
-
-                    *(destPixels + (j*tileHeight+y)*2*returnPic->pitch + (i*tileWidth+x)*2) = E0;
-                    *(destPixels + (j*tileHeight+y)*2*returnPic->pitch + (i*tileWidth+x)*2 + 1) = E1;
-                    *(destPixels + ((j*tileHeight+y)*2+1)*returnPic->pitch + (i*tileWidth+x)*2) = E2;
-                    *(destPixels + ((j*tileHeight+y)*2+1)*returnPic->pitch + (i*tileWidth+x)*2 + 1) = E3;
-                }
-            }
-
-        }
-    }
+    scaleTiled(src, returnPic.get(), tilesX, tilesY, 2);
 
     return returnPic;
 }
@@ -291,6 +351,7 @@ sdl2::surface_ptr Scaler::tripleSurfaceScale3x(SDL_Surface* src) {
 
 /**
     This function triples a surface while smoothing edges (see http://scale2x.sourceforge.net/algorithm.html ).
+    The rows are scaled by the fastest kernel for this cpu (see ScalerKernels) and big sheets are scaled by multiple threads.
     \param  src             the source image
     \param  tilesX          number of subimages in x direction
     \param  tilesY          number of subimages in y direction
@@ -301,106 +362,15 @@ sdl2::surface_ptr Scaler::tripleTiledSurfaceScale3x(SDL_Surface* src, int tilesX
         return nullptr;
     }
 
-    int srcWidth = src->w;
-    int srcHeight = src->h;
-
-    // create new picture surface
-    auto returnPic = sdl2::surface_ptr{ SDL_CreateRGBSurface(0, srcWidth*3, srcHeight*3, 8, 0, 0, 0, 0) };
+    auto returnPic = createScaledSurface(src, 3);
     if (returnPic == nullptr) {
         return nullptr;
     }
 
-    SDL_SetPaletteColors(returnPic->format->palette, src->format->palette->colors, 0, src->format->palette->ncolors);
-    Uint32 ckey;
-    bool has_ckey = !SDL_GetColorKey(src, &ckey);
-    if (has_ckey) {
-        SDL_SetColorKey(returnPic.get(), SDL_TRUE, ckey);
-    }
-    if (src->flags & SDL_RLEACCEL) {
-        SDL_SetSurfaceRLE(returnPic.get(), SDL_TRUE);
-    }
-
-    Uint8* srcPixels = (Uint8*) src->pixels;
-    Uint8* destPixels = (Uint8*) returnPic->pixels;
-
-    int tileWidth = srcWidth / tilesX;
-    int tileHeight = srcHeight / tilesY;
-
     sdl2::surface_lock return_lock{ returnPic.get() };
     sdl2::surface_lock src_lock{ src };
 
-    for(int j=0;j<tilesY;++j) {
-        for(int i=0;i<tilesX;++i) {
-
-
-
-            /*
-
-            Scale center pixel E into 4 new pixels
-
-                Source             Dest
-            +---+---+---+       +--+--+--+
-            | A | B | C |       |E0|E1|E2|
-            +---+---+---+       +--+--+--+
-            | D | E | F |   ->  |E3|E4|E5|
-            +---+---+---+       +--+--+--+
-            | G | H | I |       |E6|E7|E8|
-            +---+---+---+       +--+--+--+
-
-            */
-
-            for(int y = 0; y < tileHeight; ++y) {
-                for(int x = 0; x < tileWidth; ++x) {
-                    Uint8 A = *( srcPixels + (j*tileHeight+std::max(0,y-1))*src->pitch + (i*tileWidth+std::max(0,x-1)) );
-                    Uint8 B = *( srcPixels + (j*tileHeight+std::max(0,y-1))*src->pitch + (i*tileWidth+x) );
-                    Uint8 C = *( srcPixels + (j*tileHeight+std::max(0,y-1))*src->pitch + (i*tileWidth+std::min(tileWidth-1,x+1)) );
-                    Uint8 D = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+std::max(0,x-1)) );
-                    Uint8 E = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+x) );
-                    Uint8 F = *( srcPixels + (j*tileHeight+y)*src->pitch + (i*tileWidth+std::min(tileWidth-1,x+1)) );
-                    Uint8 G = *( srcPixels + (j*tileHeight+std::min(tileHeight-1,y+1))*src->pitch + (i*tileWidth+std::max(0,x-1)) );
-                    Uint8 H = *( srcPixels + (j*tileHeight+std::min(tileHeight-1,y+1))*src->pitch + (i*tileWidth+x) );
-                    Uint8 I = *( srcPixels + (j*tileHeight+std::min(tileHeight-1,y+1))*src->pitch + (i*tileWidth+std::min(tileWidth-1,x+1)) );
-
-                    Uint8 E0, E1, E2, E3, E4, E5, E6, E7, E8;
-
-                    if(B != H && D != F) {
-                        E0 = (D == B) ? D : E;
-                        E1 = (((D == B) && (E != C)) || ((B == F) && (E != A))) ? B : E;
-                        E2 = (B == F) ? F : E;
-                        E3 = (((D == B && E != G)) || ((D == H) && (E != A))) ? D : E;
-                        E4 = E;
-                        E5 = (((B == F) && (E != I)) || ((H == F) && (E != C))) ? F : E;
-                        E6 = (D == H) ? D : E;
-                        E7 = (((D == H) && (E != I)) || ((H == F) && (E != G))) ? H : E;
-                        E8 = (H == F) ? F : E;
-                    } else {
-                        E0 = E;
-                        E1 = E;
-                        E2 = E;
-                        E3 = E;
-                        E4 = E;
-                        E5 = E;
-                        E6 = E;
-                        E7 = E;
-                        E8 = E;
-                    }
-
-                    *(destPixels + (j*tileHeight+y)*3*returnPic->pitch + (i*tileWidth+x)*3) = E0;
-                    *(destPixels + (j*tileHeight+y)*3*returnPic->pitch + (i*tileWidth+x)*3 + 1) = E1;
-                    *(destPixels + (j*tileHeight+y)*3*returnPic->pitch + (i*tileWidth+x)*3 + 2) = E2;
-                    *(destPixels + ((j*tileHeight+y)*3+1)*returnPic->pitch + (i*tileWidth+x)*3) = E3;
-                    *(destPixels + ((j*tileHeight+y)*3+1)*returnPic->pitch + (i*tileWidth+x)*3 + 1) = E4;
-                    *(destPixels + ((j*tileHeight+y)*3+1)*returnPic->pitch + (i*tileWidth+x)*3 + 2) = E5;
-                    *(destPixels + ((j*tileHeight+y)*3+2)*returnPic->pitch + (i*tileWidth+x)*3) = E6;
-                    *(destPixels + ((j*tileHeight+y)*3+2)*returnPic->pitch + (i*tileWidth+x)*3 + 1) = E7;
-                    *(destPixels + ((j*tileHeight+y)*3+2)*returnPic->pitch + (i*tileWidth+x)*3 + 2) = E8;
-                }
-            }
-
-        }
-    }
+    scaleTiled(src, returnPic.get(), tilesX, tilesY, 3);
 
     return returnPic;
 }
-
-
@@ -0,0 +1,419 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/ScalerKernels.h>
+
+#include <SDL2/SDL_cpuinfo.h>
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define SCALER_KERNELS_X86
+    #include <immintrin.h>
+
+    // gcc and clang need the target attribute to use AVX2 intrinsics without compiling everything for AVX2
+    #if defined(__GNUC__)
+        #define TARGET_SSE2 __attribute__((target("sse2")))
+        #define TARGET_AVX2 __attribute__((target("avx2")))
+    #else
+        #define TARGET_SSE2
+        #define TARGET_AVX2
+    #endif
+#endif
+
+namespace ScalerKernels {
+
+/*
+    Scale center pixel E into 4 new pixels
+
+        Source            Dest
+    +---+---+---+
+    | A | B | C |       +--+--+
+    +---+---+---+       |E0|E1|
+    | D | E | F |   ->  +--+--+
+    +---+---+---+       |E2|E3|
+    | G | H | I |       +--+--+
+    +---+---+---+
+*/
+static inline void scale2xPixel(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, int x, Uint8* dest0, Uint8* dest1) {
+    const Uint8 B = prev[x];
+    const Uint8 H = next[x];
+    const Uint8 D = cur[std::max(0, x-1)];
+    const Uint8 E = cur[x];
+    const Uint8 F = cur[std::min(width-1, x+1)];
+
+    if(B != H && D != F) {
+        dest0[2*x] = (D == B) ? D : E;
+        dest0[2*x+1] = (B == F) ? F : E;
+        dest1[2*x] = (D == H) ? D : E;
+        dest1[2*x+1] = (H == F) ? F : E;
+    } else {
+        dest0[2*x] = E;
+        dest0[2*x+1] = E;
+        dest1[2*x] = E;
+        dest1[2*x+1] = E;
+    }
+}
+
+/*
+    Scale center pixel E into 9 new pixels
+
+        Source             Dest
+    +---+---+---+       +--+--+--+
+    | A | B | C |       |E0|E1|E2|
+    +---+---+---+       +--+--+--+
+    | D | E | F |   ->  |E3|E4|E5|
+    +---+---+---+       +--+--+--+
+    | G | H | I |       |E6|E7|E8|
+    +---+---+---+       +--+--+--+
+*/
+static inline void scale3xPixel(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, int x, Uint8* dest0, Uint8* dest1, Uint8* dest2) {
+    const int left = std::max(0, x-1);
+    const int right = std::min(width-1, x+1);
+
+    const Uint8 A = prev[left];
+    const Uint8 B = prev[x];
+    const Uint8 C = prev[right];
+    const Uint8 D = cur[left];
+    const Uint8 E = cur[x];
+    const Uint8 F = cur[right];
+    const Uint8 G = next[left];
+    const Uint8 H = next[x];
+    const Uint8 I = next[right];
+
+    if(B != H && D != F) {
+        dest0[3*x] = (D == B) ? D : E;
+        dest0[3*x+1] = (((D == B) && (E != C)) || ((B == F) && (E != A))) ? B : E;
+        dest0[3*x+2] = (B == F) ? F : E;
+        dest1[3*x] = (((D == B && E != G)) || ((D == H) && (E != A))) ? D : E;
+        dest1[3*x+1] = E;
+        dest1[3*x+2] = (((B == F) && (E != I)) || ((H == F) && (E != C))) ? F : E;
+        dest2[3*x] = (D == H) ? D : E;
+        dest2[3*x+1] = (((D == H) && (E != I)) || ((H == F) && (E != G))) ? H : E;
+        dest2[3*x+2] = (H == F) ? F : E;
+    } else {
+        dest0[3*x] = dest0[3*x+1] = dest0[3*x+2] = E;
+        dest1[3*x] = dest1[3*x+1] = dest1[3*x+2] = E;
+        dest2[3*x] = dest2[3*x+1] = dest2[3*x+2] = E;
+    }
+}
+
+void scale2xRowScalar(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1) {
+    for(int x = 0; x < width; x++) {
+        scale2xPixel(prev, cur, next, width, x, dest0, dest1);
+    }
+}
+
+void scale3xRowScalar(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1, Uint8* dest2) {
+    for(int x = 0; x < width; x++) {
+        scale3xPixel(prev, cur, next, width, x, dest0, dest1, dest2);
+    }
+}
+
+#ifdef SCALER_KERNELS_X86
+
+/*
+    The vectorized kernels process a row in blocks of N = 16 (SSE2) or 32 (AVX2) pixels. Each source row of a block is
+    loaded three times: shifted by one pixel to the left (A, D, G), unshifted (B, E, H) and shifted by one pixel to the
+    right (C, F, I). At the first and the last block of a row the neighbours outside the row have to be clamped; these
+    blocks are loaded from a small buffer holding the clamped pixels. If the width is no multiple of N the last block
+    overlaps the previous one and the overlapping pixels are simply computed twice. Rows shorter than N are left to
+    the scalar code.
+    The conditions of the scalar code are evaluated for all pixels of a block at once; the comparisons yield 0xFF for
+    true and 0x00 for false and select() picks a for all 0xFF bytes of mask and b for all others.
+*/
+
+/**
+    Get the pixels x-1 to x+N of a row for loading a block starting at x.
+    \param  row     the source row
+    \param  x       the first pixel of the block
+    \param  width   the width of the row
+    \param  buffer  a buffer of at least N+2 pixels used for the first and the last block
+    \return the pixel x-1 of the row (or of the clamped copy in buffer)
+*/
+template<int N>
+static inline const Uint8* getBlock(const Uint8* row, int x, int width, Uint8* buffer) {
+    if(x > 0 && x + N < width) {
+        return row + x - 1;
+    }
+
+    for(int k = 0; k < N + 2; k++) {
+        buffer[k] = row[std::min(width-1, std::max(0, x-1+k))];
+    }
+    return buffer;
+}
+
+TARGET_SSE2 static inline __m128i load128(const Uint8* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+TARGET_SSE2 static inline void store128(Uint8* p, __m128i v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+TARGET_SSE2 static inline __m128i select(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+TARGET_SSE2 static void scale2xRowSSE2(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1) {
+    const int N = 16;
+
+    if(width < N) {
+        scale2xRowScalar(prev, cur, next, width, dest0, dest1);
+        return;
+    }
+
+    Uint8 buffer[N + 2];
+
+    for(int x = 0; x < width; x += N) {
+        x = std::min(x, width - N);
+
+        const Uint8* c = getBlock<N>(cur, x, width, buffer);
+
+        const __m128i B = load128(prev + x);
+        const __m128i H = load128(next + x);
+        const __m128i D = load128(c);
+        const __m128i E = load128(c + 1);
+        const __m128i F = load128(c + 2);
+
+        // (B != H) && (D != F)
+        const __m128i cond = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi8(B, H), _mm_cmpeq_epi8(D, F)), _mm_set1_epi8(-1));
+
+        const __m128i E0 = select(_mm_and_si128(cond, _mm_cmpeq_epi8(D, B)), D, E);
+        const __m128i E1 = select(_mm_and_si128(cond, _mm_cmpeq_epi8(B, F)), F, E);
+        const __m128i E2 = select(_mm_and_si128(cond, _mm_cmpeq_epi8(D, H)), D, E);
+        const __m128i E3 = select(_mm_and_si128(cond, _mm_cmpeq_epi8(H, F)), F, E);
+
+        store128(dest0 + 2*x, _mm_unpacklo_epi8(E0, E1));
+        store128(dest0 + 2*x + N, _mm_unpackhi_epi8(E0, E1));
+        store128(dest1 + 2*x, _mm_unpacklo_epi8(E2, E3));
+        store128(dest1 + 2*x + N, _mm_unpackhi_epi8(E2, E3));
+    }
+}
+
+TARGET_SSE2 static void scale3xRowSSE2(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1, Uint8* dest2) {
+    const int N = 16;
+
+    if(width < N) {
+        scale3xRowScalar(prev, cur, next, width, dest0, dest1, dest2);
+        return;
+    }
+
+    Uint8 buffer[3][N + 2];
+    alignas(16) Uint8 result[9][N];
+
+    for(int x = 0; x < width; x += N) {
+        x = std::min(x, width - N);
+
+        const Uint8* p = getBlock<N>(prev, x, width, buffer[0]);
+        const Uint8* c = getBlock<N>(cur, x, width, buffer[1]);
+        const Uint8* n = getBlock<N>(next, x, width, buffer[2]);
+
+        const __m128i A = load128(p);
+        const __m128i B = load128(p + 1);
+        const __m128i C = load128(p + 2);
+        const __m128i D = load128(c);
+        const __m128i E = load128(c + 1);
+        const __m128i F = load128(c + 2);
+        const __m128i G = load128(n);
+        const __m128i H = load128(n + 1);
+        const __m128i I = load128(n + 2);
+
+        const __m128i cond = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi8(B, H), _mm_cmpeq_epi8(D, F)), _mm_set1_epi8(-1));
+
+        const __m128i DB = _mm_and_si128(cond, _mm_cmpeq_epi8(D, B));
+        const __m128i BF = _mm_and_si128(cond, _mm_cmpeq_epi8(B, F));
+        const __m128i DH = _mm_and_si128(cond, _mm_cmpeq_epi8(D, H));
+        const __m128i HF = _mm_and_si128(cond, _mm_cmpeq_epi8(H, F));
+        const __m128i EA = _mm_cmpeq_epi8(E, A);
+        const __m128i EC = _mm_cmpeq_epi8(E, C);
+        const __m128i EG = _mm_cmpeq_epi8(E, G);
+        const __m128i EI = _mm_cmpeq_epi8(E, I);
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(result[0]), select(DB, D, E));
+        _mm_store_si128(reinterpret_cast<__m128i*>(result[1]), select(_mm_or_si128(_mm_andnot_si128(EC, DB), _mm_andnot_si128(EA, BF)), B, E));
+        _mm_store_si128(reinterpret_cast<__m128i*>(result[2]), select(BF, F, E));
+        _mm_store_si128(reinterpret_cast<__m128i*>(result[3]), select(_mm_or_si128(_mm_andnot_si128(EG, DB), _mm_andnot_si128(EA, DH)), D, E));
+        _mm_store_si128(reinterpret_cast<__m128i*>(result[4]), E);
+        _mm_store_si128(reinterpret_cast<__m128i*>(result[5]), select(_mm_or_si128(_mm_andnot_si128(EI, BF), _mm_andnot_si128(EC, HF)), F, E));
+        _mm_store_si128(reinterpret_cast<__m128i*>(result[6]), select(DH, D, E));
+        _mm_store_si128(reinterpret_cast<__m128i*>(result[7]), select(_mm_or_si128(_mm_andnot_si128(EI, DH), _mm_andnot_si128(EG, HF)), H, E));
+        _mm_store_si128(reinterpret_cast<__m128i*>(result[8]), select(HF, F, E));
+
+        // SSE2 has no byte shuffle, so interleave the three columns by hand
+        for(int k = 0; k < N; k++) {
+            const int destX = 3*(x+k);
+            dest0[destX] = result[0][k]; dest0[destX+1] = result[1][k]; dest0[destX+2] = result[2][k];
+            dest1[destX] = result[3][k]; dest1[destX+1] = result[4][k]; dest1[destX+2] = result[5][k];
+            dest2[destX] = result[6][k]; dest2[destX+1] = result[7][k]; dest2[destX+2] = result[8][k];
+        }
+    }
+}
+
+TARGET_AVX2 static inline __m256i load256(const Uint8* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+TARGET_AVX2 static inline void store256(Uint8* p, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+TARGET_AVX2 static inline __m256i select256(__m256i mask, __m256i a, __m256i b) {
+    return _mm256_blendv_epi8(b, a, mask);
+}
+
+TARGET_AVX2 static void scale2xRowAVX2(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1) {
+    const int N = 32;
+
+    if(width < N) {
+        // most unit tiles are 16 or 24 pixels wide
+        scale2xRowSSE2(prev, cur, next, width, dest0, dest1);
+        return;
+    }
+
+    Uint8 buffer[N + 2];
+
+    for(int x = 0; x < width; x += N) {
+        x = std::min(x, width - N);
+
+        const Uint8* c = getBlock<N>(cur, x, width, buffer);
+
+        const __m256i B = load256(prev + x);
+        const __m256i H = load256(next + x);
+        const __m256i D = load256(c);
+        const __m256i E = load256(c + 1);
+        const __m256i F = load256(c + 2);
+
+        const __m256i cond = _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpeq_epi8(B, H), _mm256_cmpeq_epi8(D, F)), _mm256_set1_epi8(-1));
+
+        const __m256i E0 = select256(_mm256_and_si256(cond, _mm256_cmpeq_epi8(D, B)), D, E);
+        const __m256i E1 = select256(_mm256_and_si256(cond, _mm256_cmpeq_epi8(B, F)), F, E);
+        const __m256i E2 = select256(_mm256_and_si256(cond, _mm256_cmpeq_epi8(D, H)), D, E);
+        const __m256i E3 = select256(_mm256_and_si256(cond, _mm256_cmpeq_epi8(H, F)), F, E);
+
+        // unpack works inside the 128 bit lanes; put the lanes back in order
+        const __m256i row0Lo = _mm256_unpacklo_epi8(E0, E1);
+        const __m256i row0Hi = _mm256_unpackhi_epi8(E0, E1);
+        const __m256i row1Lo = _mm256_unpacklo_epi8(E2, E3);
+        const __m256i row1Hi = _mm256_unpackhi_epi8(E2, E3);
+
+        store256(dest0 + 2*x, _mm256_permute2x128_si256(row0Lo, row0Hi, 0x20));
+        store256(dest0 + 2*x + N, _mm256_permute2x128_si256(row0Lo, row0Hi, 0x31));
+        store256(dest1 + 2*x, _mm256_permute2x128_si256(row1Lo, row1Hi, 0x20));
+        store256(dest1 + 2*x + N, _mm256_permute2x128_si256(row1Lo, row1Hi, 0x31));
+    }
+}
+
+TARGET_AVX2 static void scale3xRowAVX2(const Uint8* prev, const Uint8* cur, const Uint8* next, int width, Uint8* dest0, Uint8* dest1, Uint8* dest2) {
+    const int N = 32;
+
+    if(width < N) {
+        scale3xRowSSE2(prev, cur, next, width, dest0, dest1, dest2);
+        return;
+    }
+
+    Uint8 buffer[3][N + 2];
+    alignas(32) Uint8 result[9][N];
+
+    for(int x = 0; x < width; x += N) {
+        x = std::min(x, width - N);
+
+        const Uint8* p = getBlock<N>(prev, x, width, buffer[0]);
+        const Uint8* c = getBlock<N>(cur, x, width, buffer[1]);
+        const Uint8* n = getBlock<N>(next, x, width, buffer[2]);
+
+        const __m256i A = load256(p);
+        const __m256i B = load256(p + 1);
+        const __m256i C = load256(p + 2);
+        const __m256i D = load256(c);
+        const __m256i E = load256(c + 1);
+        const __m256i F = load256(c + 2);
+        const __m256i G = load256(n);
+        const __m256i H = load256(n + 1);
+        const __m256i I = load256(n + 2);
+
+        const __m256i cond = _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpeq_epi8(B, H), _mm256_cmpeq_epi8(D, F)), _mm256_set1_epi8(-1));
+
+        const __m256i DB = _mm256_and_si256(cond, _mm256_cmpeq_epi8(D, B));
+        const __m256i BF = _mm256_and_si256(cond, _mm256_cmpeq_epi8(B, F));
+        const __m256i DH = _mm256_and_si256(cond, _mm256_cmpeq_epi8(D, H));
+        const __m256i HF = _mm256_and_si256(cond, _mm256_cmpeq_epi8(H, F));
+        const __m256i EA = _mm256_cmpeq_epi8(E, A);
+        const __m256i EC = _mm256_cmpeq_epi8(E, C);
+        const __m256i EG = _mm256_cmpeq_epi8(E, G);
+        const __m256i EI = _mm256_cmpeq_epi8(E, I);
+
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result[0]), select256(DB, D, E));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result[1]), select256(_mm256_or_si256(_mm256_andnot_si256(EC, DB), _mm256_andnot_si256(EA, BF)), B, E));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result[2]), select256(BF, F, E));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result[3]), select256(_mm256_or_si256(_mm256_andnot_si256(EG, DB), _mm256_andnot_si256(EA, DH)), D, E));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result[4]), E);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result[5]), select256(_mm256_or_si256(_mm256_andnot_si256(EI, BF), _mm256_andnot_si256(EC, HF)), F, E));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result[6]), select256(DH, D, E));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result[7]), select256(_mm256_or_si256(_mm256_andnot_si256(EI, DH), _mm256_andnot_si256(EG, HF)), H, E));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(result[8]), select256(HF, F, E));
+
+        for(int k = 0; k < N; k++) {
+            const int destX = 3*(x+k);
+            dest0[destX] = result[0][k]; dest0[destX+1] = result[1][k]; dest0[destX+2] = result[2][k];
+            dest1[destX] = result[3][k]; dest1[destX+1] = result[4][k]; dest1[destX+2] = result[5][k];
+            dest2[destX] = result[6][k]; dest2[destX+1] = result[7][k]; dest2[destX+2] = result[8][k];
+        }
+    }
+}
+
+Scale2xRowKernel* getScale2xRowKernelSSE2() {
+    return SDL_HasSSE2() ? scale2xRowSSE2 : nullptr;
+}
+
+Scale3xRowKernel* getScale3xRowKernelSSE2() {
+    return SDL_HasSSE2() ? scale3xRowSSE2 : nullptr;
+}
+
+Scale2xRowKernel* getScale2xRowKernelAVX2() {
+    return SDL_HasAVX2() ? scale2xRowAVX2 : nullptr;
+}
+
+Scale3xRowKernel* getScale3xRowKernelAVX2() {
+    return SDL_HasAVX2() ? scale3xRowAVX2 : nullptr;
+}
+
+#else
+
+Scale2xRowKernel* getScale2xRowKernelSSE2() { return nullptr; }
+Scale3xRowKernel* getScale3xRowKernelSSE2() { return nullptr; }
+Scale2xRowKernel* getScale2xRowKernelAVX2() { return nullptr; }
+Scale3xRowKernel* getScale3xRowKernelAVX2() { return nullptr; }
+
+#endif
+
+Scale2xRowKernel* getScale2xRowKernel() {
+    static Scale2xRowKernel* const pKernel = getScale2xRowKernelAVX2() ? getScale2xRowKernelAVX2()
+                                            : getScale2xRowKernelSSE2() ? getScale2xRowKernelSSE2()
+                                            : scale2xRowScalar;
+    return pKernel;
+}
+
+Scale3xRowKernel* getScale3xRowKernel() {
+    static Scale3xRowKernel* const pKernel = getScale3xRowKernelAVX2() ? getScale3xRowKernelAVX2()
+                                            : getScale3xRowKernelSSE2() ? getScale3xRowKernelSSE2()
+                                            : scale3xRowScalar;
+    return pKernel;
+}
+
+}
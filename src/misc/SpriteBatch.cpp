@@ -0,0 +1,138 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/SpriteBatch.h>
+
+#include <globals.h>
+
+#include <cmath>
+
+static const double PI = 3.14159265358979323846;
+
+void SpriteBatch::copyEx(SDL_Texture* pTexture, const SDL_Rect* srcrect, const SDL_Rect* dstrect, double angle) {
+    numSprites++;
+
+    const TextureAtlas::Region* pRegion = (pAtlas != nullptr && dstrect != nullptr) ? pAtlas->find(pTexture) : nullptr;
+
+    // the atlas pages are drawn with alpha blending; for opaque pictures this is the same as no blending
+    SDL_BlendMode blendMode;
+    if(pRegion == nullptr || SDL_GetTextureBlendMode(pTexture, &blendMode) != 0
+        || !(blendMode == SDL_BLENDMODE_BLEND || (blendMode == SDL_BLENDMODE_NONE && pRegion->bOpaque))) {
+        drawDirect(pTexture, srcrect, dstrect, angle);
+        return;
+    }
+
+    SDL_Rect source = (srcrect != nullptr) ? *srcrect : SDL_Rect{ 0, 0, pRegion->rect.w, pRegion->rect.h };
+    source.x += pRegion->rect.x;
+    source.y += pRegion->rect.y;
+
+    // color and alpha modulation of the original texture are applied with the vertex color
+    SDL_Color color;
+    SDL_GetTextureColorMod(pTexture, &color.r, &color.g, &color.b);
+    SDL_GetTextureAlphaMod(pTexture, &color.a);
+
+    addQuad(*pRegion, source, dstrect, angle, color);
+}
+
+void SpriteBatch::copyRegion(const TextureAtlas::Region& region, const SDL_Rect& dstrect) {
+    numSprites++;
+
+    addQuad(region, region.rect, &dstrect, 0.0, SDL_Color{ 255, 255, 255, 255 });
+}
+
+void SpriteBatch::addQuad(const TextureAtlas::Region& region, const SDL_Rect& source, const SDL_Rect* dstrect, double angle, SDL_Color color) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if(region.pPage != pCurrentPage) {
+        flush();
+        pCurrentPage = region.pPage;
+    }
+
+    const float u1 = source.x * region.invPageW;
+    const float v1 = source.y * region.invPageH;
+    const float u2 = (source.x + source.w) * region.invPageW;
+    const float v2 = (source.y + source.h) * region.invPageH;
+
+    const float halfW = 0.5f * dstrect->w;
+    const float halfH = 0.5f * dstrect->h;
+    const float centerX = dstrect->x + halfW;
+    const float centerY = dstrect->y + halfH;
+
+    float cosAngle = 1.0f;
+    float sinAngle = 0.0f;
+    if(angle != 0.0) {
+        const double rad = angle * PI / 180.0;
+        cosAngle = static_cast<float>(std::cos(rad));
+        sinAngle = static_cast<float>(std::sin(rad));
+    }
+
+    const float corners[4][4] = {
+        { -halfW, -halfH, u1, v1 },
+        {  halfW, -halfH, u2, v1 },
+        {  halfW,  halfH, u2, v2 },
+        { -halfW,  halfH, u1, v2 },
+    };
+
+    const int firstIndex = static_cast<int>(vertices.size());
+    for(const auto& corner : corners) {
+        SDL_Vertex vertex;
+        vertex.position.x = centerX + corner[0]*cosAngle - corner[1]*sinAngle;
+        vertex.position.y = centerY + corner[0]*sinAngle + corner[1]*cosAngle;
+        vertex.color = color;
+        vertex.tex_coord.x = corner[2];
+        vertex.tex_coord.y = corner[3];
+        vertices.push_back(vertex);
+    }
+
+    for(int i : { 0, 1, 2, 0, 2, 3 }) {
+        indices.push_back(firstIndex + i);
+    }
+#else
+    // draw directly from the atlas page; at least the renderer does not switch textures any more
+    SDL_SetTextureColorMod(region.pPage, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(region.pPage, color.a);
+    if(angle == 0.0) {
+        SDL_RenderCopy(renderer, region.pPage, &source, dstrect);
+    } else {
+        SDL_RenderCopyEx(renderer, region.pPage, &source, dstrect, angle, nullptr, SDL_FLIP_NONE);
+    }
+    numDrawCalls++;
+#endif
+}
+
+void SpriteBatch::flush() {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if(!indices.empty()) {
+        SDL_RenderGeometry(renderer, pCurrentPage, vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+        numDrawCalls++;
+        vertices.clear();
+        indices.clear();
+    }
+#endif
+    pCurrentPage = nullptr;
+}
+
+void SpriteBatch::drawDirect(SDL_Texture* pTexture, const SDL_Rect* srcrect, const SDL_Rect* dstrect, double angle) {
+    flush();
+
+    if(angle == 0.0) {
+        SDL_RenderCopy(renderer, pTexture, srcrect, dstrect);
+    } else {
+        SDL_RenderCopyEx(renderer, pTexture, srcrect, dstrect, angle, nullptr, SDL_FLIP_NONE);
+    }
+    numDrawCalls++;
+}
@@ -0,0 +1,131 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <misc/TextureAtlas.h>
+
+#include <globals.h>
+
+#include <algorithm>
+
+TextureAtlas::TextureAtlas(int pageSize) : pageSize(pageSize) {
+    SDL_RendererInfo info;
+    if(renderer != nullptr && SDL_GetRendererInfo(renderer, &info) == 0) {
+        if(info.max_texture_width > 0) {
+            this->pageSize = std::min(this->pageSize, info.max_texture_width);
+        }
+        if(info.max_texture_height > 0) {
+            this->pageSize = std::min(this->pageSize, info.max_texture_height);
+        }
+    }
+}
+
+TextureAtlas::~TextureAtlas() = default;
+
+bool TextureAtlas::add(SDL_Texture* pTexture, SDL_Surface* pSurface) {
+    if(pTexture == nullptr || pSurface == nullptr) {
+        return false;
+    }
+
+    // one pixel transparent border on each side
+    const int paddedW = pSurface->w + 2;
+    const int paddedH = pSurface->h + 2;
+
+    int pageIndex, x, y;
+    if(!allocate(paddedW, paddedH, pageIndex, x, y)) {
+        return false;
+    }
+
+    // converting to a format with alpha turns the color key into transparent pixels
+    sdl2::surface_ptr pConverted{ SDL_ConvertSurfaceFormat(pSurface, SDL_PIXELFORMAT_ARGB8888, 0) };
+    sdl2::surface_ptr pPadded{ SDL_CreateRGBSurface(0, paddedW, paddedH, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000) };
+    if(pConverted == nullptr || pPadded == nullptr) {
+        SDL_Log("TextureAtlas::add(): Cannot convert picture: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_FillRect(pPadded.get(), nullptr, 0);
+    SDL_SetSurfaceBlendMode(pConverted.get(), SDL_BLENDMODE_NONE);
+    SDL_Rect dest = { 1, 1, pSurface->w, pSurface->h };
+    SDL_BlitSurface(pConverted.get(), nullptr, pPadded.get(), &dest);
+
+    Page& page = pages[pageIndex];
+    SDL_Rect pageRect = { x, y, paddedW, paddedH };
+    sdl2::surface_lock lock{ pPadded.get() };
+    if(SDL_UpdateTexture(page.pTexture.get(), &pageRect, pPadded->pixels, pPadded->pitch) != 0) {
+        SDL_Log("TextureAtlas::add(): Cannot upload picture: %s", SDL_GetError());
+        return false;
+    }
+
+    Uint32 colorKey;
+    const bool bOpaque = (SDL_GetColorKey(pSurface, &colorKey) != 0) && (pSurface->format->Amask == 0);
+
+    const float invPageSize = 1.0f / pageSize;
+    regions[pTexture] = Region{ page.pTexture.get(), SDL_Rect{ x + 1, y + 1, pSurface->w, pSurface->h }, invPageSize, invPageSize, bOpaque };
+
+    return true;
+}
+
+bool TextureAtlas::allocate(int w, int h, int& pageIndex, int& x, int& y) {
+    if(w > pageSize || h > pageSize) {
+        return false;
+    }
+
+    for(pageIndex = 0; pageIndex < static_cast<int>(pages.size()); pageIndex++) {
+        if(allocateInPage(pages[pageIndex], w, h, x, y)) {
+            return true;
+        }
+    }
+
+    Page newPage;
+    newPage.pTexture = sdl2::texture_ptr{ SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, pageSize, pageSize) };
+    if(newPage.pTexture == nullptr) {
+        SDL_Log("TextureAtlas::allocate(): Cannot create page: %s", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(newPage.pTexture.get(), SDL_BLENDMODE_BLEND);
+
+    pages.push_back(std::move(newPage));
+    pageIndex = static_cast<int>(pages.size()) - 1;
+    return allocateInPage(pages.back(), w, h, x, y);
+}
+
+bool TextureAtlas::allocateInPage(Page& page, int w, int h, int& x, int& y) {
+    // use the lowest shelf that fits to waste as little space as possible
+    Shelf* pBestShelf = nullptr;
+    for(Shelf& shelf : page.shelves) {
+        if(shelf.height >= h && shelf.usedWidth + w <= pageSize) {
+            if(pBestShelf == nullptr || shelf.height < pBestShelf->height) {
+                pBestShelf = &shelf;
+            }
+        }
+    }
+
+    if(pBestShelf == nullptr) {
+        if(page.usedHeight + h > pageSize) {
+            return false;
+        }
+        page.shelves.push_back(Shelf{ page.usedHeight, h, 0 });
+        page.usedHeight += h;
+        pBestShelf = &page.shelves.back();
+    }
+
+    x = pBestShelf->usedWidth;
+    y = pBestShelf->y;
+    pBestShelf->usedWidth += w;
+    return true;
+}
@@ -649,6 +649,19 @@ void startReplay(const std::string& filename) {
 
         currentGame->runMainLoop();
 
+        // seeking backwards (or far ahead) restarts the replay at a keyframe
+        while(currentGame->isReplaySeekRequested()) {
+            const Uint32 seekCycle = currentGame->getReplaySeekCycle();
+
+            delete currentGame;
+            currentGame = nullptr;
+
+            currentGame = new Game();
+            currentGame->initReplay(filename, seekCycle);
+
+            currentGame->runMainLoop();
+        }
+
         delete currentGame;
         currentGame = nullptr;
 
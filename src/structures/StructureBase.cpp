@@ -69,13 +69,22 @@ void StructureBase::init() {
     animationCounter = 0;
 
     structureList.push_back(this);
+    currentGameMap->getSpatialIndex().addObject(this);
 }
 
 StructureBase::~StructureBase() {
     try {
         currentGameMap->removeObjectFromMap(getObjectID()); //no map point will reference now
+        for(int i = location.x; i < location.x + structureSize.x; i++) {
+            for(int j = location.y; j < location.y + structureSize.y; j++) {
+                if(currentGameMap->tileExists(i, j)) {
+                    currentGameMap->onTileChanged(Coord(i, j));
+                }
+            }
+        }
         currentGame->getObjectManager().removeObject(getObjectID());
         structureList.remove(this);
+        currentGameMap->getSpatialIndex().removeObject(this);
         owner->decrementStructures(itemID, location);
 
         removeFromSelectionLists();
@@ -129,7 +138,7 @@ void StructureBase::assignToMap(const Coord& pos) {
         }
     }
 
-    currentGameMap->viewMap(getOwner()->getHouseID(), pos, getViewRange());
+    currentGameMap->getFogOfWar().updateObserver(getObjectID(), getOwner()->getHouseID(), pos, getViewRange());
 
     if(!bFoundNonConcreteTile && !currentGame->getGameInitSettings().getGameOptions().structuresDegradeOnConcrete) {
         degradeTimer = -1;
@@ -147,7 +156,7 @@ void StructureBase::blitToScreen() {
                                             numImagesX, numImagesY);
     SDL_Rect source = calcSpriteSourceRect(graphic[currentZoomlevel],indexX,numImagesX,indexY,numImagesY);
 
-    SDL_RenderCopy(renderer, graphic[currentZoomlevel], &source, &dest);
+    currentGame->getSpriteBatch().copy(graphic[currentZoomlevel], &source, &dest);
 
     if(!fogged) {
         SDL_Texture* pSmokeTex = pGFXManager->getZoomedObjPic(ObjPic_Smoke, getOwner()->getHouseID(), currentZoomlevel);
@@ -165,7 +174,7 @@ void StructureBase::blitToScreen() {
             }
 
             smokeSource.x = smokeFrame * smokeSource.w;
-            SDL_RenderCopy(renderer, pSmokeTex, &smokeSource, &smokeDest);
+            currentGame->getSpriteBatch().copy(pSmokeTex, &smokeSource, &smokeDest);
         }
     }
 }
@@ -326,10 +335,6 @@ void StructureBase::setJustPlaced() {
 }
 
 bool StructureBase::update() {
-    if(((currentGame->getGameCycleCount() + getObjectID()) % 512) == 0) {
-        currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
-    }
-
     if(!fogged) {
         lastVisibleFrame = curAnimFrame;
     }
@@ -103,7 +103,7 @@ void AirUnit::blitToScreen()
             SDL_Rect source = calcSpriteSourceRect(shadowGraphic[currentZoomlevel], RIGHT, numImagesX, drawnFrame, numImagesY);
             SDL_Rect dest = calcSpriteDrawingRect(shadowGraphic[currentZoomlevel], x, y, numImagesX, numImagesY, HAlign::Center, VAlign::Center);
 
-            SDL_RenderCopyEx(renderer, shadowGraphic[currentZoomlevel], &source, &dest, rotationAngleDeg, nullptr, SDL_FLIP_NONE);
+            currentGame->getSpriteBatch().copyEx(shadowGraphic[currentZoomlevel], &source, &dest, rotationAngleDeg);
         }
 
         int x = screenborder->world2screenX(realX);
@@ -113,7 +113,7 @@ void AirUnit::blitToScreen()
         SDL_Rect source = calcSpriteSourceRect(pUnitGraphic, RIGHT, numImagesX, drawnFrame, numImagesY);
         SDL_Rect dest = calcSpriteDrawingRect( pUnitGraphic, x, y, numImagesX, numImagesY, HAlign::Center, VAlign::Center);
 
-        SDL_RenderCopyEx(renderer, pUnitGraphic, &source, &dest, rotationAngleDeg, nullptr, SDL_FLIP_NONE);
+        currentGame->getSpriteBatch().copyEx(pUnitGraphic, &source, &dest, rotationAngleDeg);
     } else {
         if(shadowGraphic[currentZoomlevel] != nullptr) {
             int x = screenborder->world2screenX(realX + 4);
@@ -122,7 +122,7 @@ void AirUnit::blitToScreen()
             SDL_Rect source = calcSpriteSourceRect(shadowGraphic[currentZoomlevel], drawnAngle, numImagesX, drawnFrame, numImagesY);
             SDL_Rect dest = calcSpriteDrawingRect(shadowGraphic[currentZoomlevel], x, y, numImagesX, numImagesY, HAlign::Center, VAlign::Center);
 
-            SDL_RenderCopy(renderer, shadowGraphic[currentZoomlevel], &source, &dest);
+            currentGame->getSpriteBatch().copy(shadowGraphic[currentZoomlevel], &source, &dest);
         }
 
         int x = screenborder->world2screenX(realX);
@@ -132,7 +132,7 @@ void AirUnit::blitToScreen()
         SDL_Rect source = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX, drawnFrame, numImagesY);
         SDL_Rect dest = calcSpriteDrawingRect( pUnitGraphic, x, y, numImagesX, numImagesY, HAlign::Center, VAlign::Center);
 
-        SDL_RenderCopy(renderer, pUnitGraphic, &source, &dest);
+        currentGame->getSpriteBatch().copy(pUnitGraphic, &source, &dest);
     }
 }
 
@@ -158,7 +158,7 @@ void AirUnit::move() {
     if(newLocation != location) {
         unassignFromMap(location);
         assignToMap(newLocation);
-        location = newLocation;
+        changeLocation(newLocation);
     }
 
     checkPos();
@@ -67,7 +67,7 @@ void Deviator::blitToScreen()
     SDL_Rect source1 = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
     SDL_Rect dest1 = calcSpriteDrawingRect( pUnitGraphic, x1, y1, numImagesX, 1, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pUnitGraphic, &source1, &dest1);
+    currentGame->getSpriteBatch().copy(pUnitGraphic, &source1, &dest1);
 
     const Coord deviatorTurretOffset[] =    {   Coord(0, -12),
                                                 Coord(0, -8),
@@ -86,7 +86,7 @@ void Deviator::blitToScreen()
                                             screenborder->world2screenY(realY + deviatorTurretOffset[drawnAngle].y),
                                             numImagesX, 1, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pTurretGraphic, &source2, &dest2);
+    currentGame->getSpriteBatch().copy(pTurretGraphic, &source2, &dest2);
 
     if(isBadlyDamaged()) {
         drawSmoke(x1, y1);
@@ -61,7 +61,7 @@ void GroundUnit::save(OutputStream& stream) const {
 void GroundUnit::assignToMap(const Coord& pos) {
     if (currentGameMap->tileExists(pos)) {
         currentGameMap->getTile(pos)->assignNonInfantryGroundObject(getObjectID());
-        currentGameMap->viewMap(owner->getHouseID(), pos, getViewRange());
+        currentGameMap->getFogOfWar().updateObserver(getObjectID(), owner->getHouseID(), pos, getViewRange());
     }
 }
 
@@ -222,14 +222,6 @@ const UnitBase* GroundUnit::getCarrier() const {
     return static_cast<UnitBase*>(currentGame->getObjectManager().getObject(bookedCarrier));
 }
 
-void GroundUnit::move() {
-    if(!moving && !justStoppedMoving && (((currentGame->getGameCycleCount() + getObjectID()) % 512) == 0)) {
-        currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
-    }
-
-    UnitBase::move();
-}
-
 void GroundUnit::navigate() {
     // Lets keep units moving even if they are awaiting a pickup
     // Could potentially make this distance based depending on how
@@ -106,7 +106,7 @@ void Harvester::blitToScreen()
     SDL_Rect source = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
     SDL_Rect dest = calcSpriteDrawingRect( pUnitGraphic, x, y, numImagesX, 1, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pUnitGraphic, &source, &dest);
+    currentGame->getSpriteBatch().copy(pUnitGraphic, &source, &dest);
 
     if(isHarvesting() == true) {
 
@@ -134,7 +134,7 @@ void Harvester::blitToScreen()
                                                     NUM_ANGLES, LASTSANDFRAME+1,
                                                     HAlign::Center, VAlign::Center);
 
-        SDL_RenderCopy(renderer, pSandGraphic, &sandSource, &sandDest);
+        currentGame->getSpriteBatch().copy(pSandGraphic, &sandSource, &sandDest);
     }
 
     if(isBadlyDamaged()) {
@@ -104,7 +104,7 @@ void InfantryBase::assignToMap(const Coord& pos) {
     if(currentGameMap->tileExists(pos)) {
         oldTilePosition = tilePosition;
         tilePosition = currentGameMap->getTile(pos)->assignInfantry(getObjectID());
-        currentGameMap->viewMap(owner->getHouseID(), pos, getViewRange());
+        currentGameMap->getFogOfWar().updateObserver(getObjectID(), owner->getHouseID(), pos, getViewRange());
     }
 }
 
@@ -129,23 +129,24 @@ void InfantryBase::blitToScreen() {
 
     SDL_Rect source = calcSpriteSourceRect(graphic[currentZoomlevel], temp, numImagesX, (walkFrame/10 == 3) ? 1 : walkFrame/10, numImagesY);
 
-    SDL_RenderCopy(renderer, graphic[currentZoomlevel], &source, &dest);
+    currentGame->getSpriteBatch().copy(graphic[currentZoomlevel], &source, &dest);
 }
 
 bool InfantryBase::canPass(int xPos, int yPos) const {
     bool passable = false;
     if(currentGameMap->tileExists(xPos, yPos)) {
-        Tile* pTile = currentGameMap->getTile(xPos, yPos);
-        if(!pTile->hasAGroundObject()) {
-            if(pTile->getType() != Terrain_Mountain) {
+        const TileAttributes& tileAttributes = currentGameMap->getTileAttributes();
+        if(!tileAttributes.hasAGroundObject(xPos, yPos)) {
+            if(!tileAttributes.isMountain(xPos, yPos)) {
                 passable = true;
             } else {
                 /* if this unit is infantry so can climb, and tile can take more infantry */
-                if(pTile->infantryNotFull()) {
+                if(tileAttributes.infantryNotFull(xPos, yPos)) {
                     passable = true;
                 }
             }
         } else {
+            Tile* pTile = currentGameMap->getTile(xPos, yPos);
             ObjectBase *object = pTile->getGroundObject();
 
             if((object != nullptr) && (object->getObjectID() == target.getObjectID())
@@ -154,8 +155,8 @@ bool InfantryBase::canPass(int xPos, int yPos) const {
                 && object->isVisible(getOwner()->getTeamID())) {
                 passable = true;
             } else {
-                passable = (!pTile->hasANonInfantryGroundObject()
-                            && (pTile->infantryNotFull()
+                passable = (!tileAttributes.hasANonInfantryGroundObject(xPos, yPos)
+                            && (tileAttributes.infantryNotFull(xPos, yPos)
                             && (pTile->getInfantryTeam() == getOwner()->getTeamID())));
             }
         }
@@ -240,7 +241,7 @@ void InfantryBase::checkPos() {
                         for(int j = capturedStructureLocation.y; j < capturedStructureLocation.y + pCapturedStructure->getStructureSizeY(); j++) {
 
                             // make a copy of infantry list to avoid problems of modifying the list during iteration (!)
-                            const std::list<Uint32> infantryList = currentGameMap->getTile(i,j)->getInfantryList();
+                            const Tile::InfantryList infantryList = currentGameMap->getTile(i,j)->getInfantryList();
                             for(const Uint32& infantryID : infantryList) {
                                 if(infantryID != getObjectID()) {
                                     ObjectBase* pObject = currentGame->getObjectManager().getObject(infantryID);
@@ -359,10 +360,6 @@ void InfantryBase::destroy() {
 }
 
 void InfantryBase::move() {
-    if(!moving && !justStoppedMoving && (((currentGame->getGameCycleCount() + getObjectID()) % 512) == 0)) {
-        currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
-    }
-
     if(moving && !justStoppedMoving) {
         realX += xSpeed;
         realY += ySpeed;
@@ -390,9 +387,9 @@ void InfantryBase::move() {
                 // let something else go in
                 unassignFromMap(location);
                 oldLocation = location;
-                location = nextSpot;
+                changeLocation(nextSpot);
 
-                currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
+                currentGameMap->getFogOfWar().updateObserver(getObjectID(), owner->getHouseID(), location, getViewRange());
             }
 
         } else {
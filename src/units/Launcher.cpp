@@ -62,7 +62,7 @@ void Launcher::blitToScreen() {
     SDL_Rect source1 = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
     SDL_Rect dest1 = calcSpriteDrawingRect( pUnitGraphic, x1, y1, numImagesX, 1, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pUnitGraphic, &source1, &dest1);
+    currentGame->getSpriteBatch().copy(pUnitGraphic, &source1, &dest1);
 
     const Coord launcherTurretOffset[] =    {   Coord(0, -12),
                                                 Coord(0, -8),
@@ -81,7 +81,7 @@ void Launcher::blitToScreen() {
                                             screenborder->world2screenY(realY + launcherTurretOffset[drawnAngle].y),
                                             numImagesX, 1, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pTurretGraphic, &source2, &dest2);
+    currentGame->getSpriteBatch().copy(pTurretGraphic, &source2, &dest2);
 
     if(isBadlyDamaged()) {
         drawSmoke(x1, y1);
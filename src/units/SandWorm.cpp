@@ -135,6 +135,9 @@ void Sandworm::blitToScreen() {
         SDL_Texture* shimmerTex = pGFXManager->getZoomedObjPic(ObjPic_SandwormShimmerTemp, currentZoomlevel);
         SDL_Texture* shimmerMaskTex = pGFXManager->getZoomedObjPic(ObjPic_SandwormShimmerMask, currentZoomlevel);
 
+        // the shimmer is taken from the screen; draw everything batched so far
+        currentGame->getSpriteBatch().flush();
+
         for(int i = 0; i < SANDWORM_SEGMENTS; i++) {
             if(lastLocs[i].isInvalid()) {
                 continue;
@@ -177,7 +180,7 @@ void Sandworm::blitToScreen() {
                                                 numImagesX, numImagesY,
                                                 HAlign::Center, VAlign::Center);
         SDL_Rect source = calcSpriteSourceRect(graphic[currentZoomlevel], 0, numImagesX, drawnFrame, numImagesY);
-        SDL_RenderCopy(renderer, graphic[currentZoomlevel], &source, &dest);
+        currentGame->getSpriteBatch().copy(graphic[currentZoomlevel], &source, &dest);
     }
 }
 
@@ -395,8 +398,8 @@ bool Sandworm::canAttack(const ObjectBase* object) const {
 
 bool Sandworm::canPass(int xPos, int yPos) const {
     return (currentGameMap->tileExists(xPos, yPos)
-            && !currentGameMap->getTile(xPos, yPos)->isRock()
-            && (!currentGameMap->getTile(xPos, yPos)->hasAnUndergroundUnit()
+            && currentGameMap->getTileAttributes().isPassable(xPos, yPos, TileAttributes::Movement_Sandworm)
+            && (!currentGameMap->getTileAttributes().hasAnUndergroundUnit(xPos, yPos)
                 || (currentGameMap->getTile(xPos, yPos)->getUndergroundUnit() == this)));
 }
 
@@ -63,7 +63,7 @@ void SiegeTank::blitToScreen() {
     SDL_Rect source1 = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
     SDL_Rect dest1 = calcSpriteDrawingRect( pUnitGraphic, x1, y1, numImagesX, 1, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pUnitGraphic, &source1, &dest1);
+    currentGame->getSpriteBatch().copy(pUnitGraphic, &source1, &dest1);
 
     const Coord siegeTankTurretOffset[] =   {   Coord(8, -12),
                                                 Coord(0, -20),
@@ -82,7 +82,7 @@ void SiegeTank::blitToScreen() {
                                             screenborder->world2screenY(realY + siegeTankTurretOffset[drawnTurretAngle].y),
                                             NUM_ANGLES, 1, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pTurretGraphic, &source2, &dest2);
+    currentGame->getSpriteBatch().copy(pTurretGraphic, &source2, &dest2);
 
     if(isBadlyDamaged()) {
         drawSmoke(x1, y1);
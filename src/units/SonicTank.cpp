@@ -64,7 +64,7 @@ void SonicTank::blitToScreen() {
     SDL_Rect source1 = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX);
     SDL_Rect dest1 = calcSpriteDrawingRect( pUnitGraphic, x1, y1, numImagesX, 1, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pUnitGraphic, &source1, &dest1);
+    currentGame->getSpriteBatch().copy(pUnitGraphic, &source1, &dest1);
 
     const Coord sonicTankTurretOffset[] =   {   Coord(0, -8),
                                                 Coord(0, -8),
@@ -83,7 +83,7 @@ void SonicTank::blitToScreen() {
                                             screenborder->world2screenY(realY + sonicTankTurretOffset[drawnAngle].y),
                                             numImagesX, 1, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pTurretGraphic, &source2, &dest2);
+    currentGame->getSpriteBatch().copy(pTurretGraphic, &source2, &dest2);
 
     if(isBadlyDamaged()) {
         drawSmoke(x1, y1);
@@ -64,14 +64,15 @@ bool TrackedUnit::canPass(int xPos, int yPos) const
         return false;
     }
 
-    Tile* pTile = currentGameMap->getTile(xPos, yPos);
+    // the terrain and the occupancy are checked without touching the tile
+    const TileAttributes& tileAttributes = currentGameMap->getTileAttributes();
 
-    if(pTile->isMountain()) {
+    if(tileAttributes.isMountain(xPos, yPos)) {
         return false;
     }
 
-    if(pTile->hasAGroundObject()) {
-        ObjectBase *pObject = pTile->getGroundObject();
+    if(tileAttributes.hasAGroundObject(xPos, yPos)) {
+        ObjectBase *pObject = currentGameMap->getTile(xPos, yPos)->getGroundObject();
 
         if( (pObject != nullptr)
             && (pObject->getObjectID() == target.getObjectID())
@@ -90,7 +91,7 @@ bool TrackedUnit::canPass(int xPos, int yPos) const
                 return false;
             }
         } else {
-            if (!pTile->hasANonInfantryGroundObject() && (pTile->getInfantryTeam() != getOwner()->getTeamID())) {
+            if (!tileAttributes.hasANonInfantryGroundObject(xPos, yPos) && (currentGameMap->getTile(xPos, yPos)->getInfantryTeam() != getOwner()->getTeamID())) {
                 // possibly squashing this unit
                 return true;
             } else {
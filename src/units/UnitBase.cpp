@@ -41,6 +41,8 @@
 
 #define SMOKEDELAY 30
 #define UNITIDLETIMER (GAMESPEED_DEFAULT *  315)  // about every 5s
+#define FLOWFIELD_PATH_LENGTH 8        // how many steps to follow the flow field before looking at it again
+#define HIERARCHICAL_PATH_MIN_DISTANCE (2*HierarchicalPathfinder::CLUSTER_SIZE)   // shorter moves are planned by AStarSearch alone
 
 UnitBase::UnitBase(House* newOwner) : ObjectBase(newOwner) {
 
@@ -129,10 +131,15 @@ void UnitBase::init() {
 
     drawnFrame = 0;
 
+    groupMoveDestination = Coord::Invalid();
+    groupMoveClass = TileAttributes::Movement_Tracked;
+
     unitList.push_back(this);
+    currentGameMap->getSpatialIndex().addObject(this);
 }
 
 UnitBase::~UnitBase() {
+    leaveGroupMove();
     pathList.clear();
     removeFromSelectionLists();
 
@@ -272,7 +279,7 @@ void UnitBase::blitToScreen() {
     SDL_Rect source = calcSpriteSourceRect(pUnitGraphic, drawnAngle, numImagesX, drawnFrame, numImagesY);
     SDL_Rect dest = calcSpriteDrawingRect( pUnitGraphic, x, y, numImagesX, numImagesY, HAlign::Center, VAlign::Center);
 
-    SDL_RenderCopy(renderer, pUnitGraphic, &source, &dest);
+    currentGame->getSpriteBatch().copy(pUnitGraphic, &source, &dest);
 
     if(isBadlyDamaged()) {
         drawSmoke(x, y);
@@ -339,6 +346,7 @@ void UnitBase::destroy() {
     currentGame->getHouse(originalHouseID)->decrementUnits(itemID);
 
     unitList.remove(this);
+    currentGameMap->getSpatialIndex().removeObject(this);
 
     if(isVisible()) {
         if(currentGame->randomGen.rand(1,100) <= getInfSpawnProp()) {
@@ -349,6 +357,7 @@ void UnitBase::destroy() {
             if(owner->getHouseID() != originalHouseID) {
                 // deviation is inherited
                 pNewUnit->owner = owner;
+                currentGameMap->getFogOfWar().changeObserverHouse(pNewUnit->getObjectID(), owner->getHouseID(), pNewUnit->getViewRange());
                 pNewUnit->graphic = pGFXManager->getObjPic(pNewUnit->graphicID,owner->getHouseID());
                 pNewUnit->deviationTimer = deviationTimer;
             }
@@ -370,6 +379,8 @@ void UnitBase::deviate(House* newOwner) {
         clearPath();
         doSetAttackMode(GUARD);
         owner = newOwner;
+        currentGameMap->getFogOfWar().changeObserverHouse(getObjectID(), owner->getHouseID(), getViewRange());
+        currentGameMap->getRadarChangeFeed().markChanged(location.x, location.y);
 
         graphic = pGFXManager->getObjPic(graphicID,getOwner()->getHouseID());
         deviationTimer = DEVIATIONTIME;
@@ -575,10 +586,10 @@ void UnitBase::move() {
                 // let something else go in
                 unassignFromMap(location);
                 oldLocation = location;
-                location = nextSpot;
+                changeLocation(nextSpot);
 
                 if(isAFlyingUnit() == false && itemID != Unit_Sandworm) {
-                    currentGameMap->viewMap(owner->getHouseID(), location, getViewRange());
+                    currentGameMap->getFogOfWar().updateObserver(getObjectID(), owner->getHouseID(), location, getViewRange());
                 }
             }
 
@@ -1323,6 +1334,8 @@ void UnitBase::quitDeviation() {
         setGuardPoint(location);
         setDestination(location);
         owner = currentGame->getHouse(originalHouseID);
+        currentGameMap->getFogOfWar().changeObserverHouse(getObjectID(), owner->getHouseID(), getViewRange());
+        currentGameMap->getRadarChangeFeed().markChanged(location.x, location.y);
         graphic = pGFXManager->getObjPic(graphicID,getOwner()->getHouseID());
         deviationTimer = INVALID;
     }
@@ -1395,14 +1408,15 @@ bool UnitBase::canPass(int xPos, int yPos) const {
         return false;
     }
 
-    Tile* pTile = currentGameMap->getTile(xPos, yPos);
+    // the terrain and the occupancy are checked without touching the tile
+    const TileAttributes& tileAttributes = currentGameMap->getTileAttributes();
 
-    if(pTile->isMountain()) {
+    if(tileAttributes.isMountain(xPos, yPos)) {
         return false;
     }
 
-    if(pTile->hasAGroundObject()) {
-        ObjectBase *pObject = pTile->getGroundObject();
+    if(tileAttributes.hasAGroundObject(xPos, yPos)) {
+        ObjectBase *pObject = currentGameMap->getTile(xPos, yPos)->getGroundObject();
 
         if( (pObject != nullptr)
             && (pObject->getObjectID() == target.getObjectID())
@@ -1436,7 +1450,26 @@ bool UnitBase::SearchPathWithAStar() {
         destinationCoord = destination;
     }
 
-    AStarSearch pathfinder(currentGameMap, this, location, destinationCoord);
+    if(followFlowField()) {
+        return true;
+    }
+
+    // far moves of ground vehicles are planned on the abstract graph first and then only refined up to the next waypoint
+    Coord searchDestination = destinationCoord;
+    if(isAGroundUnit() && !isInfantry() && (itemID != Unit_Sandworm) && (blockDistance(location, destinationCoord) > HIERARCHICAL_PATH_MIN_DISTANCE)) {
+        std::vector<Coord> waypoints;
+        if(currentGameMap->getHierarchicalPathfinder().findWaypoints(location, destinationCoord, waypoints)) {
+            searchDestination = waypoints.front();
+            for(const Coord& waypoint : waypoints) {
+                if(blockDistance(location, waypoint) > HierarchicalPathfinder::CLUSTER_SIZE) {
+                    break;
+                }
+                searchDestination = waypoint;
+            }
+        }
+    }
+
+    AStarSearch pathfinder(currentGameMap, this, location, searchDestination);
     pathList = pathfinder.getFoundPath();
 
     if(pathList.empty() == true) {
@@ -1447,6 +1480,57 @@ bool UnitBase::SearchPathWithAStar() {
     }
 }
 
+/**
+    Extends the path along the flow field that is shared by all units of a group move to the current destination.
+    \return true if the path was extended, false if the path shall be searched with AStarSearch
+*/
+bool UnitBase::followFlowField() {
+    if(target || groupMoveDestination.isInvalid() || (location == destination)) {
+        return false;
+    }
+
+    const FlowField* pFlowField = currentGameMap->getFlowField(groupMoveDestination, groupMoveClass);
+    if(pFlowField == nullptr) {
+        return false;
+    }
+
+    Coord spot = location;
+    for(int i = 0; i < FLOWFIELD_PATH_LENGTH; i++) {
+        spot = pFlowField->getNextSpot(spot);
+        if(spot.isInvalid() || !canPass(spot.x, spot.y)) {
+            // the destination is not reachable or another unit is in the way
+            break;
+        }
+        pathList.push_back(spot);
+    }
+
+    return !pathList.empty();
+}
+
+void UnitBase::joinGroupMove() {
+    const TileAttributes::MovementClass movementClass = getMovementClass();
+    if(!groupMoveDestination.isInvalid() || destination.isInvalid()
+        || ((movementClass != TileAttributes::Movement_Tracked) && (movementClass != TileAttributes::Movement_Wheeled) && (movementClass != TileAttributes::Movement_Infantry))) {
+        return;
+    }
+
+    groupMoveDestination = destination;
+    groupMoveClass = movementClass;
+    currentGameMap->joinGroupMove(groupMoveDestination, groupMoveClass);
+}
+
+/**
+    Removes this unit from the group move it joined with joinGroupMove().
+*/
+void UnitBase::leaveGroupMove() {
+    if(groupMoveDestination.isInvalid()) {
+        return;
+    }
+
+    currentGameMap->leaveGroupMove(groupMoveDestination, groupMoveClass);
+    groupMoveDestination = Coord::Invalid();
+}
+
 void UnitBase::drawSmoke(int x, int y) const {
     int frame = ((currentGame->getGameCycleCount() + (getObjectID() * 10)) / SMOKEDELAY) % (2*2);
     if(frame == 3) {
@@ -1457,7 +1541,7 @@ void UnitBase::drawSmoke(int x, int y) const {
     SDL_Rect dest = calcSpriteDrawingRect(pSmokeTex, x, y, 3, 1, HAlign::Center, VAlign::Bottom);
     SDL_Rect source = calcSpriteSourceRect(pSmokeTex, frame, 3);
 
-    SDL_RenderCopy(renderer, pSmokeTex, &source, &dest);
+    currentGame->getSpriteBatch().copy(pSmokeTex, &source, &dest);
 }
 
 void UnitBase::playAttackSound() {
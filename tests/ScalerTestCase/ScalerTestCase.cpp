@@ -0,0 +1,192 @@
+#include "ScalerTestCase.h"
+
+#include <misc/Scaler.h>
+#include <misc/ScalerKernels.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ScalerTestCase);
+
+// Two 4x4 tiles side by side; the expected images were computed by hand from the rules on
+// http://scale2x.sourceforge.net/algorithm.html with every tile scaled on its own
+static const std::vector<std::string> goldenSource = {
+	"11122333",
+	"12222433",
+	"11242443",
+	"55244111",
+};
+
+static const std::vector<std::string> goldenScale2x = {
+	"1111112222333333",
+	"1111122222333333",
+	"1122222222433333",
+	"1122222222444333",
+	"1112222422444333",
+	"1111224424444433",
+	"5555224444411111",
+	"5555224444111111",
+};
+
+static const std::vector<std::string> goldenScale3x = {
+	"111111111222222333333333",
+	"111111112222222333333333",
+	"111111122222222333333333",
+	"111222222222222433333333",
+	"111222222222222444333333",
+	"111222222222222444433333",
+	"111112222224222444443333",
+	"111112222244224444443333",
+	"111111222444244444444333",
+	"555555222444444441111111",
+	"555555222444444411111111",
+	"555555222444444111111111",
+};
+
+
+void ScalerTestCase::setUp() {
+}
+
+void ScalerTestCase::tearDown() {
+}
+
+sdl2::surface_ptr ScalerTestCase::createSurface(const std::vector<std::string>& rows) {
+	const int width = rows[0].length();
+	const int height = rows.size();
+
+	sdl2::surface_ptr surface{ SDL_CreateRGBSurface(0, width, height, 8, 0, 0, 0, 0) };
+	CPPUNIT_ASSERT(surface != nullptr);
+
+	sdl2::surface_lock lock{ surface.get() };
+	for(int y = 0; y < height; y++) {
+		Uint8* pixels = static_cast<Uint8*>(surface->pixels) + y*surface->pitch;
+		for(int x = 0; x < width; x++) {
+			pixels[x] = rows[y][x] - '0';
+		}
+	}
+
+	return surface;
+}
+
+void ScalerTestCase::assertSurfaceEquals(const std::vector<std::string>& expected, SDL_Surface* surface) {
+	CPPUNIT_ASSERT(surface != nullptr);
+	CPPUNIT_ASSERT_EQUAL((int) expected[0].length(), surface->w);
+	CPPUNIT_ASSERT_EQUAL((int) expected.size(), surface->h);
+
+	sdl2::surface_lock lock{ surface };
+	for(int y = 0; y < surface->h; y++) {
+		const Uint8* pixels = static_cast<const Uint8*>(surface->pixels) + y*surface->pitch;
+		std::string row;
+		for(int x = 0; x < surface->w; x++) {
+			row += static_cast<char>('0' + pixels[x]);
+		}
+		CPPUNIT_ASSERT_EQUAL(expected[y], row);
+	}
+}
+
+void ScalerTestCase::testScale2xGolden() {
+	auto src = createSurface(goldenSource);
+	auto scaled = Scaler::doubleTiledSurfaceScale2x(src.get(), 2, 1);
+	assertSurfaceEquals(goldenScale2x, scaled.get());
+}
+
+void ScalerTestCase::testScale3xGolden() {
+	auto src = createSurface(goldenSource);
+	auto scaled = Scaler::tripleTiledSurfaceScale3x(src.get(), 2, 1);
+	assertSurfaceEquals(goldenScale3x, scaled.get());
+}
+
+void ScalerTestCase::testKernelsMatchScalar() {
+	ScalerKernels::Scale2xRowKernel* scale2xKernels[] = { ScalerKernels::getScale2xRowKernelSSE2(), ScalerKernels::getScale2xRowKernelAVX2() };
+	ScalerKernels::Scale3xRowKernel* scale3xKernels[] = { ScalerKernels::getScale3xRowKernelSSE2(), ScalerKernels::getScale3xRowKernelAVX2() };
+
+	std::srand(42);
+
+	// cover all remainders of the 16 and 32 pixel blocks
+	for(int width = 1; width <= 100; width++) {
+		for(int run = 0; run < 10; run++) {
+			// few colors so that many neighbours are equal and all rules are hit
+			std::vector<Uint8> rows[3];
+			for(auto& row : rows) {
+				row.resize(width);
+				for(auto& pixel : row) {
+					pixel = std::rand() % 3;
+				}
+			}
+
+			std::vector<Uint8> expected[3];
+			std::vector<Uint8> result[3];
+			for(int i = 0; i < 3; i++) {
+				expected[i].resize(3*width);
+				result[i].resize(3*width);
+			}
+
+			ScalerKernels::scale2xRowScalar(rows[0].data(), rows[1].data(), rows[2].data(), width, expected[0].data(), expected[1].data());
+			for(auto kernel : scale2xKernels) {
+				if(kernel == nullptr) {
+					continue;
+				}
+				kernel(rows[0].data(), rows[1].data(), rows[2].data(), width, result[0].data(), result[1].data());
+				CPPUNIT_ASSERT(std::equal(expected[0].begin(), expected[0].begin() + 2*width, result[0].begin()));
+				CPPUNIT_ASSERT(std::equal(expected[1].begin(), expected[1].begin() + 2*width, result[1].begin()));
+			}
+
+			ScalerKernels::scale3xRowScalar(rows[0].data(), rows[1].data(), rows[2].data(), width, expected[0].data(), expected[1].data(), expected[2].data());
+			for(auto kernel : scale3xKernels) {
+				if(kernel == nullptr) {
+					continue;
+				}
+				kernel(rows[0].data(), rows[1].data(), rows[2].data(), width, result[0].data(), result[1].data(), result[2].data());
+				CPPUNIT_ASSERT(expected[0] == result[0]);
+				CPPUNIT_ASSERT(expected[1] == result[1]);
+				CPPUNIT_ASSERT(expected[2] == result[2]);
+			}
+		}
+	}
+}
+
+void ScalerTestCase::testThreadedSheet() {
+	// big enough to be split into bands; tile rows are not aligned with the bands
+	const int tilesX = 12;
+	const int tilesY = 10;
+	const int tileSize = 24;
+
+	std::srand(7);
+	std::vector<std::string> rows(tilesY*tileSize, std::string(tilesX*tileSize, '0'));
+	for(int y = 0; y < tilesY*tileSize; y += 2) {
+		for(int x = 0; x < tilesX*tileSize; x += 2) {
+			const char color = static_cast<char>('0' + std::rand() % 4);
+			rows[y][x] = rows[y][x+1] = color;
+			rows[y+1][x] = (std::rand() % 2) ? color : '0';
+			rows[y+1][x+1] = color;
+		}
+	}
+
+	auto src = createSurface(rows);
+	auto scaled = Scaler::doubleTiledSurfaceScale2x(src.get(), tilesX, tilesY);
+
+	// scale every tile on its own with the scalar kernel
+	std::vector<std::string> expected(2*tilesY*tileSize, std::string(2*tilesX*tileSize, '0'));
+	std::vector<Uint8> prev(tileSize), cur(tileSize), next(tileSize), dest0(2*tileSize), dest1(2*tileSize);
+	for(int j = 0; j < tilesY; j++) {
+		for(int i = 0; i < tilesX; i++) {
+			for(int y = 0; y < tileSize; y++) {
+				const int srcY = j*tileSize + y;
+				for(int x = 0; x < tileSize; x++) {
+					prev[x] = rows[j*tileSize + std::max(0, y-1)][i*tileSize + x] - '0';
+					cur[x] = rows[srcY][i*tileSize + x] - '0';
+					next[x] = rows[j*tileSize + std::min(tileSize-1, y+1)][i*tileSize + x] - '0';
+				}
+				ScalerKernels::scale2xRowScalar(prev.data(), cur.data(), next.data(), tileSize, dest0.data(), dest1.data());
+				for(int x = 0; x < 2*tileSize; x++) {
+					expected[2*srcY][2*i*tileSize + x] = static_cast<char>('0' + dest0[x]);
+					expected[2*srcY+1][2*i*tileSize + x] = static_cast<char>('0' + dest1[x]);
+				}
+			}
+		}
+	}
+
+	assertSurfaceEquals(expected, scaled.get());
+}
@@ -0,0 +1,31 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <misc/SDL2pp.h>
+
+#include <string>
+#include <vector>
+
+class ScalerTestCase: public CppUnit::TestFixture  {
+
+	CPPUNIT_TEST_SUITE(ScalerTestCase);
+
+	CPPUNIT_TEST(testScale2xGolden);
+	CPPUNIT_TEST(testScale3xGolden);
+	CPPUNIT_TEST(testKernelsMatchScalar);
+	CPPUNIT_TEST(testThreadedSheet);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testScale2xGolden();
+	void testScale3xGolden();
+	void testKernelsMatchScalar();
+	void testThreadedSheet();
+
+private:
+	static sdl2::surface_ptr createSurface(const std::vector<std::string>& rows);
+	static void assertSurfaceEquals(const std::vector<std::string>& expected, SDL_Surface* surface);
+};
@@ -0,0 +1,130 @@
+#include "SmallVectorTestCase.h"
+
+#include <misc/SmallVector.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <list>
+#include <utility>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SmallVectorTestCase);
+
+typedef SmallVector<unsigned int, 3> TestVector;
+
+static std::vector<unsigned int> toVector(const TestVector& v) {
+	return std::vector<unsigned int>(v.begin(), v.end());
+}
+
+void SmallVectorTestCase::setUp()
+{
+}
+
+void SmallVectorTestCase::tearDown()
+{
+}
+
+void SmallVectorTestCase::testInline()
+{
+	TestVector v;
+	CPPUNIT_ASSERT(v.empty());
+	CPPUNIT_ASSERT_EQUAL(0u, v.size());
+	CPPUNIT_ASSERT(v.begin() == v.end());
+
+	v.push_back(7);
+	v.push_back(8);
+	v.push_back(9);
+	CPPUNIT_ASSERT_EQUAL(3u, v.size());
+	CPPUNIT_ASSERT_EQUAL(7u, v.front());
+	CPPUNIT_ASSERT_EQUAL(9u, v.back());
+
+	// the elements are stored inside the object
+	const char* pObject = reinterpret_cast<const char*>(&v);
+	const char* pData = reinterpret_cast<const char*>(v.data());
+	CPPUNIT_ASSERT(pData >= pObject && pData < pObject + sizeof(v));
+
+	v.clear();
+	CPPUNIT_ASSERT(v.empty());
+}
+
+void SmallVectorTestCase::testSpillToHeap()
+{
+	// compare against std::list over a grow/shrink sequence that crosses the inline capacity several times
+	TestVector v;
+	std::list<unsigned int> reference;
+
+	for(unsigned int i = 0; i < 40; i++) {
+		v.push_back(i);
+		reference.push_back(i);
+		CPPUNIT_ASSERT(toVector(v) == std::vector<unsigned int>(reference.begin(), reference.end()));
+	}
+
+	for(unsigned int i = 0; i < 40; i += 2) {
+		v.remove(i);
+		reference.remove(i);
+		CPPUNIT_ASSERT(toVector(v) == std::vector<unsigned int>(reference.begin(), reference.end()));
+	}
+
+	for(unsigned int i = 1; i < 40; i += 2) {
+		v.remove(i);
+		reference.remove(i);
+		CPPUNIT_ASSERT(toVector(v) == std::vector<unsigned int>(reference.begin(), reference.end()));
+
+		v.push_back(100 + i);
+		reference.push_back(100 + i);
+		CPPUNIT_ASSERT(toVector(v) == std::vector<unsigned int>(reference.begin(), reference.end()));
+	}
+}
+
+void SmallVectorTestCase::testRemoveKeepsOrder()
+{
+	TestVector v;
+	for(unsigned int value : { 1, 2, 3, 2, 4 }) {
+		v.push_back(value);
+	}
+
+	// like std::list::remove() all equal elements are removed
+	v.remove(2);
+	CPPUNIT_ASSERT(toVector(v) == std::vector<unsigned int>({ 1, 3, 4 }));
+
+	// removing an element of the vector itself
+	v.remove(v.front());
+	CPPUNIT_ASSERT(toVector(v) == std::vector<unsigned int>({ 3, 4 }));
+
+	v.remove(42);
+	CPPUNIT_ASSERT(toVector(v) == std::vector<unsigned int>({ 3, 4 }));
+}
+
+void SmallVectorTestCase::testCopyAndMove()
+{
+	for(unsigned int size : { 2u, 3u, 10u }) {
+		TestVector v;
+		for(unsigned int i = 0; i < size; i++) {
+			v.push_back(i);
+		}
+
+		TestVector copy(v);
+		CPPUNIT_ASSERT(toVector(copy) == toVector(v));
+
+		// the copy is independent of the original
+		copy.push_back(99);
+		CPPUNIT_ASSERT_EQUAL(size, v.size());
+
+		TestVector assigned;
+		assigned.push_back(5);
+		assigned = v;
+		CPPUNIT_ASSERT(toVector(assigned) == toVector(v));
+
+		TestVector moved(std::move(assigned));
+		CPPUNIT_ASSERT(toVector(moved) == toVector(v));
+		CPPUNIT_ASSERT(assigned.empty());
+
+		TestVector moveAssigned;
+		for(unsigned int i = 0; i < 8; i++) {
+			moveAssigned.push_back(i);
+		}
+		moveAssigned = std::move(moved);
+		CPPUNIT_ASSERT(toVector(moveAssigned) == toVector(v));
+		CPPUNIT_ASSERT(moved.empty());
+	}
+}
@@ -0,0 +1,22 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+class SmallVectorTestCase: public CppUnit::TestFixture  {
+
+	CPPUNIT_TEST_SUITE(SmallVectorTestCase);
+
+	CPPUNIT_TEST(testInline);
+	CPPUNIT_TEST(testSpillToHeap);
+	CPPUNIT_TEST(testRemoveKeepsOrder);
+	CPPUNIT_TEST(testCopyAndMove);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testInline();
+	void testSpillToHeap();
+	void testRemoveKeepsOrder();
+	void testCopyAndMove();
+};
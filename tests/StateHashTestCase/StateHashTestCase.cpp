@@ -0,0 +1,63 @@
+#include "StateHashTestCase.h"
+
+#include <StateHash.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StateHashTestCase);
+
+void StateHashTestCase::setUp()
+{
+}
+
+void StateHashTestCase::tearDown()
+{
+}
+
+void StateHashTestCase::testOrderIndependent()
+{
+	StateHash a;
+	a.add(StateHash::Category_TileSpice, 1, 100);
+	a.add(StateHash::Category_TileSpice, 2, 200);
+	a.update(StateHash::Category_TileSpice, 1, 100, 50);
+
+	StateHash b;
+	b.add(StateHash::Category_TileSpice, 2, 200);
+	b.add(StateHash::Category_TileSpice, 1, 50);
+
+	CPPUNIT_ASSERT_EQUAL(a.getHash(), b.getHash());
+
+	b.update(StateHash::Category_TileSpice, 2, 200, 201);
+	CPPUNIT_ASSERT(a.getHash() != b.getHash());
+}
+
+void StateHashTestCase::testUpdateIsReversible()
+{
+	StateHash hash;
+	const Uint64 emptyHash = hash.getHash();
+
+	hash.add(StateHash::Category_ObjectHealth, 0, 256);
+	hash.update(StateHash::Category_ObjectHealth, 0, 256, 128);
+	CPPUNIT_ASSERT(hash.getHash() != emptyHash);
+
+	// destroying the object removes its last value
+	hash.update(StateHash::Category_ObjectHealth, 0, 128, 0);
+	CPPUNIT_ASSERT_EQUAL(emptyHash, hash.getHash());
+	CPPUNIT_ASSERT_EQUAL(static_cast<Uint64>(0), hash.getHash(StateHash::Category_ObjectHealth));
+
+	hash.add(StateHash::Category_HouseCredits, 3, 1000);
+	hash.reset();
+	CPPUNIT_ASSERT_EQUAL(emptyHash, hash.getHash());
+}
+
+void StateHashTestCase::testCategoriesAreSeparate()
+{
+	StateHash a;
+	a.add(StateHash::Category_TileSpice, 7, 42);
+
+	StateHash b;
+	b.add(StateHash::Category_HouseCredits, 7, 42);
+
+	CPPUNIT_ASSERT(a.getHash() != b.getHash());
+	CPPUNIT_ASSERT_EQUAL(static_cast<Uint64>(0), a.getHash(StateHash::Category_HouseCredits));
+}
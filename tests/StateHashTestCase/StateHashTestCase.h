@@ -0,0 +1,20 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+class StateHashTestCase: public CppUnit::TestFixture  {
+
+	CPPUNIT_TEST_SUITE(StateHashTestCase);
+
+	CPPUNIT_TEST(testOrderIndependent);
+	CPPUNIT_TEST(testUpdateIsReversible);
+	CPPUNIT_TEST(testCategoriesAreSeparate);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testOrderIndependent();
+	void testUpdateIsReversible();
+	void testCategoriesAreSeparate();
+};
@@ -0,0 +1,209 @@
+#include "StreamTestCase.h"
+
+#include <misc/IMemoryStream.h>
+#include <misc/OMemoryStream.h>
+#include <misc/IFileStream.h>
+#include <misc/OFileStream.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdio>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StreamTestCase);
+
+static const char* const TEST_FILENAME = "StreamTestCase.tmp";
+
+// more than the 64KB buffer of the file streams so that values straddle the buffer boundaries
+static const Uint32 NUM_VALUES = 50000;
+
+static std::vector<Uint32> makeValues() {
+	std::vector<Uint32> values;
+	for(Uint32 i = 0; i < NUM_VALUES; i++) {
+		values.push_back(i * 2654435761u);
+	}
+	return values;
+}
+
+static void writeTestData(OutputStream& stream) {
+	stream.writeUint8(0xAB);
+	stream.writeSint8(-5);
+	stream.writeUint16(0xBEEF);
+	stream.writeSint16(-1234);
+	stream.writeUint32(0xDEADBEEF);
+	stream.writeSint32(-123456789);
+	stream.writeUint64(0x0123456789ABCDEFull);
+	stream.writeSint64(-1234567890123ll);
+	stream.writeBool(true);
+	stream.writeBool(false);
+	stream.writeFloat(3.25f);
+	stream.writeFixPoint(FixPoint::FromRawValue(0x123456789ll));
+	stream.writeBools(true, false, true, true, false, false, false, true);
+	stream.writeString("");
+	stream.writeString("Dune Legacy");
+	stream.writeUint32List(std::list<Uint32>{ 1, 2, 3 });
+	stream.writeUint32Set(std::set<Uint32>{ 7, 5 });
+
+	// mix small values and big blocks
+	const std::vector<Uint32> values = makeValues();
+	for(Uint32 i = 0; i < 1000; i++) {
+		stream.writeUint8(static_cast<Uint8>(i));
+		stream.writeUint32(values[i]);
+	}
+	stream.writeUint32Vector(values);
+	stream.writeString(std::string(100000, 'x'));
+	stream.writeUint16(0x1234);
+
+	stream.flush();
+}
+
+static void checkTestData(InputStream& stream) {
+	CPPUNIT_ASSERT_EQUAL(static_cast<Uint8>(0xAB), stream.readUint8());
+	CPPUNIT_ASSERT_EQUAL(static_cast<Sint8>(-5), stream.readSint8());
+	CPPUNIT_ASSERT_EQUAL(static_cast<Uint16>(0xBEEF), stream.readUint16());
+	CPPUNIT_ASSERT_EQUAL(static_cast<Sint16>(-1234), stream.readSint16());
+	CPPUNIT_ASSERT_EQUAL(static_cast<Uint32>(0xDEADBEEF), stream.readUint32());
+	CPPUNIT_ASSERT_EQUAL(static_cast<Sint32>(-123456789), stream.readSint32());
+	CPPUNIT_ASSERT(stream.readUint64() == 0x0123456789ABCDEFull);
+	CPPUNIT_ASSERT(stream.readSint64() == -1234567890123ll);
+	CPPUNIT_ASSERT_EQUAL(true, stream.readBool());
+	CPPUNIT_ASSERT_EQUAL(false, stream.readBool());
+	CPPUNIT_ASSERT_EQUAL(3.25f, stream.readFloat());
+	CPPUNIT_ASSERT(stream.readFixPoint().getRawValue() == 0x123456789ll);
+
+	bool bools[8];
+	stream.readBools(&bools[0], &bools[1], &bools[2], &bools[3], &bools[4], &bools[5], &bools[6], &bools[7]);
+	CPPUNIT_ASSERT(bools[0] && !bools[1] && bools[2] && bools[3] && !bools[4] && !bools[5] && !bools[6] && bools[7]);
+
+	CPPUNIT_ASSERT(stream.readString() == "");
+	CPPUNIT_ASSERT(stream.readString() == "Dune Legacy");
+	CPPUNIT_ASSERT(stream.readUint32List() == (std::list<Uint32>{ 1, 2, 3 }));
+	CPPUNIT_ASSERT(stream.readUint32Set() == (std::set<Uint32>{ 5, 7 }));
+
+	const std::vector<Uint32> values = makeValues();
+	for(Uint32 i = 0; i < 1000; i++) {
+		CPPUNIT_ASSERT_EQUAL(static_cast<Uint8>(i), stream.readUint8());
+		CPPUNIT_ASSERT_EQUAL(values[i], stream.readUint32());
+	}
+	CPPUNIT_ASSERT(stream.readUint32Vector() == values);
+	CPPUNIT_ASSERT(stream.readString() == std::string(100000, 'x'));
+	CPPUNIT_ASSERT_EQUAL(static_cast<Uint16>(0x1234), stream.readUint16());
+}
+
+void StreamTestCase::setUp()
+{
+}
+
+void StreamTestCase::tearDown()
+{
+	std::remove(TEST_FILENAME);
+}
+
+void StreamTestCase::testMemoryRoundTrip()
+{
+	OMemoryStream ostream;
+	ostream.open();
+	writeTestData(ostream);
+
+	IMemoryStream istream(ostream.getData(), ostream.getDataLength());
+	checkTestData(istream);
+
+	// reopening reuses the buffer and starts from the beginning
+	ostream.open();
+	CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), ostream.getDataLength());
+	writeTestData(ostream);
+
+	IMemoryStream istream2(ostream.getData(), ostream.getDataLength());
+	checkTestData(istream2);
+}
+
+void StreamTestCase::testFileRoundTrip()
+{
+	{
+		OFileStream ostream;
+		CPPUNIT_ASSERT(ostream.open(TEST_FILENAME));
+		writeTestData(ostream);
+		ostream.close();
+	}
+
+	IFileStream istream;
+	CPPUNIT_ASSERT(istream.open(TEST_FILENAME));
+	checkTestData(istream);
+	CPPUNIT_ASSERT_THROW(istream.readUint8(), InputStream::eof);
+
+	// the file has the same content as the memory stream
+	OMemoryStream memStream;
+	memStream.open();
+	writeTestData(memStream);
+
+	IFileStream istream2;
+	CPPUNIT_ASSERT(istream2.open(TEST_FILENAME));
+	std::string fileContent(memStream.getDataLength(), '\0');
+	istream2.readBytes(&fileContent[0], fileContent.size());
+	CPPUNIT_ASSERT(fileContent == std::string(memStream.getData(), memStream.getDataLength()));
+}
+
+void StreamTestCase::testByteOrder()
+{
+	// savegames, replays and network packets are little endian on all platforms
+	OMemoryStream ostream;
+	ostream.open();
+	ostream.writeUint32(0x12345678);
+	ostream.writeUint16(0xABCD);
+
+	const unsigned char expected[] = { 0x78, 0x56, 0x34, 0x12, 0xCD, 0xAB };
+	CPPUNIT_ASSERT_EQUAL(sizeof(expected), ostream.getDataLength());
+	CPPUNIT_ASSERT(memcmp(ostream.getData(), expected, sizeof(expected)) == 0);
+}
+
+void StreamTestCase::testEndOfFile()
+{
+	const char data[] = { 1, 2, 3 };
+
+	IMemoryStream istream(data, sizeof(data));
+	CPPUNIT_ASSERT_THROW(istream.readUint32(), InputStream::eof);
+
+	IMemoryStream istream2(data, sizeof(data));
+	CPPUNIT_ASSERT_EQUAL(static_cast<Uint16>(0x0201), istream2.readUint16());
+	CPPUNIT_ASSERT_EQUAL(static_cast<Uint8>(3), istream2.readUint8());
+	CPPUNIT_ASSERT_THROW(istream2.readUint8(), InputStream::eof);
+
+	// a string that is longer than the rest of the stream
+	OMemoryStream ostream;
+	ostream.open();
+	ostream.writeUint32(100);
+	ostream.writeUint8(1);
+	IMemoryStream istream3(ostream.getData(), ostream.getDataLength());
+	CPPUNIT_ASSERT_THROW(istream3.readString(), InputStream::eof);
+}
+
+void StreamTestCase::testHugeLengthPrefix()
+{
+	// a corrupt length prefix must throw eof instead of allocating gigabytes first
+	const char data[] = { '\xFF', '\xFF', '\xFF', '\xFF', 1 };
+
+	IMemoryStream istream(data, sizeof(data));
+	CPPUNIT_ASSERT_THROW(istream.readString(), InputStream::eof);
+
+	IMemoryStream istream2(data, sizeof(data));
+	CPPUNIT_ASSERT_THROW(istream2.readUint32Vector(), InputStream::eof);
+
+	{
+		OFileStream ostream;
+		CPPUNIT_ASSERT(ostream.open(TEST_FILENAME));
+		ostream.writeBytes(data, sizeof(data));
+		ostream.close();
+	}
+
+	IFileStream fileStream;
+	CPPUNIT_ASSERT(fileStream.open(TEST_FILENAME));
+	CPPUNIT_ASSERT_THROW(fileStream.readString(), InputStream::eof);
+	fileStream.close();
+
+	CPPUNIT_ASSERT(fileStream.open(TEST_FILENAME));
+	CPPUNIT_ASSERT_THROW(fileStream.readUint32Vector(), InputStream::eof);
+	fileStream.close();
+}
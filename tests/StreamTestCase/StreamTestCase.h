@@ -0,0 +1,24 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+class StreamTestCase: public CppUnit::TestFixture  {
+
+	CPPUNIT_TEST_SUITE(StreamTestCase);
+
+	CPPUNIT_TEST(testMemoryRoundTrip);
+	CPPUNIT_TEST(testFileRoundTrip);
+	CPPUNIT_TEST(testByteOrder);
+	CPPUNIT_TEST(testEndOfFile);
+	CPPUNIT_TEST(testHugeLengthPrefix);
+
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testMemoryRoundTrip();
+	void testFileRoundTrip();
+	void testByteOrder();
+	void testEndOfFile();
+	void testHugeLengthPrefix();
+};
@@ -0,0 +1,85 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+#include <AStarSearch.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+// Compares the setup cost of a path search: allocating and zeroing the node records for every search
+// (as AStarSearch did before) versus starting a new generation in a reused workspace.
+// Each "search" touches numNodes node records in a square around the map center and uses the open list.
+
+static void touchNodes(AStarSearch::TileData* pData, int sizeX, int numNodes, std::vector<Coord>& openList) {
+    const int side = static_cast<int>(std::sqrt(numNodes));
+    const int offset = (sizeX - side) / 2;
+    for(int y = 0; y < side; y++) {
+        for(int x = 0; x < side; x++) {
+            const Coord coord(offset + x, offset + y);
+            AStarSearch::TileData& data = pData[coord.y * sizeX + coord.x];
+            data.bInOpenList = true;
+            data.g = x + y;
+            openList.push_back(coord);
+        }
+    }
+}
+
+static void touchNodes(AStarSearch::Workspace& workspace, int sizeX, int numNodes) {
+    const int side = static_cast<int>(std::sqrt(numNodes));
+    const int offset = (sizeX - side) / 2;
+    for(int y = 0; y < side; y++) {
+        for(int x = 0; x < side; x++) {
+            const Coord coord(offset + x, offset + y);
+            AStarSearch::TileData& data = workspace.getTileData(coord);
+            data.bInOpenList = true;
+            data.g = x + y;
+            workspace.openList.push_back(coord);
+        }
+    }
+}
+
+static void benchmarkAStarWorkspace(Benchmark& benchmark) {
+    for(int mapSize : { 64, 128 }) {
+        for(int numNodes : { 100, 2500 }) {
+            const std::string suffix = " (" + std::to_string(mapSize) + "x" + std::to_string(mapSize) + ", " + std::to_string(numNodes) + " nodes)";
+
+            benchmark.measure("calloc per search" + suffix, 2000, [&]() {
+                auto pData = static_cast<AStarSearch::TileData*>(calloc(mapSize*mapSize, sizeof(AStarSearch::TileData)));
+                if(pData == nullptr) {
+                    throw std::bad_alloc();
+                }
+                std::vector<Coord> openList;
+                std::vector<short> depthCheckCount(mapSize);
+                touchNodes(pData, mapSize, numNodes, openList);
+                doNotOptimizeAway(openList.size());
+                free(pData);
+            });
+
+            AStarSearch::Workspace workspace;
+            benchmark.measure("reused workspace" + suffix, 2000, [&]() {
+                workspace.beginSearch(mapSize, mapSize);
+                touchNodes(workspace, mapSize, numNodes);
+                doNotOptimizeAway(workspace.openList.size());
+            });
+        }
+    }
+}
+
+BENCHMARK_REGISTRATION("AStarSearch/Workspace", benchmarkAStarWorkspace);
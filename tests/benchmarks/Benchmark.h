@@ -0,0 +1,78 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+/**
+    A minimal micro benchmark runner. Benchmarks register themselves with BENCHMARK_REGISTRATION and
+    are run by runbenchmarks (optionally filtered by a name prefix given on the command line).
+*/
+class Benchmark {
+public:
+    typedef std::function<void (Benchmark&)> BenchmarkFunction;
+
+    /**
+        Runs one measurement and prints the time per iteration.
+        \param  caseName    the name of this measurement
+        \param  iterations  how often function shall be called
+        \param  function    the code to measure
+    */
+    template<typename F>
+    void measure(const std::string& caseName, int iterations, F&& function) {
+        // warm up caches and allocators
+        function();
+
+        const auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < iterations; i++) {
+            function();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double nsPerIteration = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        std::printf("  %-48s %14.1f ns/iteration\n", caseName.c_str(), nsPerIteration);
+    }
+
+    static bool registerBenchmark(const std::string& name, BenchmarkFunction function);
+
+    static int runAll(const std::string& filter);
+};
+
+#define BENCHMARK_REGISTRATION(name, function) \
+    static bool benchmarkRegistration_##function = Benchmark::registerBenchmark(name, function)
+
+/**
+    Prevents the compiler from optimizing away a computed value.
+*/
+template<typename T>
+inline void doNotOptimizeAway(const T& value) {
+#if defined(__GNUC__)
+    // make the compiler believe that the value is read
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+    (void) sink;
+#endif
+}
+
+#endif // BENCHMARK_H
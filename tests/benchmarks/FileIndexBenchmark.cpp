@@ -0,0 +1,206 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Benchmark.h"
+
+#include <FileClasses/FileIndex.h>
+#include <FileClasses/Pakfile.h>
+#include <misc/FileSystem.h>
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Compares the asset loading at startup: probing every search path on disk and scanning every PAK file per opened
+// file (as FileManager did before) versus building an index once and reading from the memory mapped PAK files.
+// The synthetic data set resembles the real one: 16 PAK files with about 1500 files and a few external overrides.
+
+static const int NUM_PAKFILES = 16;
+static const int FILES_PER_PAKFILE = 96;
+static const int FILE_SIZE = 4096;
+static const int NUM_OVERRIDES = 8;
+
+static const char* const BENCHMARK_DIR = "FileIndexBenchmark.tmp";
+
+static void makeDirectory(const std::string& path) {
+#ifdef _WIN32
+    _mkdir(path.c_str());
+#else
+    mkdir(path.c_str(), 0755);
+#endif
+}
+
+static void removeDirectory(const std::string& path) {
+#ifdef _WIN32
+    _rmdir(path.c_str());
+#else
+    rmdir(path.c_str());
+#endif
+}
+
+static void writeFile(const std::string& path, const std::vector<char>& data) {
+    FILE* pFile = std::fopen(path.c_str(), "wb");
+    if(pFile != nullptr) {
+        std::fwrite(data.data(), 1, data.size(), pFile);
+        std::fclose(pFile);
+    }
+}
+
+/// A file inside a PAK file as the old FileManager found it: the PAK file is opened, seeked and read for every file
+struct PakContent {
+    std::string                 pakPath;
+    std::vector<std::string>    filenames;
+    std::vector<int>            offsets;
+};
+
+static void benchmarkFileIndex(Benchmark& benchmark) {
+    const std::string baseDir = BENCHMARK_DIR;
+    const std::vector<std::string> searchPath = { baseDir + "/data", baseDir + "/user" };
+    makeDirectory(baseDir);
+    for(const auto& dir : searchPath) {
+        makeDirectory(dir);
+    }
+
+    std::vector<char> fileData(FILE_SIZE);
+    for(int i = 0; i < FILE_SIZE; i++) {
+        fileData[i] = static_cast<char>(i);
+    }
+
+    std::vector<PakContent> pakContents;
+    std::vector<std::string> allFilenames;
+    for(int pak = 0; pak < NUM_PAKFILES; pak++) {
+        PakContent content;
+        content.pakPath = searchPath[0] + "/BENCH" + std::to_string(pak) + ".PAK";
+
+        Pakfile pakfile(content.pakPath, true);
+        for(int i = 0; i < FILES_PER_PAKFILE; i++) {
+            const std::string filename = "FILE" + std::to_string(pak) + "_" + std::to_string(i) + ".SHP";
+            SDL_RWops* rwop = SDL_RWFromConstMem(fileData.data(), FILE_SIZE);
+            pakfile.addFile(rwop, filename);
+            SDL_RWclose(rwop);
+
+            content.filenames.push_back(filename);
+            allFilenames.push_back(filename);
+        }
+
+        // the header is followed by the files in the order they were added
+        int headerSize = 4;
+        for(const auto& filename : content.filenames) {
+            headerSize += 4 + filename.length() + 1;
+        }
+        for(int i = 0; i < FILES_PER_PAKFILE; i++) {
+            content.offsets.push_back(headerSize + i * FILE_SIZE);
+        }
+
+        pakContents.push_back(std::move(content));
+    }
+
+    for(int i = 0; i < NUM_OVERRIDES; i++) {
+        writeFile(searchPath[1] + "/" + allFilenames[i * 97], fileData);
+    }
+
+    std::vector<char> buffer(FILE_SIZE);
+
+    benchmark.measure("probe search paths and PAK files per file", 5, [&]() {
+        size_t bytesRead = 0;
+        for(const auto& content : pakContents) {
+            for(int i = 0; i < FILES_PER_PAKFILE; i++) {
+                const std::string& filename = content.filenames[i];
+
+                bool bExternal = false;
+                for(const auto& sp : searchPath) {
+                    std::string externalFilename = sp + "/" + filename;
+                    if(getCaseInsensitiveFilename(externalFilename)) {
+                        bExternal = true;
+                        SDL_RWops* rwop = SDL_RWFromFile(externalFilename.c_str(), "rb");
+                        bytesRead += SDL_RWread(rwop, buffer.data(), 1, FILE_SIZE);
+                        SDL_RWclose(rwop);
+                        break;
+                    }
+                }
+
+                if(bExternal) {
+                    continue;
+                }
+
+                // scan the PAK file list up to the containing PAK file
+                for(const auto& otherContent : pakContents) {
+                    bool bFound = false;
+                    for(const auto& otherFilename : otherContent.filenames) {
+                        if(otherFilename == filename) {
+                            bFound = true;
+                            break;
+                        }
+                    }
+                    if(bFound) {
+                        break;
+                    }
+                }
+
+                SDL_RWops* rwop = SDL_RWFromFile(content.pakPath.c_str(), "rb");
+                SDL_RWseek(rwop, content.offsets[i], RW_SEEK_SET);
+                bytesRead += SDL_RWread(rwop, buffer.data(), 1, FILE_SIZE);
+                SDL_RWclose(rwop);
+            }
+        }
+        doNotOptimizeAway(bytesRead);
+    });
+
+    benchmark.measure("index once and read from mapped PAK files", 5, [&]() {
+        std::vector<std::unique_ptr<Pakfile>> pakfiles;
+        for(const auto& content : pakContents) {
+            pakfiles.push_back(std::make_unique<Pakfile>(content.pakPath));
+        }
+
+        FileIndex fileIndex;
+        for(const auto& sp : searchPath) {
+            fileIndex.addDirectory(sp);
+        }
+        for(const auto& pPakfile : pakfiles) {
+            fileIndex.addPakfile(pPakfile.get());
+        }
+
+        size_t bytesRead = 0;
+        for(const auto& filename : allFilenames) {
+            const FileIndex::Entry* pEntry = fileIndex.find(filename);
+            sdl2::RWops_ptr rwop = FileIndex::open(*pEntry);
+            bytesRead += SDL_RWread(rwop.get(), buffer.data(), 1, FILE_SIZE);
+        }
+        doNotOptimizeAway(bytesRead);
+    });
+
+    for(int i = 0; i < NUM_OVERRIDES; i++) {
+        std::remove((searchPath[1] + "/" + allFilenames[i * 97]).c_str());
+    }
+    for(const auto& content : pakContents) {
+        std::remove(content.pakPath.c_str());
+    }
+    for(const auto& dir : searchPath) {
+        removeDirectory(dir);
+    }
+    removeDirectory(baseDir);
+}
+
+BENCHMARK_REGISTRATION("FileIndex/Startup", benchmarkFileIndex);
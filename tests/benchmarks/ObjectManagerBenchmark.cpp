@@ -0,0 +1,90 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+#include <ObjectManager.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+// Compares ObjectManager::getObject() with the std::map lookup it replaced.
+// The object population resembles a late game: numCreated IDs were handed out over the game but only numAlive
+// objects are still alive. One "cycle" looks up lookupsPerCycle IDs, about one tenth of them belong to
+// already destroyed objects (e.g. targets of ObjectPointers that were not updated yet).
+
+static void benchmarkObjectManager(Benchmark& benchmark) {
+    const int numCreated = 40000;
+    const int numAlive = 1500;
+    const int lookupsPerCycle = 30000;
+
+    std::mt19937 randomGen(42);
+
+    // the objects are never dereferenced, so any distinct non-null address will do
+    std::vector<char> dummyObjects(numCreated);
+    auto getDummyObject = [&](int i) { return reinterpret_cast<ObjectBase*>(&dummyObjects[i]); };
+
+    ObjectManager objectManager;
+    std::map<Uint32, ObjectBase*> objectMap;
+    for(int i = 0; i < numCreated; i++) {
+        const Uint32 objectID = objectManager.addObject(getDummyObject(i));
+        objectMap.emplace(objectID, getDummyObject(i));
+    }
+
+    std::vector<Uint32> aliveIDs;
+    std::vector<Uint32> deadIDs;
+    for(Uint32 objectID = 1; objectID <= static_cast<Uint32>(numCreated); objectID++) {
+        if(std::uniform_int_distribution<int>(0, numCreated - 1)(randomGen) < numAlive) {
+            aliveIDs.push_back(objectID);
+        } else {
+            deadIDs.push_back(objectID);
+            objectManager.removeObject(objectID);
+            objectMap.erase(objectID);
+        }
+    }
+
+    std::vector<Uint32> lookups(lookupsPerCycle);
+    for(Uint32& objectID : lookups) {
+        if(std::uniform_int_distribution<int>(0, 9)(randomGen) == 0) {
+            objectID = deadIDs[std::uniform_int_distribution<size_t>(0, deadIDs.size() - 1)(randomGen)];
+        } else {
+            objectID = aliveIDs[std::uniform_int_distribution<size_t>(0, aliveIDs.size() - 1)(randomGen)];
+        }
+    }
+
+    const std::string suffix = " (cycle, " + std::to_string(aliveIDs.size()) + "/" + std::to_string(numCreated) + " alive)";
+
+    benchmark.measure("std::map" + suffix, 200, [&]() {
+        size_t numFound = 0;
+        for(const Uint32 objectID : lookups) {
+            const auto iter = objectMap.find(objectID);
+            numFound += (iter != objectMap.end() && iter->second != nullptr) ? 1 : 0;
+        }
+        doNotOptimizeAway(numFound);
+    });
+
+    benchmark.measure("ObjectManager" + suffix, 200, [&]() {
+        size_t numFound = 0;
+        for(const Uint32 objectID : lookups) {
+            numFound += (objectManager.getObject(objectID) != nullptr) ? 1 : 0;
+        }
+        doNotOptimizeAway(numFound);
+    });
+}
+
+BENCHMARK_REGISTRATION("ObjectManager/Lookup", benchmarkObjectManager);
@@ -0,0 +1,115 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Benchmark.h"
+
+#include <misc/SmallVector.h>
+
+#include <DataTypes.h>
+#include <Definitions.h>
+
+#include <cstdio>
+#include <list>
+#include <random>
+#include <set>
+#include <vector>
+
+// Compares the std::list occupant lists Tile used to have with the SmallVector based ones.
+// A 128x128 map holds numObjects objects spread over the four lists of the tiles. One scan visits all tiles and
+// counts the occupied ones (like hasAnObject()); one damage round collects the objects around 200 impacts like
+// Map::damage() does.
+
+template<typename AirList, typename InfantryList, typename ObjectList>
+struct BenchmarkTile {
+    AirList         airUnits;
+    InfantryList    infantry;
+    ObjectList      undergroundUnits;
+    ObjectList      nonInfantryGroundObjects;
+
+    bool hasAnObject() const {
+        return !airUnits.empty() || !infantry.empty() || !undergroundUnits.empty() || !nonInfantryGroundObjects.empty();
+    }
+};
+
+typedef BenchmarkTile<std::list<Uint32>, std::list<Uint32>, std::list<Uint32>> ListTile;
+typedef BenchmarkTile<SmallVector<Uint32, 2>, SmallVector<Uint32, NUM_INFANTRY_PER_TILE>, SmallVector<Uint32, 2>> SmallVectorTile;
+
+template<typename TileType>
+static void benchmarkTiles(Benchmark& benchmark, const std::string& name) {
+    const int mapSize = 128;
+    const int numObjects = 1500;
+    const int numImpacts = 200;
+
+    std::mt19937 randomGen(42);
+    std::uniform_int_distribution<int> randomCoord(0, mapSize - 1);
+
+    std::vector<TileType> tiles(mapSize * mapSize);
+    for(Uint32 objectID = 1; objectID <= numObjects; objectID++) {
+        auto& tile = tiles[randomCoord(randomGen) * mapSize + randomCoord(randomGen)];
+        switch(objectID % 8) {
+            case 0:     tile.airUnits.push_back(objectID);                  break;
+            case 1:     tile.undergroundUnits.push_back(objectID);          break;
+            case 2:
+            case 3:
+            case 4:     tile.infantry.push_back(objectID);                  break;
+            default:    tile.nonInfantryGroundObjects.push_back(objectID);  break;
+        }
+    }
+
+    std::vector<int> impacts(numImpacts);
+    for(int& impact : impacts) {
+        impact = randomCoord(randomGen) * mapSize + randomCoord(randomGen);
+    }
+
+    benchmark.measure(name + " (scan all tiles)", 200, [&]() {
+        int numOccupied = 0;
+        for(const auto& tile : tiles) {
+            numOccupied += tile.hasAnObject() ? 1 : 0;
+        }
+        doNotOptimizeAway(numOccupied);
+    });
+
+    benchmark.measure(name + " (damage 5x5 areas)", 200, [&]() {
+        size_t numAffected = 0;
+        for(const int impact : impacts) {
+            std::set<Uint32> affected;
+            const int impactX = impact / mapSize;
+            const int impactY = impact % mapSize;
+            for(int x = std::max(0, impactX - 2); x <= std::min(mapSize - 1, impactX + 2); x++) {
+                for(int y = std::max(0, impactY - 2); y <= std::min(mapSize - 1, impactY + 2); y++) {
+                    const auto& tile = tiles[x * mapSize + y];
+                    affected.insert(tile.airUnits.begin(), tile.airUnits.end());
+                    affected.insert(tile.infantry.begin(), tile.infantry.end());
+                    affected.insert(tile.undergroundUnits.begin(), tile.undergroundUnits.end());
+                    affected.insert(tile.nonInfantryGroundObjects.begin(), tile.nonInfantryGroundObjects.end());
+                }
+            }
+            numAffected += affected.size();
+        }
+        doNotOptimizeAway(numAffected);
+    });
+
+    std::printf("  %-48s %14zu bytes/tile (without list nodes)\n", (name + " (size)").c_str(), sizeof(TileType));
+}
+
+static void benchmarkOccupantLists(Benchmark& benchmark) {
+    benchmarkTiles<ListTile>(benchmark, "std::list");
+    benchmarkTiles<SmallVectorTile>(benchmark, "SmallVector");
+}
+
+BENCHMARK_REGISTRATION("Tile/OccupantLists", benchmarkOccupantLists);
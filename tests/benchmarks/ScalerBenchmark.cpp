@@ -0,0 +1,202 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "Benchmark.h"
+
+#include <misc/Scaler.h>
+#include <misc/ScalerKernels.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+// Measures the Scale2x/Scale3x throughput on sheets laid out like the ObjPic_* sheets in GFXManager (same tile
+// counts, synthetic content since the game data is not available here). The row kernels are compared on their own
+// and the whole set of sheets is scaled once with the scalar kernel on one thread (like the old Scaler) and once with
+// the Scaler (fastest kernel and multiple threads for big sheets).
+
+struct SheetLayout {
+    int tilesX;
+    int tilesY;
+    int tileSize;
+    int count;      ///< number of ObjPic_* sheets with this layout
+};
+
+static const SheetLayout sheetLayouts[] = {
+    { 8, 1, 16, 16 },   // ground units, frigate, terrain tracks
+    { 8, 2, 24, 2 },    // carryall
+    { 8, 3, 24, 3 },    // harvester sand, ornithopter
+    { 4, 3, 16, 5 },    // infantry
+    { 1, 9, 24, 1 },    // sandworm
+    { 4, 1, 48, 9 },    // structures
+    { 6, 1, 48, 1 },    // light factory
+    { 8, 1, 48, 2 },    // heavy and high tech factory
+    { 10, 1, 48, 5 },   // refinery, repair yard, starport, turrets
+    { 25, 3, 16, 1 },   // wall
+    { 16, 1, 16, 5 },   // rockets, hidden terrain
+    { 1, 1, 16, 12 },   // bullets, hits, star
+    { 5, 1, 32, 7 },    // explosions, gas
+    { 21, 1, 32, 1 },   // explosion flames
+    { 6, 1, 16, 4 },    // dead units, rock and sand damage
+    { 11, 8, 16, 1 },   // terrain
+    { 14, 1, 16, 1 },   // destroyed structure
+};
+
+/**
+    Creates a sheet with blocky content so that the scalers find edges to smooth.
+*/
+static sdl2::surface_ptr createSheet(const SheetLayout& layout) {
+    const int width = layout.tilesX * layout.tileSize;
+    const int height = layout.tilesY * layout.tileSize;
+    sdl2::surface_ptr surface{ SDL_CreateRGBSurface(0, width, height, 8, 0, 0, 0, 0) };
+
+    sdl2::surface_lock lock{ surface.get() };
+    for(int y = 0; y < height; y++) {
+        Uint8* pixels = static_cast<Uint8*>(surface->pixels) + y*surface->pitch;
+        for(int x = 0; x < width; x++) {
+            pixels[x] = ((x/3 + y/2) % 5 == 0) ? 0 : static_cast<Uint8>(std::rand() % 4 + 1);
+        }
+    }
+
+    return surface;
+}
+
+/**
+    Scales a tiled sheet the way the Scaler did before it used vectorized kernels and threads.
+*/
+static sdl2::surface_ptr scaleSheetScalar(SDL_Surface* src, int tilesX, int tilesY, int factor) {
+    sdl2::surface_ptr dest{ SDL_CreateRGBSurface(0, src->w*factor, src->h*factor, 8, 0, 0, 0, 0) };
+
+    sdl2::surface_lock dest_lock{ dest.get() };
+    sdl2::surface_lock src_lock{ src };
+
+    const int tileWidth = src->w / tilesX;
+    const int tileHeight = src->h / tilesY;
+    const Uint8* srcPixels = static_cast<const Uint8*>(src->pixels);
+    Uint8* destPixels = static_cast<Uint8*>(dest->pixels);
+
+    for(int row = 0; row < tileHeight*tilesY; row++) {
+        const int tileY = row / tileHeight;
+        const int y = row % tileHeight;
+        const Uint8* prev = srcPixels + (tileY*tileHeight + std::max(0, y-1))*src->pitch;
+        const Uint8* cur = srcPixels + row*src->pitch;
+        const Uint8* next = srcPixels + (tileY*tileHeight + std::min(tileHeight-1, y+1))*src->pitch;
+        Uint8* dest0 = destPixels + row*factor*dest->pitch;
+
+        for(int i = 0; i < tilesX; i++) {
+            const int offset = i*tileWidth;
+            if(factor == 2) {
+                ScalerKernels::scale2xRowScalar(prev + offset, cur + offset, next + offset, tileWidth,
+                                                dest0 + 2*offset, dest0 + dest->pitch + 2*offset);
+            } else {
+                ScalerKernels::scale3xRowScalar(prev + offset, cur + offset, next + offset, tileWidth,
+                                                dest0 + 3*offset, dest0 + dest->pitch + 3*offset, dest0 + 2*dest->pitch + 3*offset);
+            }
+        }
+    }
+
+    return dest;
+}
+
+static void benchmarkScalerKernels(Benchmark& benchmark) {
+    const int width = 1024;
+    const int height = 64;
+
+    std::vector<Uint8> src(width*height);
+    for(int i = 0; i < width*height; i++) {
+        src[i] = ((i/3) % 5 == 0) ? 0 : static_cast<Uint8>(std::rand() % 4 + 1);
+    }
+    std::vector<Uint8> dest(3*width*3);
+
+    struct Kernels {
+        const char* name2x;
+        const char* name3x;
+        ScalerKernels::Scale2xRowKernel* scale2x;
+        ScalerKernels::Scale3xRowKernel* scale3x;
+    };
+
+    const Kernels kernels[] = {
+        { "scale2x row kernel scalar", "scale3x row kernel scalar", ScalerKernels::scale2xRowScalar, ScalerKernels::scale3xRowScalar },
+        { "scale2x row kernel SSE2", "scale3x row kernel SSE2", ScalerKernels::getScale2xRowKernelSSE2(), ScalerKernels::getScale3xRowKernelSSE2() },
+        { "scale2x row kernel AVX2", "scale3x row kernel AVX2", ScalerKernels::getScale2xRowKernelAVX2(), ScalerKernels::getScale3xRowKernelAVX2() },
+    };
+
+    for(const Kernels& k : kernels) {
+        if(k.scale2x == nullptr || k.scale3x == nullptr) {
+            std::printf("  %-48s %14s\n", k.name2x, "not supported");
+            continue;
+        }
+
+        benchmark.measure(k.name2x, 200, [&]() {
+            for(int y = 1; y < height-1; y++) {
+                k.scale2x(&src[(y-1)*width], &src[y*width], &src[(y+1)*width], width, &dest[0], &dest[3*width]);
+            }
+            doNotOptimizeAway(dest[0]);
+        });
+
+        benchmark.measure(k.name3x, 200, [&]() {
+            for(int y = 1; y < height-1; y++) {
+                k.scale3x(&src[(y-1)*width], &src[y*width], &src[(y+1)*width], width, &dest[0], &dest[3*width], &dest[6*width]);
+            }
+            doNotOptimizeAway(dest[0]);
+        });
+    }
+}
+
+static void benchmarkScalerSheets(Benchmark& benchmark) {
+    struct Sheet {
+        sdl2::surface_ptr surface;
+        int tilesX;
+        int tilesY;
+    };
+
+    std::vector<Sheet> sheets;
+    for(const SheetLayout& layout : sheetLayouts) {
+        for(int i = 0; i < layout.count; i++) {
+            sheets.push_back({ createSheet(layout), layout.tilesX, layout.tilesY });
+        }
+    }
+
+    benchmark.measure("scale2x all sheets (scalar, one thread)", 20, [&]() {
+        for(const Sheet& sheet : sheets) {
+            doNotOptimizeAway(scaleSheetScalar(sheet.surface.get(), sheet.tilesX, sheet.tilesY, 2));
+        }
+    });
+
+    benchmark.measure("scale2x all sheets (Scaler)", 20, [&]() {
+        for(const Sheet& sheet : sheets) {
+            doNotOptimizeAway(Scaler::doubleTiledSurfaceScale2x(sheet.surface.get(), sheet.tilesX, sheet.tilesY));
+        }
+    });
+
+    benchmark.measure("scale3x all sheets (scalar, one thread)", 20, [&]() {
+        for(const Sheet& sheet : sheets) {
+            doNotOptimizeAway(scaleSheetScalar(sheet.surface.get(), sheet.tilesX, sheet.tilesY, 3));
+        }
+    });
+
+    benchmark.measure("scale3x all sheets (Scaler)", 20, [&]() {
+        for(const Sheet& sheet : sheets) {
+            doNotOptimizeAway(Scaler::tripleTiledSurfaceScale3x(sheet.surface.get(), sheet.tilesX, sheet.tilesY));
+        }
+    });
+}
+
+BENCHMARK_REGISTRATION("Scaler/Kernels", benchmarkScalerKernels);
+BENCHMARK_REGISTRATION("Scaler/Sheets", benchmarkScalerSheets);
@@ -0,0 +1,146 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+#include <misc/IFileStream.h>
+#include <misc/OFileStream.h>
+
+#include <cstdio>
+#include <vector>
+
+// Compares loading a late-game savegame with one fread per value (as IFileStream did before) versus the buffered
+// IFileStream. The synthetic savegame resembles the real one: a 128x128 map where every tile is serialized like
+// Tile::save() followed by 1500 objects with about 60 values each.
+
+static const int MAP_SIZE = 128;
+static const int NUM_OBJECTS = 1500;
+static const int VALUES_PER_OBJECT = 60;
+
+static const char* const BENCHMARK_FILENAME = "StreamBenchmark.tmp";
+
+/// The old IFileStream: every value is read with its own fread() call
+class UnbufferedFileReader {
+public:
+    explicit UnbufferedFileReader(const char* filename) : fp(std::fopen(filename, "rb")) { }
+    ~UnbufferedFileReader() { std::fclose(fp); }
+
+    template<typename T>
+    T read() {
+        T x = 0;
+        if(std::fread(&x, sizeof(T), 1, fp) != 1) {
+            std::printf("UnbufferedFileReader: unexpected end of file\n");
+        }
+        return x;
+    }
+
+private:
+    FILE* fp;
+};
+
+static void writeSavegame() {
+    OFileStream stream;
+    stream.open(BENCHMARK_FILENAME);
+
+    for(int i = 0; i < MAP_SIZE * MAP_SIZE; i++) {
+        stream.writeUint32(i % 12);                 // type
+        stream.writeBools(true, true);              // explored
+        stream.writeBools(true, false);             // last access
+        stream.writeUint32(i);
+        stream.writeUint32(0);                      // fog color
+        stream.writeUint32(i % 3);                  // owner
+        stream.writeUint32(i % 7);                  // sand region
+        stream.writeSint64(i * 4096);               // spice
+        stream.writeBools(false, false, (i % 50) == 0);
+        stream.writeSint32(-1);                     // destroyed structure tile
+        stream.writeBools((i % 9) == 0);            // tracks
+        if((i % 9) == 0) {
+            stream.writeUint32(i);
+        }
+        if((i % 50) == 0) {
+            stream.writeUint32(1);                  // air units
+            stream.writeUint32(i);
+        }
+    }
+
+    for(int i = 0; i < NUM_OBJECTS; i++) {
+        for(int j = 0; j < VALUES_PER_OBJECT; j++) {
+            stream.writeUint32(i * j);
+        }
+    }
+
+    stream.close();
+}
+
+template<typename Reader, typename ReadUint8, typename ReadUint32, typename ReadSint64>
+static Uint64 readSavegame(Reader& reader, ReadUint8 readUint8, ReadUint32 readUint32, ReadSint64 readSint64) {
+    Uint64 sum = 0;
+    for(int i = 0; i < MAP_SIZE * MAP_SIZE; i++) {
+        sum += readUint32(reader);
+        readUint8(reader);
+        readUint8(reader);
+        sum += readUint32(reader);
+        sum += readUint32(reader);
+        sum += readUint32(reader);
+        sum += readUint32(reader);
+        sum += readSint64(reader);
+        const Uint8 lists = readUint8(reader);
+        sum += readUint32(reader);
+        if(readUint8(reader) != 0) {
+            sum += readUint32(reader);
+        }
+        if((lists & 0x04) != 0) {
+            const Uint32 size = readUint32(reader);
+            for(Uint32 j = 0; j < size; j++) {
+                sum += readUint32(reader);
+            }
+        }
+    }
+
+    for(int i = 0; i < NUM_OBJECTS * VALUES_PER_OBJECT; i++) {
+        sum += readUint32(reader);
+    }
+
+    return sum;
+}
+
+static void benchmarkSavegameLoading(Benchmark& benchmark) {
+    writeSavegame();
+
+    benchmark.measure("one fread per value", 10, [&]() {
+        UnbufferedFileReader reader(BENCHMARK_FILENAME);
+        const Uint64 sum = readSavegame(reader,
+                                        [](UnbufferedFileReader& r) { return r.read<Uint8>(); },
+                                        [](UnbufferedFileReader& r) { return SDL_SwapLE32(r.read<Uint32>()); },
+                                        [](UnbufferedFileReader& r) { return static_cast<Sint64>(SDL_SwapLE64(r.read<Uint64>())); });
+        doNotOptimizeAway(sum);
+    });
+
+    benchmark.measure("buffered IFileStream", 10, [&]() {
+        IFileStream stream;
+        stream.open(BENCHMARK_FILENAME);
+        const Uint64 sum = readSavegame(static_cast<InputStream&>(stream),
+                                        [](InputStream& s) { return s.readUint8(); },
+                                        [](InputStream& s) { return s.readUint32(); },
+                                        [](InputStream& s) { return s.readSint64(); });
+        doNotOptimizeAway(sum);
+    });
+
+    std::remove(BENCHMARK_FILENAME);
+}
+
+BENCHMARK_REGISTRATION("Savegame/Loading", benchmarkSavegameLoading);
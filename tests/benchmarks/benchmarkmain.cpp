@@ -0,0 +1,46 @@
+/*
+ *  This file is part of Dune Legacy.
+ *
+ *  Dune Legacy is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  Dune Legacy is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with Dune Legacy.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+#include <map>
+
+static std::map<std::string, Benchmark::BenchmarkFunction>& getRegistry() {
+    static std::map<std::string, Benchmark::BenchmarkFunction> registry;
+    return registry;
+}
+
+bool Benchmark::registerBenchmark(const std::string& name, BenchmarkFunction function) {
+    return getRegistry().insert(std::make_pair(name, function)).second;
+}
+
+int Benchmark::runAll(const std::string& filter) {
+    Benchmark benchmark;
+    for(const auto& entry : getRegistry()) {
+        if(entry.first.compare(0, filter.size(), filter) != 0) {
+            continue;
+        }
+
+        std::printf("%s\n", entry.first.c_str());
+        entry.second(benchmark);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    return Benchmark::runAll((argc > 1) ? argv[1] : "");
+}